@@ -7,8 +7,8 @@
 #include <string.h>
 
 // --- Static Data ---
-static struct adc_handle_t s_handle_pool;
-static bool s_is_handle_in_use = {false};
+static struct adc_handle_t s_handle_pool[ADC_MAX_INSTANCES];
+static bool s_is_handle_in_use[ADC_MAX_INSTANCES] = {false};
 
 // --- Private Helper Functions ---
 static struct adc_handle_t* allocate_handle(void) {
@@ -31,6 +31,21 @@ static void release_handle(adc_handle_t handle) {
     }
 }
 
+/**
+ * @brief Generic IRQ handler called by the port-specific ISR.
+ * @details The instances share one interrupt, so every handle with a
+ *          watchdog callback is checked for a pending event.
+ */
+static void adc_generic_handler(void) {
+    for (int i = 0; i < ADC_MAX_INSTANCES; ++i) {
+        struct adc_handle_t* handle = &s_handle_pool[i];
+        if (s_is_handle_in_use[i] && handle->watchdog_callback &&
+            handle->port_api->take_watchdog_flag(handle)) {
+            handle->watchdog_callback(handle, handle->watchdog_user_data);
+        }
+    }
+}
+
 // --- Public API Function Implementations ---
 
 adc_handle_t adc_init(uint8_t instance_num, const adc_config_t* config) {
@@ -46,9 +61,7 @@ adc_handle_t adc_init(uint8_t instance_num, const adc_config_t* config) {
     *(const adc_port_interface_t**)&handle->port_api = adc_port_get_api();
     *(void**)&handle->port_hw_instance = adc_port_get_base_addr(instance_num);
 
-    if (handle->port_api == NULL |
-
-| handle->port_hw_instance == NULL) {
+    if (handle->port_api == NULL || handle->port_hw_instance == NULL) {
         release_handle(handle);
         return NULL;
     }
@@ -57,6 +70,7 @@ adc_handle_t adc_init(uint8_t instance_num, const adc_config_t* config) {
 
     handle->port_api->enable_clock(instance_num);
     handle->port_api->configure_core(handle);
+    handle->port_api->set_irq_handler(adc_generic_handler);
 
     handle->context.is_initialized = true;
     return handle;
@@ -66,6 +80,7 @@ void adc_deinit(adc_handle_t* p_handle) {
     if (p_handle!= NULL && *p_handle!= NULL) {
         adc_handle_t handle = *p_handle;
         if (handle->context.is_initialized) {
+            handle->port_api->disable_watchdog(handle);
             handle->port_api->power_off(handle);
         }
         release_handle(handle);
@@ -79,3 +94,53 @@ uint16_t adc_read_blocking(adc_handle_t handle, uint8_t channel) {
     }
     return 0;
 }
+
+int adc_start_scan(adc_handle_t handle, const uint8_t* channels, uint8_t count, adc_trigger_t trigger) {
+    if (handle == NULL || !handle->context.is_initialized || channels == NULL ||
+        count == 0 || count > ADC_MAX_SCAN_CHANNELS) {
+        return -1; // Invalid arguments
+    }
+    for (uint8_t i = 0; i < count; ++i) {
+        if (channels[i] > 18) {
+            return -1; // Invalid arguments
+        }
+    }
+    handle->port_api->start_scan(handle, channels, count, trigger);
+    return 0;
+}
+
+int adc_stop_scan(adc_handle_t handle) {
+    if (handle == NULL || !handle->context.is_initialized) {
+        return -1; // Invalid arguments
+    }
+    handle->port_api->stop_scan(handle);
+    return 0;
+}
+
+const void* adc_get_data_register(adc_handle_t handle) {
+    if (handle && handle->context.is_initialized) {
+        return handle->port_api->get_data_register(handle);
+    }
+    return NULL;
+}
+
+int adc_enable_watchdog(adc_handle_t handle, const adc_watchdog_config_t* config,
+                        adc_watchdog_callback_t callback, void* user_data) {
+    if (handle == NULL || !handle->context.is_initialized || config == NULL || callback == NULL ||
+        config->channel > 18 || config->high_threshold > 0x0FFF ||
+        config->low_threshold > config->high_threshold) {
+        return -1; // Invalid arguments
+    }
+    handle->watchdog_callback = callback;
+    handle->watchdog_user_data = user_data;
+    handle->port_api->enable_watchdog(handle, config);
+    return 0;
+}
+
+int adc_disable_watchdog(adc_handle_t handle) {
+    if (handle == NULL || !handle->context.is_initialized) {
+        return -1; // Invalid arguments
+    }
+    handle->port_api->disable_watchdog(handle);
+    return 0;
+}
@@ -44,6 +44,34 @@ typedef enum {
     ADC_SAMPLE_TIME_480_CYCLES,
 } adc_sample_time_t;
 
+/** @brief Most channels in one regular scan sequence. */
+#define ADC_MAX_SCAN_CHANNELS 16
+
+/** @brief Timer event that starts a regular scan (on its rising edge). */
+typedef enum {
+    ADC_TRIGGER_TIM2_TRGO = 6,
+    ADC_TRIGGER_TIM3_TRGO = 8,
+    ADC_TRIGGER_TIM8_TRGO = 14,
+} adc_trigger_t;
+
+/**
+ * @brief Analog watchdog window on one regular channel.
+ * @details Thresholds are compared with the raw 12-bit result whatever the
+ *          resolution, so they are given on the 12-bit scale (0-4095).
+ */
+typedef struct {
+    uint8_t channel;            // Guarded channel (0-18)
+    uint16_t low_threshold;     // Fires on a result below this value
+    uint16_t high_threshold;    // Fires on a result above this value
+} adc_watchdog_config_t;
+
+/**
+ * @brief Called from the ADC interrupt when the guarded channel leaves its window.
+ * @details The watchdog fires again on every conversion outside the window
+ *          until it is disabled; the callback may call adc_disable_watchdog().
+ */
+typedef void (*adc_watchdog_callback_t)(adc_handle_t handle, void* user_data);
+
 /**
  * @brief Configuration structure for ADC initialization.
  */
@@ -81,4 +109,57 @@ void adc_deinit(adc_handle_t* p_handle);
  */
 uint16_t adc_read_blocking(adc_handle_t handle, uint8_t channel);
 
+/**
+ * @brief Starts converting a channel sequence on every trigger event.
+ * @details Each trigger converts all channels in order, using the configured
+ *          resolution and sample time, and raises one DMA request per
+ *          result. The DMA stream must be running before the first trigger;
+ *          read the results from adc_get_data_register().
+ *
+ * @param[in] handle The handle to the ADC instance.
+ * @param[in] channels Channel numbers (0-18) in conversion order.
+ * @param[in] count Number of channels, 1 to ADC_MAX_SCAN_CHANNELS.
+ * @param[in] trigger Timer event that starts each scan.
+ *
+ * @return 0 on success, or a negative error code on failure.
+ */
+int adc_start_scan(adc_handle_t handle, const uint8_t* channels, uint8_t count, adc_trigger_t trigger);
+
+/**
+ * @brief Stops triggered scanning and its DMA requests.
+ * @param[in] handle The handle to the ADC instance.
+ * @return 0 on success, or a negative error code on failure.
+ */
+int adc_stop_scan(adc_handle_t handle);
+
+/**
+ * @brief Gets the address of the regular data register, the source for DMA.
+ * @param[in] handle The handle to the ADC instance.
+ * @return The register address, or NULL if the handle is invalid.
+ */
+const void* adc_get_data_register(adc_handle_t handle);
+
+/**
+ * @brief Starts watching regular conversions of one channel against a window.
+ * @details The comparison runs in hardware on every conversion of the
+ *          channel, so only a conversion outside the window costs CPU time.
+ *          The NVIC line itself (ADC_IRQn) is left to the caller.
+ *
+ * @param[in] handle The handle to the ADC instance.
+ * @param[in] config Guarded channel and thresholds.
+ * @param[in] callback Function to call from the interrupt.
+ * @param[in] user_data Pointer passed back to the callback.
+ *
+ * @return 0 on success, or a negative error code on failure.
+ */
+int adc_enable_watchdog(adc_handle_t handle, const adc_watchdog_config_t* config,
+                        adc_watchdog_callback_t callback, void* user_data);
+
+/**
+ * @brief Stops the analog watchdog and its interrupt. Callable from the callback.
+ * @param[in] handle The handle to the ADC instance.
+ * @return 0 on success, or a negative error code on failure.
+ */
+int adc_disable_watchdog(adc_handle_t handle);
+
 #endif // ADC_H
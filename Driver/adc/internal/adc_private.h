@@ -25,6 +25,8 @@ struct adc_handle_t {
     adc_context_t context;
     const adc_port_interface_t* port_api;
     void* port_hw_instance;
+    adc_watchdog_callback_t watchdog_callback;  // Called from the ADC interrupt
+    void* watchdog_user_data;
 };
 
 #endif // ADC_PRIVATE_H
@@ -55,7 +55,24 @@ typedef struct {
 #define ADC_CR1_RES_Msk     (3UL << ADC_CR1_RES_Pos)
 #define ADC_CR1_SCAN_Pos    (8U)
 #define ADC_CR1_SCAN_Msk    (1UL << ADC_CR1_SCAN_Pos)
+#define ADC_CR1_AWDEN_Pos   (23U)
+#define ADC_CR1_AWDEN_Msk   (1UL << ADC_CR1_AWDEN_Pos)
+#define ADC_CR1_AWDSGL_Pos  (9U)
+#define ADC_CR1_AWDSGL_Msk  (1UL << ADC_CR1_AWDSGL_Pos)
+#define ADC_CR1_AWDIE_Pos   (6U)
+#define ADC_CR1_AWDIE_Msk   (1UL << ADC_CR1_AWDIE_Pos)
+#define ADC_CR1_AWDCH_Pos   (0U)
+#define ADC_CR1_AWDCH_Msk   (0x1FUL << ADC_CR1_AWDCH_Pos)
 
+#define ADC_CR2_EXTEN_Pos   (28U)
+#define ADC_CR2_EXTEN_Msk   (3UL << ADC_CR2_EXTEN_Pos)
+#define ADC_CR2_EXTEN_RISING (1UL << ADC_CR2_EXTEN_Pos)
+#define ADC_CR2_EXTSEL_Pos  (24U)
+#define ADC_CR2_EXTSEL_Msk  (0xFUL << ADC_CR2_EXTSEL_Pos)
+#define ADC_CR2_DDS_Pos     (9U)
+#define ADC_CR2_DDS_Msk     (1UL << ADC_CR2_DDS_Pos)
+#define ADC_CR2_DMA_Pos     (8U)
+#define ADC_CR2_DMA_Msk     (1UL << ADC_CR2_DMA_Pos)
 #define ADC_CR2_SWSTART_Pos (30U)
 #define ADC_CR2_SWSTART_Msk (1UL << ADC_CR2_SWSTART_Pos)
 #define ADC_CR2_ALIGN_Pos   (11U)
@@ -70,6 +87,10 @@ typedef struct {
 
 #define ADC_SR_EOC_Pos      (1U)
 #define ADC_SR_EOC_Msk      (1UL << ADC_SR_EOC_Pos)
+#define ADC_SR_AWD_Pos      (0U)
+#define ADC_SR_AWD_Msk      (1UL << ADC_SR_AWD_Pos)
+#define ADC_SR_OVR_Pos      (5U)
+#define ADC_SR_OVR_Msk      (1UL << ADC_SR_OVR_Pos)
 
 #define ADC_CCR_ADCPRE_Pos  (16U)
 #define ADC_CCR_ADCPRE_Msk  (3UL << ADC_CCR_ADCPRE_Pos)
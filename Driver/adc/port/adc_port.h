@@ -8,12 +8,21 @@
 
 struct adc_handle_t;
 
+typedef void (*adc_generic_handler_t)(void);
+
 typedef struct {
     void (*enable_clock)(uint8_t instance_num);
     void (*configure_core)(struct adc_handle_t* handle);
     void (*power_on)(struct adc_handle_t* handle);
     void (*power_off)(struct adc_handle_t* handle);
     uint16_t (*read_single_channel)(struct adc_handle_t* handle, uint8_t channel);
+    void (*start_scan)(struct adc_handle_t* handle, const uint8_t* channels, uint8_t count, adc_trigger_t trigger);
+    void (*stop_scan)(struct adc_handle_t* handle);
+    const void* (*get_data_register)(struct adc_handle_t* handle);
+    void (*enable_watchdog)(struct adc_handle_t* handle, const adc_watchdog_config_t* config);
+    void (*disable_watchdog)(struct adc_handle_t* handle);
+    bool (*take_watchdog_flag)(struct adc_handle_t* handle);
+    void (*set_irq_handler)(adc_generic_handler_t handler);
 } adc_port_interface_t;
 
 /* --- Functions to be provided by the concrete port implementation --- */
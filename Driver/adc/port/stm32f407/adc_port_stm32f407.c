@@ -10,12 +10,30 @@
 #define APB2PERIPH_BASE       0x40010000UL
 #define ADC1_BASE             (APB2PERIPH_BASE + 0x2000UL)
 #define ADC_COMMON_BASE       (ADC1_BASE + 0x300UL)
+#define RCC_BASE              0x40023800UL
+
+#define RCC_APB2ENR           (*(volatile uint32_t*)(RCC_BASE + 0x44UL))
+#define RCC_APB2ENR_ADC1EN    (1UL << 8)
+
+// --- Static Data ---
+static adc_generic_handler_t s_generic_handler = NULL;
 
 // --- Private function implementations for STM32F4 ---
 
+static void set_sample_time(adc_reg_map_t* adc_regs, uint8_t channel, adc_sample_time_t sample_time) {
+    if (channel < 10) {
+        adc_regs->SMPR2 &= ~(0b111 << (channel * 3));
+        adc_regs->SMPR2 |= (sample_time << (channel * 3));
+    } else {
+        adc_regs->SMPR1 &= ~(0b111 << ((channel - 10) * 3));
+        adc_regs->SMPR1 |= (sample_time << ((channel - 10) * 3));
+    }
+}
+
 static void stm32f4_enable_clock(uint8_t instance_num) {
-    // Placeholder: A real implementation would use the RCC driver.
-    // e.g., rcc_enable_peripheral_clock(PERIPH_ID_ADC1);
+    // ADC1..ADC3 enable bits follow each other
+    RCC_APB2ENR |= RCC_APB2ENR_ADC1EN << (instance_num - 1U);
+    (void)RCC_APB2ENR; // The clock runs two cycles after the write
 }
 
 static void stm32f4_power_on(struct adc_handle_t* handle) {
@@ -51,13 +69,7 @@ static uint16_t stm32f4_read_single_channel(struct adc_handle_t* handle, uint8_t
     const adc_config_t* config = &handle->config;
 
     // 1. Set sample time for the channel
-    if (channel < 10) {
-        adc_regs->SMPR2 &= ~(0b111 << (channel * 3));
-        adc_regs->SMPR2 |= (config->default_sample_time << (channel * 3));
-    } else {
-        adc_regs->SMPR1 &= ~(0b111 << ((channel - 10) * 3));
-        adc_regs->SMPR1 |= (config->default_sample_time << ((channel - 10) * 3));
-    }
+    set_sample_time(adc_regs, channel, config->default_sample_time);
 
     // 2. Set regular sequence to 1 conversion of the specified channel
     adc_regs->SQR1 &= ~ADC_SQR1_L_Msk; // Length = 1 conversion
@@ -73,6 +85,77 @@ static uint16_t stm32f4_read_single_channel(struct adc_handle_t* handle, uint8_t
     return (uint16_t)adc_regs->DR;
 }
 
+static void stm32f4_start_scan(struct adc_handle_t* handle, const uint8_t* channels, uint8_t count,
+                               adc_trigger_t trigger) {
+    adc_reg_map_t* adc_regs = (adc_reg_map_t*)handle->port_hw_instance;
+    const adc_config_t* config = &handle->config;
+    volatile uint32_t* sequence[3] = { &adc_regs->SQR3, &adc_regs->SQR2, &adc_regs->SQR1 };
+
+    // 1. Sequence: SQ1-SQ6 in SQR3, SQ7-SQ12 in SQR2, SQ13-SQ16 in SQR1
+    adc_regs->SQR3 = 0;
+    adc_regs->SQR2 = 0;
+    adc_regs->SQR1 = (uint32_t)(count - 1U) << ADC_SQR1_L_Pos;
+    for (uint8_t i = 0; i < count; ++i) {
+        *sequence[i / 6] |= (uint32_t)channels[i] << ((i % 6) * 5);
+        set_sample_time(adc_regs, channels[i], config->default_sample_time);
+    }
+
+    // 2. Scan the sequence, one DMA request per result, kept up after each transfer
+    adc_regs->SR &= ~ADC_SR_OVR_Msk;
+    adc_regs->CR1 |= ADC_CR1_SCAN_Msk;
+    adc_regs->CR2 &= ~(ADC_CR2_EXTEN_Msk | ADC_CR2_EXTSEL_Msk);
+    adc_regs->CR2 |= ADC_CR2_DMA_Msk | ADC_CR2_DDS_Msk;
+
+    // 3. Convert on every rising edge of the trigger
+    adc_regs->CR2 |= ((uint32_t)trigger << ADC_CR2_EXTSEL_Pos) | ADC_CR2_EXTEN_RISING;
+}
+
+static void stm32f4_stop_scan(struct adc_handle_t* handle) {
+    adc_reg_map_t* adc_regs = (adc_reg_map_t*)handle->port_hw_instance;
+
+    adc_regs->CR2 &= ~(ADC_CR2_EXTEN_Msk | ADC_CR2_DMA_Msk | ADC_CR2_DDS_Msk);
+    adc_regs->CR1 &= ~ADC_CR1_SCAN_Msk;
+    adc_regs->SR &= ~ADC_SR_OVR_Msk;
+}
+
+static const void* stm32f4_get_data_register(struct adc_handle_t* handle) {
+    return (const void*)&((adc_reg_map_t*)handle->port_hw_instance)->DR;
+}
+
+static void stm32f4_enable_watchdog(struct adc_handle_t* handle, const adc_watchdog_config_t* config) {
+    adc_reg_map_t* adc_regs = (adc_reg_map_t*)handle->port_hw_instance;
+
+    adc_regs->HTR = config->high_threshold;
+    adc_regs->LTR = config->low_threshold;
+    adc_regs->SR &= ~ADC_SR_AWD_Msk;
+
+    // Guard the one channel on regular conversions only
+    adc_regs->CR1 &= ~ADC_CR1_AWDCH_Msk;
+    adc_regs->CR1 |= ((uint32_t)config->channel << ADC_CR1_AWDCH_Pos) | ADC_CR1_AWDSGL_Msk |
+                     ADC_CR1_AWDEN_Msk | ADC_CR1_AWDIE_Msk;
+}
+
+static void stm32f4_disable_watchdog(struct adc_handle_t* handle) {
+    adc_reg_map_t* adc_regs = (adc_reg_map_t*)handle->port_hw_instance;
+
+    adc_regs->CR1 &= ~(ADC_CR1_AWDEN_Msk | ADC_CR1_AWDIE_Msk);
+    adc_regs->SR &= ~ADC_SR_AWD_Msk;
+}
+
+static bool stm32f4_take_watchdog_flag(struct adc_handle_t* handle) {
+    adc_reg_map_t* adc_regs = (adc_reg_map_t*)handle->port_hw_instance;
+
+    if ((adc_regs->CR1 & ADC_CR1_AWDIE_Msk) && (adc_regs->SR & ADC_SR_AWD_Msk)) {
+        adc_regs->SR &= ~ADC_SR_AWD_Msk;
+        return true;
+    }
+    return false;
+}
+
+static void stm32f4_set_irq_handler(adc_generic_handler_t handler) {
+    s_generic_handler = handler;
+}
+
 // --- The concrete port interface for STM32F4 ---
 static const adc_port_interface_t stm32f4_port_api = {
   .enable_clock = stm32f4_enable_clock,
@@ -80,6 +163,13 @@ static const adc_port_interface_t stm32f4_port_api = {
   .power_on = stm32f4_power_on,
   .power_off = stm32f4_power_off,
   .read_single_channel = stm32f4_read_single_channel,
+  .start_scan = stm32f4_start_scan,
+  .stop_scan = stm32f4_stop_scan,
+  .get_data_register = stm32f4_get_data_register,
+  .enable_watchdog = stm32f4_enable_watchdog,
+  .disable_watchdog = stm32f4_disable_watchdog,
+  .take_watchdog_flag = stm32f4_take_watchdog_flag,
+  .set_irq_handler = stm32f4_set_irq_handler,
 };
 
 // --- Public functions provided by the port ---
@@ -98,3 +188,10 @@ void* adc_port_get_base_addr(uint8_t instance_num) {
 void* adc_port_get_common_base_addr(void) {
     return (void*)ADC_COMMON_BASE;
 }
+
+// --- ISR Handlers ---
+// ADC1-3 share one vector; the generic handler checks every instance.
+
+void ADC_IRQHandler(void) {
+    if (s_generic_handler) s_generic_handler();
+}
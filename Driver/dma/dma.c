@@ -4,13 +4,41 @@
  */
 
 #include "internal/dma_private.h"
+#include "internal/dma_reg.h"
 #include <string.h>
 
 // --- Static Data ---
-static struct dma_handle_t s_handle_pool;
-static bool s_is_handle_in_use = {false};
+static struct dma_handle_t s_handle_pool[DMA_MAX_HANDLES];
+static bool s_is_handle_in_use[DMA_MAX_HANDLES] = {false};
+
+// Map of (controller, stream) to the handle bound to it.
+static dma_handle_t s_stream_to_handle_map[2][8] = {{NULL}};
 
 // --- Private Helper Functions ---
+
+/**
+ * @brief Checks the FIFO, packing and burst settings against the controller rules.
+ * @details A memory burst must fit evenly within the FIFO threshold level,
+ *          and direct mode allows neither bursts nor packing.
+ */
+static bool is_fifo_config_valid(const dma_config_t* config) {
+    if (!config->fifo_mode) {
+        return config->memory_burst == DMA_BURST_SINGLE &&
+               config->peripheral_burst == DMA_BURST_SINGLE &&
+               config->memory_data_size == config->peripheral_data_size;
+    }
+
+    static const uint8_t burst_beats[] = {1, 4, 8, 16};
+    uint32_t threshold_bytes = 4U * ((uint32_t)config->fifo_threshold + 1U);
+    uint32_t burst_bytes = (uint32_t)burst_beats[config->memory_burst] << config->memory_data_size;
+
+    if (config->memory_burst != DMA_BURST_SINGLE &&
+        (burst_bytes > threshold_bytes || (threshold_bytes % burst_bytes) != 0)) {
+        return false;
+    }
+    return true;
+}
+
 static struct dma_handle_t* allocate_handle(void) {
     for (int i = 0; i < DMA_MAX_HANDLES; ++i) {
         if (!s_is_handle_in_use[i]) {
@@ -30,13 +58,30 @@ static void release_handle(dma_handle_t handle) {
     }
 }
 
+/**
+ * @brief Generic IRQ handler called by the port-specific ISRs.
+ * @details Looks up the handle bound to the stream and invokes its callback.
+ */
+static void dma_generic_handler(uint8_t dma_num, uint8_t stream_num) {
+    dma_handle_t handle = s_stream_to_handle_map[dma_num - 1][stream_num];
+    if (handle && handle->callback) {
+        handle->callback(handle, handle->callback_user_data);
+    }
+}
+
 // --- Public API Function Implementations ---
 
 dma_handle_t dma_init(uint8_t dma_num, uint8_t stream_num, const dma_config_t* config) {
-    if (config == NULL |
+    if (config == NULL || (dma_num != 1 && dma_num != 2) || stream_num > 7) {
+        return NULL;
+    }
+
+    if (!is_fifo_config_valid(config)) {
+        return NULL;
+    }
 
-| (dma_num!= 1 && dma_num!= 2) |
-| stream_num > 7) {
+    // Ensure this stream isn't already in use
+    if (s_stream_to_handle_map[dma_num - 1][stream_num] != NULL) {
         return NULL;
     }
 
@@ -57,36 +102,79 @@ dma_handle_t dma_init(uint8_t dma_num, uint8_t stream_num, const dma_config_t* c
     dma_controller_reg_map_t* controller = (dma_controller_reg_map_t*)handle->port_controller_instance;
     *(void**)&handle->port_stream_instance = &controller->S[stream_num];
 
-    if (handle->port_api == NULL |
-
-| handle->port_controller_instance == NULL) {
+    if (handle->port_api == NULL || handle->port_controller_instance == NULL) {
         release_handle(handle);
         return NULL;
     }
 
+    handle->callback = NULL;
+    handle->callback_user_data = NULL;
+    s_stream_to_handle_map[dma_num - 1][stream_num] = handle;
+
     handle->port_api->enable_clock(dma_num);
     handle->port_api->configure_stream(handle);
+    handle->port_api->set_irq_handler(dma_generic_handler);
 
     return handle;
 }
 
+int dma_reconfigure(dma_handle_t handle, const dma_config_t* config) {
+    if (handle == NULL || config == NULL || !is_fifo_config_valid(config)) {
+        return -1; // Invalid arguments
+    }
+
+    memcpy((void*)&handle->config, config, sizeof(dma_config_t));
+    handle->port_api->configure_stream(handle);
+    return 0;
+}
+
 void dma_deinit(dma_handle_t* p_handle) {
     if (p_handle!= NULL && *p_handle!= NULL) {
-        dma_stop_transfer(*p_handle);
-        release_handle(*p_handle);
+        dma_handle_t handle = *p_handle;
+        dma_stop_transfer(handle);
+        s_stream_to_handle_map[handle->dma_num - 1][handle->stream_num] = NULL;
+        release_handle(handle);
         *p_handle = NULL;
     }
 }
 
 void dma_start_transfer(dma_handle_t handle, const void* source_address, void* destination_address, uint16_t data_count) {
     if (handle) {
-        handle->port_api->start_transfer(handle, source_address, destination_address, data_count);
+        DMA_PORT_CALL(handle, start_transfer)(handle, source_address, destination_address, data_count);
+    }
+}
+
+void dma_start_double_buffer(dma_handle_t handle, const void* peripheral_address, void* buffer0, void* buffer1, uint16_t data_count) {
+    if (handle && handle->config.direction == DMA_DIRECTION_PERIPHERAL_TO_MEMORY) {
+        DMA_PORT_CALL(handle, start_double_buffer)(handle, peripheral_address, buffer0, buffer1, data_count);
+    }
+}
+
+int dma_set_next_buffer(dma_handle_t handle, void* buffer) {
+    if (handle == NULL || buffer == NULL) {
+        return -1; // Invalid arguments
     }
+    DMA_PORT_CALL(handle, set_idle_target)(handle, buffer);
+    return 0;
+}
+
+uint8_t dma_get_current_buffer(dma_handle_t handle) {
+    if (handle) {
+        return DMA_PORT_CALL(handle, get_current_target)(handle);
+    }
+    return 0;
+}
+
+uint16_t dma_get_remaining_count(dma_handle_t handle) {
+    if (handle) {
+        return DMA_PORT_CALL(handle, get_remaining_count)(handle);
+    }
+    return 0;
 }
 
 void dma_stop_transfer(dma_handle_t handle) {
     if (handle) {
-        handle->port_api->stop_transfer(handle);
+        DMA_PORT_CALL(handle, stop_transfer)(handle);
     }
 }
 
@@ -98,13 +186,22 @@ void dma_enable_interrupt(dma_handle_t handle, dma_interrupt_t interrupt) {
 
 bool dma_is_interrupt_flag_set(dma_handle_t handle, dma_interrupt_t interrupt) {
     if (handle) {
-        return handle->port_api->is_interrupt_flag_set(handle, interrupt);
+        return DMA_PORT_CALL(handle, is_interrupt_flag_set)(handle, interrupt);
     }
     return false;
 }
 
 void dma_clear_interrupt_flag(dma_handle_t handle, dma_interrupt_t interrupt) {
     if (handle) {
-        handle->port_api->clear_interrupt_flag(handle, interrupt);
+        DMA_PORT_CALL(handle, clear_interrupt_flag)(handle, interrupt);
+    }
+}
+
+int dma_set_callback(dma_handle_t handle, dma_callback_t callback, void* user_data) {
+    if (handle == NULL) {
+        return -1; // Invalid arguments
     }
+    handle->callback = callback;
+    handle->callback_user_data = user_data;
+    return 0;
 }
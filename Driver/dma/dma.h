@@ -46,15 +46,44 @@ typedef enum {
     DMA_DATA_SIZE_32_BIT,
 } dma_data_size_t;
 
+/** @brief FIFO fill level at which the stream flushes to memory (FIFO mode only). */
+typedef enum {
+    DMA_FIFO_THRESHOLD_1_4 = 0,
+    DMA_FIFO_THRESHOLD_1_2,
+    DMA_FIFO_THRESHOLD_3_4,
+    DMA_FIFO_THRESHOLD_FULL,
+} dma_fifo_threshold_t;
+
+/** @brief Number of beats per AHB burst (incremental bursts need FIFO mode). */
+typedef enum {
+    DMA_BURST_SINGLE = 0,
+    DMA_BURST_INCR4,
+    DMA_BURST_INCR8,
+    DMA_BURST_INCR16,
+} dma_burst_t;
+
 /** @brief DMA interrupt types. */
 typedef enum {
     DMA_INTERRUPT_TRANSFER_COMPLETE,
     DMA_INTERRUPT_HALF_TRANSFER,
     DMA_INTERRUPT_TRANSFER_ERROR,
+    DMA_INTERRUPT_FIFO_ERROR,
 } dma_interrupt_t;
 
+/**
+ * @brief Callback invoked from the stream's interrupt.
+ * @details The callback owns the stream's flags: it must check and clear the
+ *          ones it enabled.
+ */
+typedef void (*dma_callback_t)(dma_handle_t handle, void* user_data);
+
 /**
  * @brief Configuration structure for DMA stream initialization.
+ * @details With `fifo_mode` false the stream runs in direct mode: single
+ *          beats, and peripheral and memory sizes must match. FIFO mode allows
+ *          packing (e.g. 8-bit peripheral reads into 32-bit memory writes) and
+ *          incremental bursts, provided one memory burst fits evenly within
+ *          the FIFO threshold; dma_init() rejects combinations that do not.
  */
 typedef struct {
     uint8_t channel;                  // Hardware channel selection (0-7)
@@ -65,6 +94,10 @@ typedef struct {
     bool peripheral_increment;
     bool memory_increment;
     bool circular_mode;
+    bool fifo_mode;                   // false = direct mode
+    dma_fifo_threshold_t fifo_threshold;
+    dma_burst_t memory_burst;
+    dma_burst_t peripheral_burst;
 } dma_config_t;
 
 /* --- Public API Functions --- */
@@ -80,6 +113,22 @@ typedef struct {
  */
 dma_handle_t dma_init(uint8_t dma_num, uint8_t stream_num, const dma_config_t* config);
 
+/**
+ * @brief Reprograms an initialized stream with new settings.
+ *
+ * @details The stream is stopped and its registers rewritten in place; the
+ *          handle, its stream binding and its callback are kept. Interrupt
+ *          enables are cleared and must be set again. Unlike a dma_deinit()
+ *          and dma_init() pair this never touches the handle pool, so it may
+ *          be called from the stream's own interrupt.
+ *
+ * @param[in] handle The handle to the DMA stream.
+ * @param[in] config Pointer to the new configuration.
+ *
+ * @return 0 on success, or -1 if the handle is NULL or the settings are invalid.
+ */
+int dma_reconfigure(dma_handle_t handle, const dma_config_t* config);
+
 /**
  * @brief De-initializes a DMA stream.
  *
@@ -97,6 +146,54 @@ void dma_deinit(dma_handle_t* p_handle);
  */
 void dma_start_transfer(dma_handle_t handle, const void* source_address, void* destination_address, uint16_t data_count);
 
+/**
+ * @brief Starts a peripheral-to-memory transfer in hardware double-buffer mode.
+ *
+ * @details The stream alternates between two memory targets, switching on
+ *          every transfer-complete event without stopping. While the DMA fills
+ *          one target, the CPU owns the other and may hand the stream a fresh
+ *          buffer with dma_set_next_buffer(). Double-buffer mode implies
+ *          circular mode, whatever `circular_mode` was configured to.
+ *
+ * @param[in] handle The handle to the DMA stream.
+ * @param[in] peripheral_address The peripheral data register to read from.
+ * @param[in] buffer0 The first memory target (filled first).
+ * @param[in] buffer1 The second memory target.
+ * @param[in] data_count The number of data items per target.
+ */
+void dma_start_double_buffer(dma_handle_t handle, const void* peripheral_address, void* buffer0, void* buffer1, uint16_t data_count);
+
+/**
+ * @brief Replaces the memory target the stream is not currently writing.
+ *
+ * @details Call from the transfer-complete interrupt to swap the buffer that
+ *          just filled for a fresh one. The new buffer is used the next time
+ *          the stream switches targets, so it must hold the same number of
+ *          items as passed to dma_start_double_buffer().
+ *
+ * @param[in] handle The handle to the DMA stream.
+ * @param[in] buffer The buffer to fill after the current target.
+ *
+ * @return 0 on success, or a negative error code on failure.
+ */
+int dma_set_next_buffer(dma_handle_t handle, void* buffer);
+
+/**
+ * @brief Gets the memory target the stream is currently writing.
+ * @param[in] handle The handle to the DMA stream.
+ * @return 0 if the stream is filling buffer0, 1 if it is filling buffer1.
+ */
+uint8_t dma_get_current_buffer(dma_handle_t handle);
+
+/**
+ * @brief Gets the number of data items left in the current transfer.
+ * @details In circular mode the count reloads at each wrap, so the write
+ *          position in the buffer is the transfer length minus this value.
+ * @param[in] handle The handle to the DMA stream.
+ * @return The remaining item count (NDTR), or 0 for an invalid handle.
+ */
+uint16_t dma_get_remaining_count(dma_handle_t handle);
+
 /**
  * @brief Stops the currently active DMA transfer.
  * @param[in] handle The handle to the DMA stream.
@@ -125,4 +222,16 @@ bool dma_is_interrupt_flag_set(dma_handle_t handle, dma_interrupt_t interrupt);
  */
 void dma_clear_interrupt_flag(dma_handle_t handle, dma_interrupt_t interrupt);
 
+/**
+ * @brief Sets the function called when the stream raises an interrupt.
+ * @details The driver owns the stream interrupt vectors and dispatches to the
+ *          callback of the handle bound to the stream. The NVIC line itself is
+ *          still enabled by the caller.
+ * @param[in] handle The handle to the DMA stream.
+ * @param[in] callback Function to call, or NULL to ignore the interrupt.
+ * @param[in] user_data Pointer passed back to the callback.
+ * @return 0 on success, or a negative error code on failure.
+ */
+int dma_set_callback(dma_handle_t handle, dma_callback_t callback, void* user_data);
+
 #endif // DMA_H
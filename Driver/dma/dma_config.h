@@ -11,4 +11,21 @@
  */
 #define DMA_MAX_HANDLES 8
 
+/**
+ * @brief Selects compile-time binding of the port for hot-path calls.
+ * @details When 1, transfer start/stop, buffer switching and interrupt flag
+ *          handling call the static inline port functions from
+ *          DMA_PORT_INLINE_HEADER directly, so they inline into ISRs instead
+ *          of going through the port function table. Leave at 0 for ports
+ *          that only provide the function table (e.g. a host-test port).
+ */
+#ifndef DMA_PORT_STATIC
+#define DMA_PORT_STATIC 0
+#endif
+
+/**
+ * @brief Port header providing the inline hot-path functions.
+ */
+#define DMA_PORT_INLINE_HEADER "port/stm32f407/dma_port_stm32f407_inline.h"
+
 #endif // DMA_CONFIG_H
@@ -20,6 +20,18 @@ struct dma_handle_t {
     const dma_port_interface_t* port_api;
     void* port_controller_instance; // Pointer to DMA controller (e.g., DMA1)
     void* port_stream_instance;     // Pointer to specific stream (e.g., DMA1_Stream0)
+    dma_callback_t callback;        // Called from the stream interrupt
+    void* callback_user_data;
 };
 
+/**
+ * @brief Resolves a hot-path port operation, either at compile time or via the handle.
+ */
+#if DMA_PORT_STATIC
+#include DMA_PORT_INLINE_HEADER
+#define DMA_PORT_CALL(handle, fn)   DMA_PORT_INLINE_##fn
+#else
+#define DMA_PORT_CALL(handle, fn)   ((handle)->port_api->fn)
+#endif
+
 #endif // DMA_PRIVATE_H
@@ -8,14 +8,21 @@
 
 struct dma_handle_t;
 
+typedef void (*dma_generic_handler_t)(uint8_t dma_num, uint8_t stream_num);
+
 typedef struct {
     void (*enable_clock)(uint8_t dma_num);
     void (*configure_stream)(struct dma_handle_t* handle);
     void (*start_transfer)(struct dma_handle_t* handle, const void* src, void* dest, uint16_t count);
+    void (*start_double_buffer)(struct dma_handle_t* handle, const void* periph, void* mem0, void* mem1, uint16_t count);
+    void (*set_idle_target)(struct dma_handle_t* handle, void* mem);
+    uint8_t (*get_current_target)(struct dma_handle_t* handle);
+    uint16_t (*get_remaining_count)(struct dma_handle_t* handle);
     void (*stop_transfer)(struct dma_handle_t* handle);
     void (*enable_interrupt)(struct dma_handle_t* handle, dma_interrupt_t interrupt);
     bool (*is_interrupt_flag_set)(struct dma_handle_t* handle, dma_interrupt_t interrupt);
     void (*clear_interrupt_flag)(struct dma_handle_t* handle, dma_interrupt_t interrupt);
+    void (*set_irq_handler)(dma_generic_handler_t handler);
 } dma_port_interface_t;
 
 /* --- Functions to be provided by the concrete port implementation --- */
@@ -5,25 +5,26 @@
 
 #include "internal/dma_private.h"
 #include "internal/dma_reg.h"
+#include "dma_port_stm32f407_inline.h"
 
 // Placeholder base addresses
 #define AHB1PERIPH_BASE       0x40020000UL
 #define DMA1_BASE             (AHB1PERIPH_BASE + 0x6000UL)
 #define DMA2_BASE             (AHB1PERIPH_BASE + 0x6400UL)
+#define RCC_BASE              (AHB1PERIPH_BASE + 0x3800UL)
 
-// --- Private Helper Functions for STM32F4 ---
+#define RCC_AHB1ENR           (*(volatile uint32_t*)(RCC_BASE + 0x30UL))
+#define RCC_AHB1ENR_DMA1EN    (1UL << 21)
+#define RCC_AHB1ENR_DMA2EN    (1UL << 22)
 
-// Offsets for interrupt flags within the LISR/HISR registers
-static const uint8_t flag_offsets = {0, 6, 16, 22};
-#define DMA_FLAG_TCIF (1 << 5)
-#define DMA_FLAG_HTIF (1 << 4)
-#define DMA_FLAG_TEIF (1 << 3)
+// --- Static Data ---
+static dma_generic_handler_t s_generic_handler = NULL;
 
 // --- Port Implementation ---
 
 static void stm32f4_enable_clock(uint8_t dma_num) {
-    // Placeholder: A real implementation would use the RCC driver.
-    // e.g., if (dma_num == 1) rcc_enable_peripheral_clock(PERIPH_ID_DMA1);
+    RCC_AHB1ENR |= (dma_num == 1) ? RCC_AHB1ENR_DMA1EN : RCC_AHB1ENR_DMA2EN;
+    (void)RCC_AHB1ENR; // The clock runs two cycles after the write
 }
 
 static void stm32f4_configure_stream(struct dma_handle_t* handle) {
@@ -43,38 +44,18 @@ static void stm32f4_configure_stream(struct dma_handle_t* handle) {
     if (config->peripheral_increment) { cr |= DMA_SxCR_PINC_Msk; }
     if (config->memory_increment) { cr |= DMA_SxCR_MINC_Msk; }
     if (config->circular_mode) { cr |= DMA_SxCR_CIRC_Msk; }
-
-    stream_regs->CR = cr;
-}
-
-static void stm32f4_start_transfer(struct dma_handle_t* handle, const void* src, void* dest, uint16_t count) {
-    dma_stream_reg_map_t* stream_regs = (dma_stream_reg_map_t*)handle->port_stream_instance;
-
-    // Ensure stream is disabled
-    stream_regs->CR &= ~DMA_SxCR_EN_Msk;
-    while (stream_regs->CR & DMA_SxCR_EN_Msk);
-
-    stream_regs->NDTR = count;
-
-    if (handle->config.direction == DMA_DIRECTION_MEMORY_TO_PERIPHERAL) {
-        stream_regs->PAR = (uint32_t)dest;
-        stream_regs->M0AR = (uint32_t)src;
-    } else {
-        stream_regs->PAR = (uint32_t)src;
-        stream_regs->M0AR = (uint32_t)dest;
+    cr |= (config->memory_burst << DMA_SxCR_MBURST_Pos);
+    cr |= (config->peripheral_burst << DMA_SxCR_PBURST_Pos);
+
+    // Direct mode unless the FIFO is requested (needed for packing and bursts)
+    uint32_t fcr = stream_regs->FCR & DMA_SxFCR_FEIE_Msk;
+    if (config->fifo_mode) {
+        fcr |= DMA_SxFCR_DMDIS_Msk;
+        fcr |= (config->fifo_threshold << DMA_SxFCR_FTH_Pos);
     }
 
-    // Clear all flags for this stream before starting
-    dma_port_get_api()->clear_interrupt_flag(handle, DMA_INTERRUPT_TRANSFER_COMPLETE);
-    dma_port_get_api()->clear_interrupt_flag(handle, DMA_INTERRUPT_HALF_TRANSFER);
-    dma_port_get_api()->clear_interrupt_flag(handle, DMA_INTERRUPT_TRANSFER_ERROR);
-
-    stream_regs->CR |= DMA_SxCR_EN_Msk;
-}
-
-static void stm32f4_stop_transfer(struct dma_handle_t* handle) {
-    dma_stream_reg_map_t* stream_regs = (dma_stream_reg_map_t*)handle->port_stream_instance;
-    stream_regs->CR &= ~DMA_SxCR_EN_Msk;
+    stream_regs->FCR = fcr;
+    stream_regs->CR = cr;
 }
 
 static void stm32f4_enable_interrupt(struct dma_handle_t* handle, dma_interrupt_t interrupt) {
@@ -83,45 +64,12 @@ static void stm32f4_enable_interrupt(struct dma_handle_t* handle, dma_interrupt_
         case DMA_INTERRUPT_TRANSFER_COMPLETE: stream_regs->CR |= DMA_SxCR_TCIE_Msk; break;
         case DMA_INTERRUPT_HALF_TRANSFER:     stream_regs->CR |= DMA_SxCR_HTIE_Msk; break;
         case DMA_INTERRUPT_TRANSFER_ERROR:    stream_regs->CR |= DMA_SxCR_TEIE_Msk; break;
+        case DMA_INTERRUPT_FIFO_ERROR:        stream_regs->FCR |= DMA_SxFCR_FEIE_Msk; break;
     }
 }
 
-static bool stm32f4_is_interrupt_flag_set(struct dma_handle_t* handle, dma_interrupt_t interrupt) {
-    dma_controller_reg_map_t* dma_regs = (dma_controller_reg_map_t*)handle->port_controller_instance;
-    uint8_t stream = handle->stream_num;
-    uint32_t flag = 0;
-
-    switch (interrupt) {
-        case DMA_INTERRUPT_TRANSFER_COMPLETE: flag = DMA_FLAG_TCIF; break;
-        case DMA_INTERRUPT_HALF_TRANSFER:     flag = DMA_FLAG_HTIF; break;
-        case DMA_INTERRUPT_TRANSFER_ERROR:    flag = DMA_FLAG_TEIF; break;
-    }
-
-    uint32_t offset = flag_offsets[stream % 4];
-    if (stream < 4) {
-        return (dma_regs->LISR & (flag << offset))!= 0;
-    } else {
-        return (dma_regs->HISR & (flag << offset))!= 0;
-    }
-}
-
-static void stm32f4_clear_interrupt_flag(struct dma_handle_t* handle, dma_interrupt_t interrupt) {
-    dma_controller_reg_map_t* dma_regs = (dma_controller_reg_map_t*)handle->port_controller_instance;
-    uint8_t stream = handle->stream_num;
-    uint32_t flag = 0;
-
-    switch (interrupt) {
-        case DMA_INTERRUPT_TRANSFER_COMPLETE: flag = DMA_FLAG_TCIF; break;
-        case DMA_INTERRUPT_HALF_TRANSFER:     flag = DMA_FLAG_HTIF; break;
-        case DMA_INTERRUPT_TRANSFER_ERROR:    flag = DMA_FLAG_TEIF; break;
-    }
-
-    uint32_t offset = flag_offsets[stream % 4];
-    if (stream < 4) {
-        dma_regs->LIFCR = (flag << offset);
-    } else {
-        dma_regs->HIFCR = (flag << offset);
-    }
+static void stm32f4_set_irq_handler(dma_generic_handler_t handler) {
+    s_generic_handler = handler;
 }
 
 // --- The concrete port interface for STM32F4 ---
@@ -129,10 +77,15 @@ static const dma_port_interface_t stm32f4_port_api = {
    .enable_clock = stm32f4_enable_clock,
    .configure_stream = stm32f4_configure_stream,
    .start_transfer = stm32f4_start_transfer,
+   .start_double_buffer = stm32f4_start_double_buffer,
+   .set_idle_target = stm32f4_set_idle_target,
+   .get_current_target = stm32f4_get_current_target,
+   .get_remaining_count = stm32f4_get_remaining_count,
    .stop_transfer = stm32f4_stop_transfer,
    .enable_interrupt = stm32f4_enable_interrupt,
    .is_interrupt_flag_set = stm32f4_is_interrupt_flag_set,
    .clear_interrupt_flag = stm32f4_clear_interrupt_flag,
+   .set_irq_handler = stm32f4_set_irq_handler,
 };
 
 // --- Public functions provided by the port ---
@@ -145,3 +98,28 @@ void* dma_port_get_base_addr(uint8_t dma_num) {
     if (dma_num == 2) return (void*)DMA2_BASE;
     return NULL;
 }
+
+// --- ISR Handlers ---
+// Each stream has its own vector; the generic handler finds the bound handle.
+
+#define DMA_STREAM_IRQ_HANDLER(dma, stream)                     \
+    void DMA##dma##_Stream##stream##_IRQHandler(void) {         \
+        if (s_generic_handler) s_generic_handler(dma, stream);  \
+    }
+
+DMA_STREAM_IRQ_HANDLER(1, 0)
+DMA_STREAM_IRQ_HANDLER(1, 1)
+DMA_STREAM_IRQ_HANDLER(1, 2)
+DMA_STREAM_IRQ_HANDLER(1, 3)
+DMA_STREAM_IRQ_HANDLER(1, 4)
+DMA_STREAM_IRQ_HANDLER(1, 5)
+DMA_STREAM_IRQ_HANDLER(1, 6)
+DMA_STREAM_IRQ_HANDLER(1, 7)
+DMA_STREAM_IRQ_HANDLER(2, 0)
+DMA_STREAM_IRQ_HANDLER(2, 1)
+DMA_STREAM_IRQ_HANDLER(2, 2)
+DMA_STREAM_IRQ_HANDLER(2, 3)
+DMA_STREAM_IRQ_HANDLER(2, 4)
+DMA_STREAM_IRQ_HANDLER(2, 5)
+DMA_STREAM_IRQ_HANDLER(2, 6)
+DMA_STREAM_IRQ_HANDLER(2, 7)
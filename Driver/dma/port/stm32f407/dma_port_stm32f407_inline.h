@@ -0,0 +1,155 @@
+/**
+ * @file      dma_port_stm32f407_inline.h
+ * @brief     Hot-path STM32F4xx DMA port operations as static inline functions.
+ * @note      Shared by the port's function table and, when DMA_PORT_STATIC is
+ *            enabled, called directly by dma.c so they inline into the caller.
+ */
+
+#ifndef DMA_PORT_STM32F407_INLINE_H
+#define DMA_PORT_STM32F407_INLINE_H
+
+#include "internal/dma_private.h"
+#include "internal/dma_reg.h"
+
+// Offsets for interrupt flags within the LISR/HISR registers
+static const uint8_t flag_offsets[] = {0, 6, 16, 22};
+#define DMA_FLAG_TCIF (1 << 5)
+#define DMA_FLAG_HTIF (1 << 4)
+#define DMA_FLAG_TEIF (1 << 3)
+#define DMA_FLAG_FEIF (1 << 0)
+
+static inline uint32_t stm32f4_interrupt_flag(dma_interrupt_t interrupt) {
+    switch (interrupt) {
+        case DMA_INTERRUPT_TRANSFER_COMPLETE: return DMA_FLAG_TCIF;
+        case DMA_INTERRUPT_HALF_TRANSFER:     return DMA_FLAG_HTIF;
+        case DMA_INTERRUPT_TRANSFER_ERROR:    return DMA_FLAG_TEIF;
+        case DMA_INTERRUPT_FIFO_ERROR:        return DMA_FLAG_FEIF;
+    }
+    return 0;
+}
+
+static inline bool stm32f4_is_interrupt_flag_set(struct dma_handle_t* handle, dma_interrupt_t interrupt) {
+    dma_controller_reg_map_t* dma_regs = (dma_controller_reg_map_t*)handle->port_controller_instance;
+    uint8_t stream = handle->stream_num;
+    uint32_t flag = stm32f4_interrupt_flag(interrupt);
+
+    uint32_t offset = flag_offsets[stream % 4];
+    if (stream < 4) {
+        return (dma_regs->LISR & (flag << offset)) != 0;
+    } else {
+        return (dma_regs->HISR & (flag << offset)) != 0;
+    }
+}
+
+static inline void stm32f4_clear_interrupt_flag(struct dma_handle_t* handle, dma_interrupt_t interrupt) {
+    dma_controller_reg_map_t* dma_regs = (dma_controller_reg_map_t*)handle->port_controller_instance;
+    uint8_t stream = handle->stream_num;
+    uint32_t flag = stm32f4_interrupt_flag(interrupt);
+
+    uint32_t offset = flag_offsets[stream % 4];
+    if (stream < 4) {
+        dma_regs->LIFCR = (flag << offset);
+    } else {
+        dma_regs->HIFCR = (flag << offset);
+    }
+}
+
+/**
+ * @brief Clears every event flag of the stream with a single write.
+ */
+static inline void stm32f4_clear_all_flags(struct dma_handle_t* handle) {
+    dma_controller_reg_map_t* dma_regs = (dma_controller_reg_map_t*)handle->port_controller_instance;
+    uint8_t stream = handle->stream_num;
+    uint32_t flags = (DMA_FLAG_TCIF | DMA_FLAG_HTIF | DMA_FLAG_TEIF | DMA_FLAG_FEIF) << flag_offsets[stream % 4];
+
+    if (stream < 4) {
+        dma_regs->LIFCR = flags;
+    } else {
+        dma_regs->HIFCR = flags;
+    }
+}
+
+static inline void stm32f4_start_transfer(struct dma_handle_t* handle, const void* src, void* dest, uint16_t count) {
+    dma_stream_reg_map_t* stream_regs = (dma_stream_reg_map_t*)handle->port_stream_instance;
+
+    // Ensure stream is disabled
+    stream_regs->CR &= ~DMA_SxCR_EN_Msk;
+    while (stream_regs->CR & DMA_SxCR_EN_Msk);
+
+    // Leave any previous double-buffer run and restore the configured mode
+    stream_regs->CR &= ~(DMA_SxCR_DBM_Msk | DMA_SxCR_CT_Msk);
+    if (!handle->config.circular_mode) { stream_regs->CR &= ~DMA_SxCR_CIRC_Msk; }
+
+    stream_regs->NDTR = count;
+
+    if (handle->config.direction == DMA_DIRECTION_MEMORY_TO_PERIPHERAL) {
+        stream_regs->PAR = (uint32_t)dest;
+        stream_regs->M0AR = (uint32_t)src;
+    } else {
+        stream_regs->PAR = (uint32_t)src;
+        stream_regs->M0AR = (uint32_t)dest;
+    }
+
+    // Clear all flags for this stream before starting
+    stm32f4_clear_all_flags(handle);
+
+    stream_regs->CR |= DMA_SxCR_EN_Msk;
+}
+
+static inline void stm32f4_start_double_buffer(struct dma_handle_t* handle, const void* periph, void* mem0, void* mem1, uint16_t count) {
+    dma_stream_reg_map_t* stream_regs = (dma_stream_reg_map_t*)handle->port_stream_instance;
+
+    // Ensure stream is disabled
+    stream_regs->CR &= ~DMA_SxCR_EN_Msk;
+    while (stream_regs->CR & DMA_SxCR_EN_Msk);
+
+    stream_regs->NDTR = count;
+    stream_regs->PAR = (uint32_t)periph;
+    stream_regs->M0AR = (uint32_t)mem0;
+    stream_regs->M1AR = (uint32_t)mem1;
+
+    // Clear all flags for this stream before starting
+    stm32f4_clear_all_flags(handle);
+
+    // DBM forces circular operation; start on target 0 (CT = 0)
+    stream_regs->CR = (stream_regs->CR & ~DMA_SxCR_CT_Msk) | DMA_SxCR_DBM_Msk | DMA_SxCR_CIRC_Msk;
+    stream_regs->CR |= DMA_SxCR_EN_Msk;
+}
+
+static inline void stm32f4_set_idle_target(struct dma_handle_t* handle, void* mem) {
+    dma_stream_reg_map_t* stream_regs = (dma_stream_reg_map_t*)handle->port_stream_instance;
+
+    // Only the target not selected by CT may be written while the stream runs
+    if (stream_regs->CR & DMA_SxCR_CT_Msk) {
+        stream_regs->M0AR = (uint32_t)mem;
+    } else {
+        stream_regs->M1AR = (uint32_t)mem;
+    }
+}
+
+static inline uint8_t stm32f4_get_current_target(struct dma_handle_t* handle) {
+    dma_stream_reg_map_t* stream_regs = (dma_stream_reg_map_t*)handle->port_stream_instance;
+    return (stream_regs->CR & DMA_SxCR_CT_Msk) ? 1 : 0;
+}
+
+static inline uint16_t stm32f4_get_remaining_count(struct dma_handle_t* handle) {
+    dma_stream_reg_map_t* stream_regs = (dma_stream_reg_map_t*)handle->port_stream_instance;
+    return (uint16_t)stream_regs->NDTR;
+}
+
+static inline void stm32f4_stop_transfer(struct dma_handle_t* handle) {
+    dma_stream_reg_map_t* stream_regs = (dma_stream_reg_map_t*)handle->port_stream_instance;
+    stream_regs->CR &= ~DMA_SxCR_EN_Msk;
+}
+
+// --- Compile-time bindings used by dma.c when DMA_PORT_STATIC is enabled ---
+#define DMA_PORT_INLINE_start_transfer          stm32f4_start_transfer
+#define DMA_PORT_INLINE_start_double_buffer     stm32f4_start_double_buffer
+#define DMA_PORT_INLINE_set_idle_target         stm32f4_set_idle_target
+#define DMA_PORT_INLINE_get_current_target      stm32f4_get_current_target
+#define DMA_PORT_INLINE_get_remaining_count     stm32f4_get_remaining_count
+#define DMA_PORT_INLINE_stop_transfer           stm32f4_stop_transfer
+#define DMA_PORT_INLINE_is_interrupt_flag_set   stm32f4_is_interrupt_flag_set
+#define DMA_PORT_INLINE_clear_interrupt_flag    stm32f4_clear_interrupt_flag
+
+#endif // DMA_PORT_STM32F407_INLINE_H
@@ -10,11 +10,14 @@
 #define APB2PERIPH_BASE       0x40010000UL
 #define SYSCFG_BASE           (APB2PERIPH_BASE + 0x3800UL)
 #define EXTI_BASE             (APB2PERIPH_BASE + 0x3C00UL)
+#define RCC_BASE              0x40023800UL
 #define NVIC_ISER_BASE        0xE000E100UL // Interrupt Set-Enable Registers
 
 #define SYSCFG                ((syscfg_reg_map_t*) SYSCFG_BASE)
 #define EXTI                  ((exti_reg_map_t*) EXTI_BASE)
 #define NVIC_ISER(n)          (((volatile uint32_t*) NVIC_ISER_BASE)[n])
+#define RCC_APB2ENR           (*(volatile uint32_t*)(RCC_BASE + 0x44UL))
+#define RCC_APB2ENR_SYSCFGEN  (1UL << 14)
 
 // --- Private Data ---
 static exti_generic_handler_t s_generic_handler = NULL;
@@ -22,8 +25,8 @@ static exti_generic_handler_t s_generic_handler = NULL;
 // --- Port Implementation ---
 
 static void stm32f4_enable_syscfg_clock(void) {
-    // Placeholder: A real implementation would use the RCC driver.
-    // e.g., rcc_enable_peripheral_clock(PERIPH_ID_SYSCFG);
+    RCC_APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+    (void)RCC_APB2ENR; // The clock runs two cycles after the write
 }
 
 static void stm32f4_configure_interrupt(uint8_t port_num, uint8_t pin_num, exti_trigger_t trigger) {
@@ -34,16 +37,12 @@ static void stm32f4_configure_interrupt(uint8_t port_num, uint8_t pin_num, exti_
     SYSCFG->EXTICR[reg_index] |= (port_num << shift);
 
     // 2. Configure trigger type
-    if (trigger == EXTI_TRIGGER_RISING |
-
-| trigger == EXTI_TRIGGER_BOTH) {
+    if (trigger == EXTI_TRIGGER_RISING || trigger == EXTI_TRIGGER_BOTH) {
         EXTI->RTSR |= (1 << pin_num);
     } else {
         EXTI->RTSR &= ~(1 << pin_num);
     }
-    if (trigger == EXTI_TRIGGER_FALLING |
-
-| trigger == EXTI_TRIGGER_BOTH) {
+    if (trigger == EXTI_TRIGGER_FALLING || trigger == EXTI_TRIGGER_BOTH) {
         EXTI->FTSR |= (1 << pin_num);
     } else {
         EXTI->FTSR &= ~(1 << pin_num);
@@ -101,7 +100,27 @@ void EXTI1_IRQHandler(void) {
         if (s_generic_handler) s_generic_handler(1);
     }
 }
-//... Add handlers for EXTI2, EXTI3, EXTI4...
+
+void EXTI2_IRQHandler(void) {
+    if (EXTI->PR & (1 << 2)) {
+        EXTI->PR = (1 << 2);
+        if (s_generic_handler) s_generic_handler(2);
+    }
+}
+
+void EXTI3_IRQHandler(void) {
+    if (EXTI->PR & (1 << 3)) {
+        EXTI->PR = (1 << 3);
+        if (s_generic_handler) s_generic_handler(3);
+    }
+}
+
+void EXTI4_IRQHandler(void) {
+    if (EXTI->PR & (1 << 4)) {
+        EXTI->PR = (1 << 4);
+        if (s_generic_handler) s_generic_handler(4);
+    }
+}
 
 void EXTI9_5_IRQHandler(void) {
     for (uint8_t i = 5; i <= 9; ++i) {
@@ -7,8 +7,8 @@
 #include <string.h>
 
 // --- Static Data ---
-static struct gpio_handle_t s_handle_pool;
-static bool s_is_handle_in_use = {false};
+static struct gpio_handle_t s_handle_pool[GPIO_MAX_HANDLES];
+static bool s_is_handle_in_use[GPIO_MAX_HANDLES] = {false};
 
 // --- Private Helper Functions ---
 static struct gpio_handle_t* allocate_handle(void) {
@@ -35,9 +35,7 @@ static void release_handle(gpio_handle_t handle) {
 // --- Public API Function Implementations ---
 
 gpio_handle_t gpio_init(uint8_t port_num, uint16_t pin_mask, const gpio_config_t* config) {
-    if (config == NULL |
-
-| pin_mask == 0) {
+    if (config == NULL || pin_mask == 0) {
         return NULL;
     }
 
@@ -94,3 +92,10 @@ bool gpio_read(gpio_handle_t handle) {
     }
     return false;
 }
+
+const void* gpio_get_input_register(gpio_handle_t handle) {
+    if (handle) {
+        return handle->port_api->get_input_register((void*)handle->port_hw_instance);
+    }
+    return NULL;
+}
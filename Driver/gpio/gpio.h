@@ -112,4 +112,11 @@ void gpio_toggle(gpio_handle_t handle);
  */
 bool gpio_read(gpio_handle_t handle);
 
+/**
+ * @brief Gets the address of the port's input data register, for use as a DMA source.
+ * @param[in] handle The handle to any pin(s) of the port.
+ * @return The register address, or NULL for an invalid handle.
+ */
+const void* gpio_get_input_register(gpio_handle_t handle);
+
 #endif // GPIO_H
@@ -16,7 +16,7 @@
 struct gpio_handle_t {
     const gpio_config_t config;
     const uint16_t pin_mask;              // Bitmask of pins this handle controls
-    const const void* port_hw_instance;   // Pointer to peripheral registers (e.g., GPIOA)
+    const void* port_hw_instance;         // Pointer to peripheral registers (e.g., GPIOA)
     const gpio_port_interface_t* port_api; // Pointer to hardware porting functions
 };
 
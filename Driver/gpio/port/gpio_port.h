@@ -19,6 +19,7 @@ typedef struct {
     void (*clear_pins)(void* port_hw_instance, uint16_t pin_mask);
     void (*toggle_pins)(void* port_hw_instance, uint16_t pin_mask);
     uint16_t (*read_pins)(void* port_hw_instance);
+    const void* (*get_input_register)(void* port_hw_instance);
 } gpio_port_interface_t;
 
 /* --- Functions to be provided by the concrete port implementation --- */
@@ -11,13 +11,19 @@
 #define GPIOA_BASE            (AHB1PERIPH_BASE + 0x0000UL)
 #define GPIOB_BASE            (AHB1PERIPH_BASE + 0x0400UL)
 #define GPIOC_BASE            (AHB1PERIPH_BASE + 0x0800UL)
+#define GPIOD_BASE            (AHB1PERIPH_BASE + 0x0C00UL)
+#define GPIOE_BASE            (AHB1PERIPH_BASE + 0x1000UL)
 //... add other ports as needed
+#define RCC_BASE              (AHB1PERIPH_BASE + 0x3800UL)
+
+#define RCC_AHB1ENR           (*(volatile uint32_t*)(RCC_BASE + 0x30UL))
 
 // --- Private function implementations for STM32F4 ---
 
 static void stm32f4_enable_clock(uint8_t port_num) {
-    // Placeholder: A real implementation would use the RCC driver.
-    // e.g., RCC->AHB1ENR |= (1 << port_num);
+    // GPIOxEN bits are in port order, GPIOA at bit 0
+    RCC_AHB1ENR |= 1UL << port_num;
+    (void)RCC_AHB1ENR; // The clock runs two cycles after the write
 }
 
 static void stm32f4_configure_pins(struct gpio_handle_t* handle) {
@@ -36,9 +42,7 @@ static void stm32f4_configure_pins(struct gpio_handle_t* handle) {
             gpio_regs->PUPDR &= ~(0b11 << (i * 2));
             gpio_regs->PUPDR |= (pull_val << (i * 2));
 
-            if (config->mode == GPIO_MODE_OUTPUT |
-
-| config->mode == GPIO_MODE_ALTERNATE_FUNCTION) {
+            if (config->mode == GPIO_MODE_OUTPUT || config->mode == GPIO_MODE_ALTERNATE_FUNCTION) {
                 // --- Configure Output Type ---
                 gpio_regs->OTYPER &= ~(1 << i);
                 gpio_regs->OTYPER |= (config->output_type << i);
@@ -82,6 +86,10 @@ static uint16_t stm32f4_read_pins(void* port_hw_instance) {
     return (uint16_t)((gpio_reg_map_t*)port_hw_instance)->IDR;
 }
 
+static const void* stm32f4_get_input_register(void* port_hw_instance) {
+    return (const void*)&((gpio_reg_map_t*)port_hw_instance)->IDR;
+}
+
 // --- The concrete port interface for STM32F4 ---
 static const gpio_port_interface_t stm32f4_port_api = {
    .enable_clock = stm32f4_enable_clock,
@@ -90,6 +98,7 @@ static const gpio_port_interface_t stm32f4_port_api = {
    .clear_pins = stm32f4_clear_pins,
    .toggle_pins = stm32f4_toggle_pins,
    .read_pins = stm32f4_read_pins,
+   .get_input_register = stm32f4_get_input_register,
 };
 
 // --- Public functions provided by the port ---
@@ -102,6 +111,8 @@ void* gpio_port_get_base_addr(uint8_t port_num) {
         case 0: return (void*)GPIOA_BASE;
         case 1: return (void*)GPIOB_BASE;
         case 2: return (void*)GPIOC_BASE;
+        case 3: return (void*)GPIOD_BASE;
+        case 4: return (void*)GPIOE_BASE;
         //... add other ports as needed
         default: return NULL;
     }
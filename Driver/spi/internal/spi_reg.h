@@ -34,6 +34,8 @@ typedef struct {
 /* --- Register Bit Field Definitions (CR1) --- */
 #define SPI_CR1_BIDIMODE_Pos (15U)
 #define SPI_CR1_BIDIMODE_Msk (1UL << SPI_CR1_BIDIMODE_Pos)
+#define SPI_CR1_RXONLY_Pos   (10U)
+#define SPI_CR1_RXONLY_Msk   (1UL << SPI_CR1_RXONLY_Pos)
 #define SPI_CR1_DFF_Pos      (11U)
 #define SPI_CR1_DFF_Msk      (1UL << SPI_CR1_DFF_Pos)
 #define SPI_CR1_SSM_Pos      (9U)
@@ -56,6 +58,8 @@ typedef struct {
 /* --- Register Bit Field Definitions (CR2) --- */
 #define SPI_CR2_SSOE_Pos     (2U)
 #define SPI_CR2_SSOE_Msk     (1UL << SPI_CR2_SSOE_Pos)
+#define SPI_CR2_RXDMAEN_Pos  (0U)
+#define SPI_CR2_RXDMAEN_Msk  (1UL << SPI_CR2_RXDMAEN_Pos)
 
 /* --- Register Bit Field Definitions (SR) --- */
 #define SPI_SR_BSY_Pos       (7U)
@@ -19,6 +19,8 @@ typedef struct {
     uint8_t (*transfer_byte)(struct spi_handle_t* handle, uint8_t tx_byte);
     void (*enable)(struct spi_handle_t* handle);
     void (*disable)(struct spi_handle_t* handle);
+    void (*set_rx_dma)(struct spi_handle_t* handle, bool enable);
+    const void* (*get_data_register)(struct spi_handle_t* handle);
 } spi_port_interface_t;
 
 /* --- Functions to be provided by the concrete port implementation --- */
@@ -12,6 +12,12 @@
 #define APB2PERIPH_BASE       (PERIPH_BASE + 0x00010000UL)
 #define SPI1_BASE             (APB2PERIPH_BASE + 0x3000UL)
 #define SPI2_BASE             (APB1PERIPH_BASE + 0x3800UL)
+#define RCC_BASE              (PERIPH_BASE + 0x00023800UL)
+
+#define RCC_APB1ENR           (*(volatile uint32_t*)(RCC_BASE + 0x40UL))
+#define RCC_APB2ENR           (*(volatile uint32_t*)(RCC_BASE + 0x44UL))
+#define RCC_APB1ENR_SPI2EN    (1UL << 14)
+#define RCC_APB2ENR_SPI1EN    (1UL << 12)
 
 // --- Private function implementations for STM32F4 ---
 
@@ -43,11 +49,22 @@ static void stm32f4_configure_core(struct spi_handle_t* handle) {
     const spi_config_t* config = &handle->config;
     uint32_t cr1 = 0;
 
-    // Set master mode, software slave management, and internal slave select
-    cr1 |= SPI_CR1_MSTR_Msk | SPI_CR1_SSM_Msk | SPI_CR1_SSI_Msk;
-
-    // Baud Rate Prescaler
-    cr1 |= (config->baud_rate_prescaler << SPI_CR1_BR_Pos);
+    if (config->mode == SPI_MODE_SLAVE_RX_ONLY) {
+        // Slave with hardware NSS, so the bus chip select gates reception;
+        // RXONLY keeps the MISO pin released
+        cr1 |= SPI_CR1_RXONLY_Msk;
+    } else {
+        // Set master mode, software slave management, and internal slave select
+        cr1 |= SPI_CR1_MSTR_Msk | SPI_CR1_SSM_Msk | SPI_CR1_SSI_Msk;
+
+        // Receive-only master: SCK runs without writes to DR while enabled
+        if (config->mode == SPI_MODE_MASTER_RX_ONLY) {
+            cr1 |= SPI_CR1_RXONLY_Msk;
+        }
+
+        // Baud Rate Prescaler
+        cr1 |= (config->baud_rate_prescaler << SPI_CR1_BR_Pos);
+    }
 
     // Clock Polarity and Phase
     cr1 |= (config->clock_polarity << SPI_CR1_CPOL_Pos);
@@ -69,9 +86,28 @@ static void stm32f4_configure_core(struct spi_handle_t* handle) {
     // spi_regs->CR2 |= SPI_CR2_SSOE_Msk;
 }
 
+static void stm32f4_set_rx_dma(struct spi_handle_t* handle, bool enable) {
+    spi_reg_map_t* spi_regs = (spi_reg_map_t*)handle->port_hw_instance;
+    if (enable) {
+        spi_regs->CR2 |= SPI_CR2_RXDMAEN_Msk;
+    } else {
+        spi_regs->CR2 &= ~SPI_CR2_RXDMAEN_Msk;
+    }
+}
+
+static const void* stm32f4_get_data_register(struct spi_handle_t* handle) {
+    spi_reg_map_t* spi_regs = (spi_reg_map_t*)handle->port_hw_instance;
+    return (const void*)&spi_regs->DR;
+}
+
 static void stm32f4_enable_clock(struct spi_handle_t* handle) {
-    // Placeholder: A real implementation would use the RCC driver.
-    // e.g., rcc_periph_clock_enable(RCC_SPI1);
+    if (handle->port_hw_instance == (void*)SPI1_BASE) {
+        RCC_APB2ENR |= RCC_APB2ENR_SPI1EN;
+        (void)RCC_APB2ENR;
+    } else {
+        RCC_APB1ENR |= RCC_APB1ENR_SPI2EN;
+        (void)RCC_APB1ENR; // The clock runs two cycles after the write
+    }
 }
 
 static void stm32f4_init_pins(struct spi_handle_t* handle) {
@@ -87,6 +123,8 @@ static const spi_port_interface_t stm32f4_port_api = {
   .transfer_byte = stm32f4_transfer_byte,
   .enable = stm32f4_enable,
   .disable = stm32f4_disable,
+  .set_rx_dma = stm32f4_set_rx_dma,
+  .get_data_register = stm32f4_get_data_register,
 };
 
 // --- Public functions provided by the port ---
@@ -7,8 +7,8 @@
 #include <string.h>
 
 // --- Static Data ---
-static struct spi_handle_t s_handle_pool;
-static bool s_is_handle_in_use = {false};
+static struct spi_handle_t s_handle_pool[SPI_MAX_INSTANCES];
+static bool s_is_handle_in_use[SPI_MAX_INSTANCES] = {false};
 
 // --- Private Helper Functions ---
 static struct spi_handle_t* allocate_handle(void) {
@@ -46,9 +46,7 @@ spi_handle_t spi_init(uint8_t instance_num, const spi_config_t* config) {
     handle->port_api = spi_port_get_api_for_instance(instance_num);
     handle->port_hw_instance = spi_port_get_base_addr_for_instance(instance_num);
 
-    if (handle->port_api == NULL |
-
-| handle->port_hw_instance == NULL) {
+    if (handle->port_api == NULL || handle->port_hw_instance == NULL) {
         release_handle(handle);
         return NULL;
     }
@@ -58,16 +56,16 @@ spi_handle_t spi_init(uint8_t instance_num, const spi_config_t* config) {
     handle->port_api->enable_clock(handle);
     handle->port_api->init_pins(handle);
     handle->port_api->configure_core(handle);
-    handle->port_api->enable(handle);
+    if (config->mode != SPI_MODE_MASTER_RX_ONLY) {
+        handle->port_api->enable(handle);
+    }
 
     handle->context.is_initialized = true;
     return handle;
 }
 
 void spi_deinit(spi_handle_t* p_handle) {
-    if (p_handle == NULL |
-
-| *p_handle == NULL) {
+    if (p_handle == NULL || *p_handle == NULL) {
         return;
     }
     spi_handle_t handle = *p_handle;
@@ -83,6 +81,9 @@ int spi_transfer_blocking(spi_handle_t handle, const uint8_t* p_tx_data, uint8_t
     if (handle == NULL ||!handle->context.is_initialized) {
         return -1; // Invalid arguments
     }
+    if (handle->config.mode != SPI_MODE_MASTER) {
+        return -2; // A receive-only slave cannot start transfers
+    }
 
     const uint8_t DUMMY_BYTE = 0xFF;
 
@@ -95,3 +96,30 @@ int spi_transfer_blocking(spi_handle_t handle, const uint8_t* p_tx_data, uint8_t
     }
     return 0;
 }
+
+int spi_set_rx_dma(spi_handle_t handle, bool enable) {
+    if (handle == NULL || !handle->context.is_initialized) {
+        return -1; // Invalid arguments
+    }
+    handle->port_api->set_rx_dma(handle, enable);
+    return 0;
+}
+
+const void* spi_get_data_register(spi_handle_t handle) {
+    if (handle == NULL || !handle->context.is_initialized) {
+        return NULL;
+    }
+    return handle->port_api->get_data_register(handle);
+}
+
+int spi_set_enabled(spi_handle_t handle, bool enable) {
+    if (handle == NULL || !handle->context.is_initialized) {
+        return -1; // Invalid arguments
+    }
+    if (enable) {
+        handle->port_api->enable(handle);
+    } else {
+        handle->port_api->disable(handle);
+    }
+    return 0;
+}
@@ -5,7 +5,8 @@
  * @date      2023-10-27
  *
  * @details   This file defines the user-facing functions and data structures
- *            for interacting with an SPI peripheral in master mode.
+ *            for interacting with an SPI peripheral in master mode, or as a
+ *            receive-only slave for listening to an external bus.
  */
 
 #ifndef SPI_H
@@ -54,20 +55,33 @@ typedef enum {
     SPI_BIT_ORDER_LSB_FIRST = 1, //!< Least significant bit transmitted first.
 } spi_bit_order_t;
 
+/** @brief Role of the peripheral on the bus. */
+typedef enum {
+    SPI_MODE_MASTER = 0,    //!< Drives SCK and performs full-duplex transfers.
+    SPI_MODE_SLAVE_RX_ONLY, //!< Clocked by an external master, receives on MOSI, gated by the NSS pin.
+    SPI_MODE_MASTER_RX_ONLY,//!< Clocks continuously once enabled, receives on MISO.
+} spi_mode_t;
+
 /**
- * @brief Configuration structure for SPI initialization (Master Mode).
+ * @brief Configuration structure for SPI initialization.
  */
 typedef struct {
-    spi_baud_rate_t baud_rate_prescaler; //!< Clock speed prescaler.
+    spi_baud_rate_t baud_rate_prescaler; //!< Clock speed prescaler (master mode only).
     spi_clock_polarity_t clock_polarity; //!< Clock polarity (CPOL).
     spi_clock_phase_t clock_phase;       //!< Clock phase (CPHA).
     spi_bit_order_t bit_order;           //!< MSB or LSB first.
+    spi_mode_t mode;                     //!< Master (default) or receive-only slave.
 } spi_config_t;
 
 /* --- Public API Functions --- */
 
 /**
- * @brief Initializes an SPI peripheral instance in master mode.
+ * @brief Initializes an SPI peripheral instance.
+ *
+ * @details The peripheral is enabled on return, except in
+ *          SPI_MODE_MASTER_RX_ONLY: there the clock runs as soon as it is
+ *          enabled, so the caller first sets up reception and then calls
+ *          spi_set_enabled().
  *
  * @param[in] instance_num The hardware instance number (e.g., 1 for SPI1).
  * @param[in] config Pointer to the user-provided configuration structure.
@@ -102,4 +116,32 @@ void spi_deinit(spi_handle_t* p_handle);
  */
 int spi_transfer_blocking(spi_handle_t handle, const uint8_t* p_tx_data, uint8_t* p_rx_data, size_t len);
 
+/**
+ * @brief Enables or disables DMA requests for received data.
+ *
+ * @details With RX DMA enabled, each received frame raises a DMA request
+ *          that should be served by a stream reading spi_get_data_register().
+ *
+ * @param[in] handle The handle to the SPI instance.
+ * @param[in] enable true to raise RX DMA requests, false to stop them.
+ *
+ * @return 0 on success, or a negative error code on failure.
+ */
+int spi_set_rx_dma(spi_handle_t handle, bool enable);
+
+/**
+ * @brief Gets the address of the data register, for use as a DMA source.
+ * @param[in] handle The handle to the SPI instance.
+ * @return The data register address, or NULL for an invalid handle.
+ */
+const void* spi_get_data_register(spi_handle_t handle);
+
+/**
+ * @brief Enables or disables the peripheral.
+ * @param[in] handle The handle to the SPI instance.
+ * @param[in] enable true to enable, false to disable.
+ * @return 0 on success, or a negative error code on failure.
+ */
+int spi_set_enabled(spi_handle_t handle, bool enable);
+
 #endif // SPI_H
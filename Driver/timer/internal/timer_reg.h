@@ -52,10 +52,47 @@ typedef struct {
 #define TIM_CR1_ARPE_Pos    (7U)
 #define TIM_CR1_ARPE_Msk    (1UL << TIM_CR1_ARPE_Pos)
 
+#define TIM_CR2_MMS_Pos     (4U)
+#define TIM_CR2_MMS_Msk     (7UL << TIM_CR2_MMS_Pos)
+
 #define TIM_DIER_UIE_Pos    (0U)
 #define TIM_DIER_UIE_Msk    (1UL << TIM_DIER_UIE_Pos)
+#define TIM_DIER_UDE_Pos    (8U)
+#define TIM_DIER_UDE_Msk    (1UL << TIM_DIER_UDE_Pos)
+
+#define TIM_DIER_CC1DE_Pos  (9U)     // CCxDE at (8 + x)
+#define TIM_DIER_TDE_Pos    (14U)
+#define TIM_DIER_TDE_Msk    (1UL << TIM_DIER_TDE_Pos)
+
+#define TIM_SMCR_SMS_Pos    (0U)
+#define TIM_SMCR_SMS_GATED  (5UL << TIM_SMCR_SMS_Pos)   // Gated mode
+#define TIM_SMCR_SMS_EXT1   (7UL << TIM_SMCR_SMS_Pos)   // External clock mode 1
+#define TIM_SMCR_TS_Pos     (4U)
+#define TIM_SMCR_TS_TI1FP1  (5UL << TIM_SMCR_TS_Pos)
+#define TIM_SMCR_TS_TI2FP2  (6UL << TIM_SMCR_TS_Pos)
+#define TIM_SMCR_TS_ETRF    (7UL << TIM_SMCR_TS_Pos)
+#define TIM_SMCR_ETF_Pos    (8U)
+#define TIM_SMCR_ETP_Msk    (1UL << 15)
 
 #define TIM_SR_UIF_Pos      (0U)
 #define TIM_SR_UIF_Msk      (1UL << TIM_SR_UIF_Pos)
+#define TIM_SR_CC1OF_Pos    (9U)     // CCxOF at (8 + x)
+#define TIM_SR_CCOF_Msk     (0xFUL << TIM_SR_CC1OF_Pos)
+
+// CCMR1 holds channels 1-2 and CCMR2 channels 3-4, one byte each
+#define TIM_CCMR_CCS_Pos    (0U)     // 01: input, mapped on its own TIx
+#define TIM_CCMR_CCS_Msk    (3UL << TIM_CCMR_CCS_Pos)
+#define TIM_CCMR_CCS_TI     (1UL << TIM_CCMR_CCS_Pos)
+#define TIM_CCMR_ICPSC_Pos  (2U)
+#define TIM_CCMR_ICPSC_Msk  (3UL << TIM_CCMR_ICPSC_Pos)
+#define TIM_CCMR_ICF_Pos    (4U)
+#define TIM_CCMR_ICF_Msk    (0xFUL << TIM_CCMR_ICF_Pos)
+#define TIM_CCMR_CHANNEL_Msk (0xFFUL)
+
+// CCER holds 4 bits per channel
+#define TIM_CCER_CCE_Msk    (1UL << 0)
+#define TIM_CCER_CCP_Msk    (1UL << 1)
+#define TIM_CCER_CCNP_Msk   (1UL << 3)
+#define TIM_CCER_CHANNEL_Msk (0xFUL)
 
 #endif // TIMER_REG_H
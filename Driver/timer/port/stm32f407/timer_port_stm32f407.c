@@ -13,13 +13,31 @@
 #define TIM3_BASE             (APB1PERIPH_BASE + 0x0400UL)
 #define TIM4_BASE             (APB1PERIPH_BASE + 0x0800UL)
 #define TIM5_BASE             (APB1PERIPH_BASE + 0x0C00UL)
+#define TIM6_BASE             (APB1PERIPH_BASE + 0x1000UL)
+#define TIM7_BASE             (APB1PERIPH_BASE + 0x1400UL)
 #define TIM1_BASE             (APB2PERIPH_BASE + 0x0000UL)
+#define TIM8_BASE             (APB2PERIPH_BASE + 0x0400UL)
+#define RCC_BASE              0x40023800UL
+
+#define RCC_APB1ENR           (*(volatile uint32_t*)(RCC_BASE + 0x40UL))
+#define RCC_APB2ENR           (*(volatile uint32_t*)(RCC_BASE + 0x44UL))
+#define RCC_APB2ENR_TIM1EN    (1UL << 0)
+#define RCC_APB2ENR_TIM8EN    (1UL << 1)
 
 // --- Private function implementations for STM32F4 ---
 
 static void stm32f4_enable_clock(uint8_t instance_num) {
-    // Placeholder: A real implementation would use the RCC driver.
-    // e.g., rcc_enable_peripheral_clock(PERIPH_ID_TIM2);
+    if (instance_num == 1) {
+        RCC_APB2ENR |= RCC_APB2ENR_TIM1EN;
+        (void)RCC_APB2ENR;
+    } else if (instance_num == 8) {
+        RCC_APB2ENR |= RCC_APB2ENR_TIM8EN;
+        (void)RCC_APB2ENR;
+    } else {
+        // TIM2..TIM7 enable bits are 0..5 of APB1ENR
+        RCC_APB1ENR |= 1UL << (instance_num - 2U);
+        (void)RCC_APB1ENR; // The clock runs two cycles after the write
+    }
 }
 
 static void stm32f4_configure_core(struct timer_handle_t* handle) {
@@ -60,6 +78,144 @@ static void stm32f4_clear_update_irq_flag(struct timer_handle_t* handle) {
     ((timer_reg_map_t*)handle->port_hw_instance)->SR &= ~TIM_SR_UIF_Msk;
 }
 
+static void stm32f4_enable_update_dma(struct timer_handle_t* handle) {
+    ((timer_reg_map_t*)handle->port_hw_instance)->DIER |= TIM_DIER_UDE_Msk;
+}
+
+static void stm32f4_disable_update_dma(struct timer_handle_t* handle) {
+    ((timer_reg_map_t*)handle->port_hw_instance)->DIER &= ~TIM_DIER_UDE_Msk;
+}
+
+/**
+ * @brief Maps a channel onto its own input pin with a filter and edge polarity, left disabled.
+ */
+static void configure_channel_input(timer_reg_map_t* timer_regs, uint8_t channel,
+                                    timer_ic_polarity_t polarity, uint8_t filter) {
+    volatile uint32_t* ccmr = (channel <= 2) ? &timer_regs->CCMR1 : &timer_regs->CCMR2;
+    uint32_t ccmr_shift = ((channel - 1U) & 1U) * 8U;
+    uint32_t ccer_shift = (channel - 1U) * 4U;
+
+    // The channel must be disabled while CCxS is written
+    timer_regs->CCER &= ~(TIM_CCER_CHANNEL_Msk << ccer_shift);
+
+    uint32_t mode = TIM_CCMR_CCS_TI | ((uint32_t)filter << TIM_CCMR_ICF_Pos);
+    *ccmr = (*ccmr & ~(TIM_CCMR_CHANNEL_Msk << ccmr_shift)) | (mode << ccmr_shift);
+
+    uint32_t ccer = 0;
+    switch (polarity) {
+        case TIMER_IC_POLARITY_RISING:  break;
+        case TIMER_IC_POLARITY_FALLING: ccer |= TIM_CCER_CCP_Msk; break;
+        case TIMER_IC_POLARITY_BOTH:    ccer |= TIM_CCER_CCP_Msk | TIM_CCER_CCNP_Msk; break;
+    }
+    timer_regs->CCER |= ccer << ccer_shift;
+}
+
+static void stm32f4_configure_input_capture(struct timer_handle_t* handle, uint8_t channel, const timer_ic_config_t* config) {
+    timer_reg_map_t* timer_regs = (timer_reg_map_t*)handle->port_hw_instance;
+    configure_channel_input(timer_regs, channel, config->polarity, config->filter);
+    timer_regs->CCER |= TIM_CCER_CCE_Msk << ((channel - 1U) * 4U);
+}
+
+static void stm32f4_disable_input_capture(struct timer_handle_t* handle, uint8_t channel) {
+    timer_reg_map_t* timer_regs = (timer_reg_map_t*)handle->port_hw_instance;
+    timer_regs->CCER &= ~(TIM_CCER_CCE_Msk << ((channel - 1U) * 4U));
+}
+
+static void stm32f4_set_capture_dma(struct timer_handle_t* handle, uint8_t channel, bool enable) {
+    timer_reg_map_t* timer_regs = (timer_reg_map_t*)handle->port_hw_instance;
+    uint32_t mask = 1UL << (TIM_DIER_CC1DE_Pos + channel - 1U);
+    if (enable) {
+        timer_regs->DIER |= mask;
+    } else {
+        timer_regs->DIER &= ~mask;
+    }
+}
+
+static const void* stm32f4_get_capture_register(struct timer_handle_t* handle, uint8_t channel) {
+    timer_reg_map_t* timer_regs = (timer_reg_map_t*)handle->port_hw_instance;
+    return (const void*)(&timer_regs->CCR1 + (channel - 1U));
+}
+
+static uint32_t stm32f4_get_and_clear_overcapture(struct timer_handle_t* handle) {
+    timer_reg_map_t* timer_regs = (timer_reg_map_t*)handle->port_hw_instance;
+    uint32_t flags = timer_regs->SR & TIM_SR_CCOF_Msk;
+    // SR bits are rc_w0: writing 1 leaves the other flags untouched
+    timer_regs->SR = ~flags;
+    return flags >> TIM_SR_CC1OF_Pos;
+}
+
+/**
+ * @brief Routes the configured input to TRGI and returns the SMCR trigger bits.
+ */
+static uint32_t select_trigger_input(timer_reg_map_t* timer_regs, const timer_clock_config_t* config) {
+    uint32_t smcr = 0;
+
+    switch (config->source) {
+        case TIMER_CLOCK_INTERNAL:
+            break;
+        case TIMER_CLOCK_TI1:
+            configure_channel_input(timer_regs, 1, config->polarity, config->filter);
+            smcr = TIM_SMCR_TS_TI1FP1;
+            break;
+        case TIMER_CLOCK_TI2:
+            configure_channel_input(timer_regs, 2, config->polarity, config->filter);
+            smcr = TIM_SMCR_TS_TI2FP2;
+            break;
+        case TIMER_CLOCK_ETR:
+            smcr = TIM_SMCR_TS_ETRF | ((uint32_t)config->filter << TIM_SMCR_ETF_Pos);
+            if (config->polarity == TIMER_IC_POLARITY_FALLING) {
+                smcr |= TIM_SMCR_ETP_Msk;
+            }
+            break;
+    }
+    return smcr;
+}
+
+static void stm32f4_set_clock_source(struct timer_handle_t* handle, const timer_clock_config_t* config) {
+    timer_reg_map_t* timer_regs = (timer_reg_map_t*)handle->port_hw_instance;
+
+    // ETRF is used as TRGI in external clock mode 1 (rather than mode 2), so
+    // each edge is also a trigger event
+    if (config->source == TIMER_CLOCK_INTERNAL) {
+        timer_regs->SMCR = 0;
+    } else {
+        timer_regs->SMCR = TIM_SMCR_SMS_EXT1 | select_trigger_input(timer_regs, config);
+    }
+}
+
+static void stm32f4_set_gated_clock(struct timer_handle_t* handle, const timer_clock_config_t* gate) {
+    timer_reg_map_t* timer_regs = (timer_reg_map_t*)handle->port_hw_instance;
+    timer_regs->SMCR = TIM_SMCR_SMS_GATED | select_trigger_input(timer_regs, gate);
+}
+
+static void stm32f4_set_trigger_dma(struct timer_handle_t* handle, bool enable) {
+    timer_reg_map_t* timer_regs = (timer_reg_map_t*)handle->port_hw_instance;
+    if (enable) {
+        timer_regs->DIER |= TIM_DIER_TDE_Msk;
+    } else {
+        timer_regs->DIER &= ~TIM_DIER_TDE_Msk;
+    }
+}
+
+static void stm32f4_configure_encoder(struct timer_handle_t* handle, const timer_encoder_config_t* config) {
+    timer_reg_map_t* timer_regs = (timer_reg_map_t*)handle->port_hw_instance;
+
+    configure_channel_input(timer_regs, 1, config->invert_ti1 ? TIMER_IC_POLARITY_FALLING : TIMER_IC_POLARITY_RISING,
+                            config->filter);
+    configure_channel_input(timer_regs, 2, config->invert_ti2 ? TIMER_IC_POLARITY_FALLING : TIMER_IC_POLARITY_RISING,
+                            config->filter);
+
+    // SMS encoder modes 1-3 match the enum values
+    timer_regs->SMCR = (uint32_t)config->mode << TIM_SMCR_SMS_Pos;
+}
+
+static void stm32f4_set_trigger_output(struct timer_handle_t* handle, timer_trigger_output_t output) {
+    timer_reg_map_t* timer_regs = (timer_reg_map_t*)handle->port_hw_instance;
+
+    // MMS reset/enable/update codes 0-2 match the enum values
+    timer_regs->CR2 = (timer_regs->CR2 & ~TIM_CR2_MMS_Msk) | ((uint32_t)output << TIM_CR2_MMS_Pos);
+}
+
 // --- The concrete port interface for STM32F4 ---
 static const timer_port_interface_t stm32f4_port_api = {
    .enable_clock = stm32f4_enable_clock,
@@ -71,6 +227,18 @@ static const timer_port_interface_t stm32f4_port_api = {
    .disable_update_irq = stm32f4_disable_update_irq,
    .is_update_irq_flag_set = stm32f4_is_update_irq_flag_set,
    .clear_update_irq_flag = stm32f4_clear_update_irq_flag,
+   .enable_update_dma = stm32f4_enable_update_dma,
+   .disable_update_dma = stm32f4_disable_update_dma,
+   .configure_input_capture = stm32f4_configure_input_capture,
+   .disable_input_capture = stm32f4_disable_input_capture,
+   .set_capture_dma = stm32f4_set_capture_dma,
+   .get_capture_register = stm32f4_get_capture_register,
+   .get_and_clear_overcapture = stm32f4_get_and_clear_overcapture,
+   .set_clock_source = stm32f4_set_clock_source,
+   .set_trigger_dma = stm32f4_set_trigger_dma,
+   .set_gated_clock = stm32f4_set_gated_clock,
+   .configure_encoder = stm32f4_configure_encoder,
+   .set_trigger_output = stm32f4_set_trigger_output,
 };
 
 // --- Public functions provided by the port ---
@@ -85,6 +253,9 @@ void* timer_port_get_base_addr(uint8_t instance_num) {
         case 3: return (void*)TIM3_BASE;
         case 4: return (void*)TIM4_BASE;
         case 5: return (void*)TIM5_BASE;
+        case 6: return (void*)TIM6_BASE;
+        case 7: return (void*)TIM7_BASE;
+        case 8: return (void*)TIM8_BASE;
         //... add other timers as needed
         default: return NULL;
     }
@@ -18,6 +18,18 @@ typedef struct {
     void (*disable_update_irq)(struct timer_handle_t* handle);
     bool (*is_update_irq_flag_set)(struct timer_handle_t* handle);
     void (*clear_update_irq_flag)(struct timer_handle_t* handle);
+    void (*enable_update_dma)(struct timer_handle_t* handle);
+    void (*disable_update_dma)(struct timer_handle_t* handle);
+    void (*configure_input_capture)(struct timer_handle_t* handle, uint8_t channel, const timer_ic_config_t* config);
+    void (*disable_input_capture)(struct timer_handle_t* handle, uint8_t channel);
+    void (*set_capture_dma)(struct timer_handle_t* handle, uint8_t channel, bool enable);
+    const void* (*get_capture_register)(struct timer_handle_t* handle, uint8_t channel);
+    uint32_t (*get_and_clear_overcapture)(struct timer_handle_t* handle);
+    void (*set_clock_source)(struct timer_handle_t* handle, const timer_clock_config_t* config);
+    void (*set_trigger_dma)(struct timer_handle_t* handle, bool enable);
+    void (*set_gated_clock)(struct timer_handle_t* handle, const timer_clock_config_t* gate);
+    void (*configure_encoder)(struct timer_handle_t* handle, const timer_encoder_config_t* config);
+    void (*set_trigger_output)(struct timer_handle_t* handle, timer_trigger_output_t output);
 } timer_port_interface_t;
 
 /* --- Functions to be provided by the concrete port implementation --- */
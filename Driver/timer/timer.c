@@ -7,8 +7,8 @@
 #include <string.h>
 
 // --- Static Data ---
-static struct timer_handle_t s_handle_pool;
-static bool s_is_handle_in_use = {false};
+static struct timer_handle_t s_handle_pool[TIMER_MAX_INSTANCES];
+static bool s_is_handle_in_use[TIMER_MAX_INSTANCES] = {false};
 
 // --- Private Helper Functions ---
 static struct timer_handle_t* allocate_handle(void) {
@@ -46,9 +46,7 @@ timer_handle_t timer_init(uint8_t instance_num, const timer_config_t* config) {
     *(const timer_port_interface_t**)&handle->port_api = timer_port_get_api();
     *(void**)&handle->port_hw_instance = timer_port_get_base_addr(instance_num);
 
-    if (handle->port_api == NULL |
-
-| handle->port_hw_instance == NULL) {
+    if (handle->port_api == NULL || handle->port_hw_instance == NULL) {
         release_handle(handle);
         return NULL;
     }
@@ -114,3 +112,97 @@ void timer_clear_update_interrupt_flag(timer_handle_t handle) {
         handle->port_api->clear_update_irq_flag(handle);
     }
 }
+
+void timer_enable_update_dma_request(timer_handle_t handle) {
+    if (handle && handle->context.is_initialized) {
+        handle->port_api->enable_update_dma(handle);
+    }
+}
+
+void timer_disable_update_dma_request(timer_handle_t handle) {
+    if (handle && handle->context.is_initialized) {
+        handle->port_api->disable_update_dma(handle);
+    }
+}
+
+int timer_configure_input_capture(timer_handle_t handle, uint8_t channel, const timer_ic_config_t* config) {
+    if (handle == NULL || !handle->context.is_initialized || config == NULL ||
+        channel < 1 || channel > TIMER_CHANNEL_COUNT || config->filter > 15) {
+        return -1; // Invalid arguments
+    }
+    handle->port_api->configure_input_capture(handle, channel, config);
+    return 0;
+}
+
+int timer_disable_input_capture(timer_handle_t handle, uint8_t channel) {
+    if (handle == NULL || !handle->context.is_initialized || channel < 1 || channel > TIMER_CHANNEL_COUNT) {
+        return -1; // Invalid arguments
+    }
+    handle->port_api->disable_input_capture(handle, channel);
+    return 0;
+}
+
+int timer_set_capture_dma_request(timer_handle_t handle, uint8_t channel, bool enable) {
+    if (handle == NULL || !handle->context.is_initialized || channel < 1 || channel > TIMER_CHANNEL_COUNT) {
+        return -1; // Invalid arguments
+    }
+    handle->port_api->set_capture_dma(handle, channel, enable);
+    return 0;
+}
+
+const void* timer_get_capture_register(timer_handle_t handle, uint8_t channel) {
+    if (handle == NULL || !handle->context.is_initialized || channel < 1 || channel > TIMER_CHANNEL_COUNT) {
+        return NULL;
+    }
+    return handle->port_api->get_capture_register(handle, channel);
+}
+
+uint32_t timer_get_and_clear_overcapture(timer_handle_t handle) {
+    if (handle && handle->context.is_initialized) {
+        return handle->port_api->get_and_clear_overcapture(handle);
+    }
+    return 0;
+}
+
+int timer_set_clock_source(timer_handle_t handle, const timer_clock_config_t* config) {
+    if (handle == NULL || !handle->context.is_initialized || config == NULL || config->filter > 15 ||
+        (config->source == TIMER_CLOCK_ETR && config->polarity == TIMER_IC_POLARITY_BOTH)) {
+        return -1; // Invalid arguments
+    }
+    handle->port_api->set_clock_source(handle, config);
+    return 0;
+}
+
+int timer_set_trigger_dma_request(timer_handle_t handle, bool enable) {
+    if (handle == NULL || !handle->context.is_initialized) {
+        return -1; // Invalid arguments
+    }
+    handle->port_api->set_trigger_dma(handle, enable);
+    return 0;
+}
+
+int timer_set_gated_clock(timer_handle_t handle, const timer_clock_config_t* gate) {
+    if (handle == NULL || !handle->context.is_initialized || gate == NULL || gate->filter > 15 ||
+        gate->source == TIMER_CLOCK_INTERNAL || gate->polarity == TIMER_IC_POLARITY_BOTH) {
+        return -1; // Invalid arguments
+    }
+    handle->port_api->set_gated_clock(handle, gate);
+    return 0;
+}
+
+int timer_configure_encoder(timer_handle_t handle, const timer_encoder_config_t* config) {
+    if (handle == NULL || !handle->context.is_initialized || config == NULL || config->filter > 15 ||
+        config->mode < TIMER_ENCODER_TI1 || config->mode > TIMER_ENCODER_TI12) {
+        return -1; // Invalid arguments
+    }
+    handle->port_api->configure_encoder(handle, config);
+    return 0;
+}
+
+int timer_set_trigger_output(timer_handle_t handle, timer_trigger_output_t output) {
+    if (handle == NULL || !handle->context.is_initialized || output > TIMER_TRGO_UPDATE) {
+        return -1; // Invalid arguments
+    }
+    handle->port_api->set_trigger_output(handle, output);
+    return 0;
+}
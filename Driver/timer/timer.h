@@ -35,6 +35,74 @@ typedef struct {
     uint32_t period;    // 16-bit or 32-bit auto-reload value
 } timer_config_t;
 
+/** @brief Number of capture/compare channels per timer. */
+#define TIMER_CHANNEL_COUNT 4
+
+/** @brief Edge(s) latched by an input-capture channel. */
+typedef enum {
+    TIMER_IC_POLARITY_RISING = 0,   //!< Capture on rising edges.
+    TIMER_IC_POLARITY_FALLING,      //!< Capture on falling edges.
+    TIMER_IC_POLARITY_BOTH,         //!< Capture on both edges.
+} timer_ic_polarity_t;
+
+/**
+ * @brief Configuration of one input-capture channel.
+ * @details The channel captures its own input pin (TIx) into its CCR on
+ *          every selected edge, with no input prescaler.
+ */
+typedef struct {
+    timer_ic_polarity_t polarity;
+    uint8_t filter;     // Digital input filter, 0 (off) to 15 (ICxF field)
+} timer_ic_config_t;
+
+/** @brief What drives the counter. */
+typedef enum {
+    TIMER_CLOCK_INTERNAL = 0,   //!< Timer kernel clock (default).
+    TIMER_CLOCK_TI1,            //!< Edges on channel 1's input pin.
+    TIMER_CLOCK_TI2,            //!< Edges on channel 2's input pin.
+    TIMER_CLOCK_ETR,            //!< Edges on the external trigger (ETR) pin.
+} timer_clock_source_t;
+
+/**
+ * @brief Counter clock selection.
+ * @details External sources run the slave mode controller in external clock
+ *          mode 1, so every counted edge is also a trigger event (see
+ *          timer_set_trigger_dma_request()). The counter clock is then no
+ *          longer divided from the kernel clock, but the prescaler still
+ *          applies.
+ */
+typedef struct {
+    timer_clock_source_t source;
+    timer_ic_polarity_t polarity;   // Edge(s) counted; ETR cannot count both
+    uint8_t filter;                 // Digital input filter, 0 (off) to 15
+} timer_clock_config_t;
+
+/** @brief Encoder interface edge selection, as the SMS field value. */
+typedef enum {
+    TIMER_ENCODER_TI1 = 1,      //!< Encoder mode 1: count edges of TI1 only (x2), direction from TI2.
+    TIMER_ENCODER_TI2,          //!< Encoder mode 2: count edges of TI2 only (x2), direction from TI1.
+    TIMER_ENCODER_TI12,         //!< Encoder mode 3: count edges of both inputs (x4).
+} timer_encoder_mode_t;
+
+/**
+ * @brief Quadrature encoder interface settings.
+ * @details Channels 1 and 2 take the A and B lines; the counter then moves up
+ *          or down with the encoder and wraps at the configured period.
+ */
+typedef struct {
+    timer_encoder_mode_t mode;
+    bool invert_ti1;            // Swap the sense of the A line
+    bool invert_ti2;            // Swap the sense of the B line
+    uint8_t filter;             // Digital input filter for both lines, 0 (off) to 15
+} timer_encoder_config_t;
+
+/** @brief Event the timer drives onto its trigger output (TRGO) for other peripherals. */
+typedef enum {
+    TIMER_TRGO_RESET = 0,       //!< Counter reset (default).
+    TIMER_TRGO_ENABLE,          //!< Counter enable.
+    TIMER_TRGO_UPDATE,          //!< Update event, once per period.
+} timer_trigger_output_t;
+
 /* --- Public API Functions --- */
 
 /**
@@ -86,6 +154,20 @@ void timer_enable_update_interrupt(timer_handle_t handle);
  */
 void timer_disable_update_interrupt(timer_handle_t handle);
 
+/**
+ * @brief Enables the DMA request on the timer update event.
+ * @details Each update (counter overflow) then triggers one transfer on the
+ *          DMA stream/channel mapped to this timer's UP request.
+ * @param[in] handle The handle to the timer instance.
+ */
+void timer_enable_update_dma_request(timer_handle_t handle);
+
+/**
+ * @brief Disables the DMA request on the timer update event.
+ * @param[in] handle The handle to the timer instance.
+ */
+void timer_disable_update_dma_request(timer_handle_t handle);
+
 /**
  * @brief Clears the update interrupt flag.
  * @details This function should be called inside the timer's interrupt service
@@ -101,4 +183,97 @@ bool timer_is_update_interrupt_flag_set(timer_handle_t handle);
  */
 void timer_clear_update_interrupt_flag(timer_handle_t handle);
 
+/**
+ * @brief Configures a channel for input capture and enables it.
+ * @param[in] handle The handle to the timer instance.
+ * @param[in] channel Channel number, 1 to TIMER_CHANNEL_COUNT.
+ * @param[in] config Polarity and filter settings.
+ * @return 0 on success, or a negative error code on failure.
+ */
+int timer_configure_input_capture(timer_handle_t handle, uint8_t channel, const timer_ic_config_t* config);
+
+/**
+ * @brief Disables capture on a channel.
+ * @param[in] handle The handle to the timer instance.
+ * @param[in] channel Channel number, 1 to TIMER_CHANNEL_COUNT.
+ * @return 0 on success, or a negative error code on failure.
+ */
+int timer_disable_input_capture(timer_handle_t handle, uint8_t channel);
+
+/**
+ * @brief Enables or disables the DMA request raised by each capture on a channel.
+ * @details The stream serving the request should read
+ *          timer_get_capture_register(); the read also clears the capture flag.
+ * @param[in] handle The handle to the timer instance.
+ * @param[in] channel Channel number, 1 to TIMER_CHANNEL_COUNT.
+ * @param[in] enable true to raise DMA requests, false to stop them.
+ * @return 0 on success, or a negative error code on failure.
+ */
+int timer_set_capture_dma_request(timer_handle_t handle, uint8_t channel, bool enable);
+
+/**
+ * @brief Gets the address of a channel's capture register, for use as a DMA source.
+ * @param[in] handle The handle to the timer instance.
+ * @param[in] channel Channel number, 1 to TIMER_CHANNEL_COUNT.
+ * @return The register address, or NULL for invalid arguments.
+ */
+const void* timer_get_capture_register(timer_handle_t handle, uint8_t channel);
+
+/**
+ * @brief Reads and clears the over-capture flags.
+ * @details A channel's flag is set when a capture happened before the
+ *          previous one was read, i.e. an edge was lost.
+ * @param[in] handle The handle to the timer instance.
+ * @return Bit (channel - 1) set for each channel that lost a capture.
+ */
+uint32_t timer_get_and_clear_overcapture(timer_handle_t handle);
+
+/**
+ * @brief Selects the counter clock.
+ * @details For TI1/TI2 this also configures channel 1/2 as an input with
+ *          the given polarity and filter.
+ * @param[in] handle The handle to the timer instance.
+ * @param[in] config Clock source settings.
+ * @return 0 on success, or a negative error code on failure.
+ */
+int timer_set_clock_source(timer_handle_t handle, const timer_clock_config_t* config);
+
+/**
+ * @brief Enables or disables the DMA request raised on each trigger event.
+ * @details With an external clock source, this is one request per counted edge.
+ * @param[in] handle The handle to the timer instance.
+ * @param[in] enable true to raise DMA requests, false to stop them.
+ * @return 0 on success, or a negative error code on failure.
+ */
+int timer_set_trigger_dma_request(timer_handle_t handle, bool enable);
+
+/**
+ * @brief Counts the kernel clock only while a gate input is at its active level.
+ * @details Replaces any external clock source (see timer_set_clock_source()).
+ *          A rising polarity makes the gate active high, falling makes it
+ *          active low.
+ * @param[in] handle The handle to the timer instance.
+ * @param[in] gate Gate input (TI1, TI2 or ETR), its polarity and filter.
+ * @return 0 on success, or a negative error code on failure.
+ */
+int timer_set_gated_clock(timer_handle_t handle, const timer_clock_config_t* gate);
+
+/**
+ * @brief Clocks the counter from a quadrature encoder on channels 1 and 2.
+ * @details Replaces any clock source or gate set before.
+ * @param[in] handle The handle to the timer instance.
+ * @param[in] config Encoder interface settings.
+ * @return 0 on success, or a negative error code on failure.
+ */
+int timer_configure_encoder(timer_handle_t handle, const timer_encoder_config_t* config);
+
+/**
+ * @brief Selects the event signalled on the timer's trigger output (TRGO).
+ * @details Lets the timer pace other peripherals, such as ADC conversions.
+ * @param[in] handle The handle to the timer instance.
+ * @param[in] output Event to signal.
+ * @return 0 on success, or a negative error code on failure.
+ */
+int timer_set_trigger_output(timer_handle_t handle, timer_trigger_output_t output);
+
 #endif // TIMER_H
@@ -9,6 +9,6 @@
 /**
  * @brief Defines the maximum number of timer instances the driver can manage.
  */
-#define TIMER_MAX_INSTANCES 4
+#define TIMER_MAX_INSTANCES 6
 
 #endif // TIMER_CONFIG_H
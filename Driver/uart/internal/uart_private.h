@@ -27,8 +27,19 @@ typedef struct {
 struct uart_handle_t {
     const uart_config_t config;           // User-provided configuration (read-only)
     uart_context_t context;               // Mutable runtime state
+    uint8_t instance_num;                 // Hardware instance (e.g., 1 for USART1)
     const uart_port_interface_t* port_api; // Pointer to hardware porting functions
     void* port_hw_instance;               // Pointer to peripheral registers (e.g., USART1)
 };
 
+/**
+ * @brief Resolves a per-byte port operation, either at compile time or via the handle.
+ */
+#if UART_PORT_STATIC
+#include UART_PORT_INLINE_HEADER
+#define UART_PORT_CALL(handle, fn)  UART_PORT_INLINE_##fn
+#else
+#define UART_PORT_CALL(handle, fn)  ((handle)->port_api->fn)
+#endif
+
 #endif // UART_PRIVATE_H
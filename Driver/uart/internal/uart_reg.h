@@ -64,6 +64,10 @@ typedef struct {
 #define USART_CR1_PCE_Msk   (1UL << USART_CR1_PCE_Pos)
 #define USART_CR1_PS_Pos    (9U)
 #define USART_CR1_PS_Msk    (1UL << USART_CR1_PS_Pos)
+#define USART_CR1_PEIE_Pos  (8U)
+#define USART_CR1_PEIE_Msk  (1UL << USART_CR1_PEIE_Pos)
+#define USART_CR1_IDLEIE_Pos (4U)
+#define USART_CR1_IDLEIE_Msk (1UL << USART_CR1_IDLEIE_Pos)
 #define USART_CR1_TE_Pos    (3U)
 #define USART_CR1_TE_Msk    (1UL << USART_CR1_TE_Pos)
 #define USART_CR1_RE_Pos    (2U)
@@ -78,5 +82,9 @@ typedef struct {
 #define USART_CR3_CTSE_Msk (1UL << USART_CR3_CTSE_Pos)
 #define USART_CR3_RTSE_Pos (8U)
 #define USART_CR3_RTSE_Msk (1UL << USART_CR3_RTSE_Pos)
+#define USART_CR3_DMAR_Pos (6U)
+#define USART_CR3_DMAR_Msk (1UL << USART_CR3_DMAR_Pos)
+#define USART_CR3_EIE_Pos  (0U)
+#define USART_CR3_EIE_Msk  (1UL << USART_CR3_EIE_Pos)
 
 #endif // UART_REG_H
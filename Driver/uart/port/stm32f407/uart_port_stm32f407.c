@@ -5,6 +5,8 @@
 
 #include "internal/uart_private.h"
 #include "internal/uart_reg.h"
+#include "uart_port_stm32f407_inline.h"
+#include "system_clock.h"
 
 // These would typically be in a separate, higher-level MCU header
 #define PERIPH_BASE           0x40000000UL
@@ -13,6 +15,13 @@
 #define USART1_BASE           (APB2PERIPH_BASE + 0x1000UL)
 #define USART2_BASE           (APB1PERIPH_BASE + 0x4400UL)
 #define USART6_BASE           (APB2PERIPH_BASE + 0x1400UL)
+#define RCC_BASE              (PERIPH_BASE + 0x00023800UL)
+
+#define RCC_APB1ENR           (*(volatile uint32_t*)(RCC_BASE + 0x40UL))
+#define RCC_APB2ENR           (*(volatile uint32_t*)(RCC_BASE + 0x44UL))
+#define RCC_APB1ENR_USART2EN  (1UL << 17)
+#define RCC_APB2ENR_USART1EN  (1UL << 4)
+#define RCC_APB2ENR_USART6EN  (1UL << 5)
 
 // --- Private function implementations for STM32F4 ---
 
@@ -26,16 +35,47 @@ static void stm32f4_disable(struct uart_handle_t* handle) {
     uart_regs->CR1 &= ~USART_CR1_UE_Msk;
 }
 
-static void stm32f4_write_byte_blocking(struct uart_handle_t* handle, uint8_t byte) {
+static void stm32f4_set_rx_dma(struct uart_handle_t* handle, bool enable) {
+    uart_reg_map_t* uart_regs = (uart_reg_map_t*)handle->port_hw_instance;
+    if (enable) {
+        uart_regs->CR3 |= USART_CR3_DMAR_Msk;
+    } else {
+        uart_regs->CR3 &= ~USART_CR3_DMAR_Msk;
+    }
+}
+
+static const void* stm32f4_get_data_register(struct uart_handle_t* handle) {
     uart_reg_map_t* uart_regs = (uart_reg_map_t*)handle->port_hw_instance;
-    while (!(uart_regs->SR & USART_SR_TXE_Msk));
-    uart_regs->DR = byte;
+    return (const void*)&uart_regs->DR;
 }
 
-static uint8_t stm32f4_read_byte_blocking(struct uart_handle_t* handle) {
+static void stm32f4_set_rx_event_interrupts(struct uart_handle_t* handle, bool enable) {
     uart_reg_map_t* uart_regs = (uart_reg_map_t*)handle->port_hw_instance;
-    while (!(uart_regs->SR & USART_SR_RXNE_Msk));
-    return (uint8_t)(uart_regs->DR & 0xFF);
+    if (enable) {
+        uart_regs->CR1 |= USART_CR1_PEIE_Msk | USART_CR1_IDLEIE_Msk;
+        uart_regs->CR3 |= USART_CR3_EIE_Msk;
+    } else {
+        uart_regs->CR1 &= ~(USART_CR1_PEIE_Msk | USART_CR1_IDLEIE_Msk);
+        uart_regs->CR3 &= ~USART_CR3_EIE_Msk;
+    }
+}
+
+static uint32_t stm32f4_get_and_clear_rx_events(struct uart_handle_t* handle) {
+    uart_reg_map_t* uart_regs = (uart_reg_map_t*)handle->port_hw_instance;
+    uint32_t sr = uart_regs->SR;
+    uint32_t events = 0;
+
+    if (sr & USART_SR_PE_Msk)   { events |= UART_RX_EVENT_PARITY_ERROR; }
+    if (sr & USART_SR_FE_Msk)   { events |= UART_RX_EVENT_FRAMING_ERROR; }
+    if (sr & USART_SR_NE_Msk)   { events |= UART_RX_EVENT_NOISE; }
+    if (sr & USART_SR_ORE_Msk)  { events |= UART_RX_EVENT_OVERRUN; }
+    if (sr & USART_SR_IDLE_Msk) { events |= UART_RX_EVENT_IDLE; }
+
+    // PE, FE, NE, ORE and IDLE are cleared by reading SR followed by DR
+    if (events) {
+        (void)uart_regs->DR;
+    }
+    return events;
 }
 
 static void stm32f4_configure_core(struct uart_handle_t* handle) {
@@ -73,9 +113,15 @@ static void stm32f4_configure_core(struct uart_handle_t* handle) {
         default: break;
     }
 
-    // Baud Rate
-    uint32_t clock_freq = uart_port_get_clock_freq(1); // Assuming instance 1 for now
-    uart_regs->BRR = (clock_freq + (config->baud_rate / 2)) / config->baud_rate;
+    // Baud Rate: 16x oversampling, or 8x when the rate is beyond clock / 16
+    uint32_t clock_freq = uart_port_get_clock_freq(handle->instance_num);
+    if (config->baud_rate * 16U > clock_freq) {
+        uint32_t usartdiv = ((2U * clock_freq) + (config->baud_rate / 2)) / config->baud_rate;
+        cr1 |= USART_CR1_OVER8_Msk;
+        uart_regs->BRR = (usartdiv & 0xFFF0U) | ((usartdiv & 0x000FU) >> 1);
+    } else {
+        uart_regs->BRR = (clock_freq + (config->baud_rate / 2)) / config->baud_rate;
+    }
 
     // Apply configuration
     uart_regs->CR1 = cr1 | USART_CR1_TE_Msk | USART_CR1_RE_Msk;
@@ -84,13 +130,21 @@ static void stm32f4_configure_core(struct uart_handle_t* handle) {
 }
 
 static void stm32f4_enable_clock(struct uart_handle_t* handle) {
-    // NOTE: This is a placeholder. A real implementation would use the RCC
-    // peripheral driver to enable the clock for the specific USART instance.
-    // For example: rcc_periph_clock_enable(RCC_USART1);
+    switch (handle->instance_num) {
+        case 1: RCC_APB2ENR |= RCC_APB2ENR_USART1EN; (void)RCC_APB2ENR; break;
+        case 2: RCC_APB1ENR |= RCC_APB1ENR_USART2EN; (void)RCC_APB1ENR; break;
+        case 6: RCC_APB2ENR |= RCC_APB2ENR_USART6EN; (void)RCC_APB2ENR; break;
+        default: break;
+    }
 }
 
 static void stm32f4_disable_clock(struct uart_handle_t* handle) {
-    // Placeholder for RCC clock disable
+    switch (handle->instance_num) {
+        case 1: RCC_APB2ENR &= ~RCC_APB2ENR_USART1EN; break;
+        case 2: RCC_APB1ENR &= ~RCC_APB1ENR_USART2EN; break;
+        case 6: RCC_APB2ENR &= ~RCC_APB2ENR_USART6EN; break;
+        default: break;
+    }
 }
 
 static void stm32f4_init_pins(struct uart_handle_t* handle) {
@@ -108,6 +162,10 @@ static const uart_port_interface_t stm32f4_port_api = {
    .read_byte_blocking = stm32f4_read_byte_blocking,
    .enable = stm32f4_enable,
    .disable = stm32f4_disable,
+   .set_rx_dma = stm32f4_set_rx_dma,
+   .get_data_register = stm32f4_get_data_register,
+   .set_rx_event_interrupts = stm32f4_set_rx_event_interrupts,
+   .get_and_clear_rx_events = stm32f4_get_and_clear_rx_events,
 };
 
 // --- Public functions provided by the port ---
@@ -131,14 +189,10 @@ void* uart_port_get_base_addr_for_instance(uint8_t instance_num) {
 }
 
 uint32_t uart_port_get_clock_freq(uint8_t instance_num) {
-    // NOTE: Placeholder. A real implementation would query the RCC driver
-    // to get the actual peripheral clock frequency.
-    // Assuming APB2 clock is 84MHz for USART1/6 and APB1 is 42MHz for USART2
-    if (instance_num == 1 |
-
-| instance_num == 6) {
-        return 84000000;
+    // USART1/6 are on APB2, USART2 on APB1
+    if (instance_num == 1 || instance_num == 6) {
+        return SYSTEM_CLOCK_APB2_HZ;
     } else {
-        return 42000000;
+        return SYSTEM_CLOCK_APB1_HZ;
     }
 }
@@ -0,0 +1,30 @@
+/**
+ * @file      uart_port_stm32f407_inline.h
+ * @brief     Hot-path STM32F4xx USART port operations as static inline functions.
+ * @note      Shared by the port's function table and, when UART_PORT_STATIC is
+ *            enabled, called directly by uart.c so the per-byte loops inline.
+ */
+
+#ifndef UART_PORT_STM32F407_INLINE_H
+#define UART_PORT_STM32F407_INLINE_H
+
+#include "internal/uart_private.h"
+#include "internal/uart_reg.h"
+
+static inline void stm32f4_write_byte_blocking(struct uart_handle_t* handle, uint8_t byte) {
+    uart_reg_map_t* uart_regs = (uart_reg_map_t*)handle->port_hw_instance;
+    while (!(uart_regs->SR & USART_SR_TXE_Msk));
+    uart_regs->DR = byte;
+}
+
+static inline uint8_t stm32f4_read_byte_blocking(struct uart_handle_t* handle) {
+    uart_reg_map_t* uart_regs = (uart_reg_map_t*)handle->port_hw_instance;
+    while (!(uart_regs->SR & USART_SR_RXNE_Msk));
+    return (uint8_t)(uart_regs->DR & 0xFF);
+}
+
+// --- Compile-time bindings used by uart.c when UART_PORT_STATIC is enabled ---
+#define UART_PORT_INLINE_write_byte_blocking    stm32f4_write_byte_blocking
+#define UART_PORT_INLINE_read_byte_blocking     stm32f4_read_byte_blocking
+
+#endif // UART_PORT_STM32F407_INLINE_H
@@ -22,6 +22,10 @@ typedef struct {
     uint8_t (*read_byte_blocking)(struct uart_handle_t* handle);
     void (*enable)(struct uart_handle_t* handle);
     void (*disable)(struct uart_handle_t* handle);
+    void (*set_rx_dma)(struct uart_handle_t* handle, bool enable);
+    const void* (*get_data_register)(struct uart_handle_t* handle);
+    void (*set_rx_event_interrupts)(struct uart_handle_t* handle, bool enable);
+    uint32_t (*get_and_clear_rx_events)(struct uart_handle_t* handle);
 } uart_port_interface_t;
 
 /* --- Functions to be provided by the concrete port implementation --- */
@@ -56,6 +56,7 @@ uart_handle_t uart_init(uint8_t instance_num, const uart_config_t* config) {
     }
 
     // Get the platform-specific implementation details
+    handle->instance_num = instance_num;
     handle->port_api = uart_port_get_api_for_instance(instance_num);
     handle->port_hw_instance = uart_port_get_base_addr_for_instance(instance_num);
 
@@ -101,7 +102,7 @@ int uart_write_blocking(uart_handle_t handle, const uint8_t* p_data, size_t len)
     }
 
     for (size_t i = 0; i < len; ++i) {
-        handle->port_api->write_byte_blocking(handle, p_data[i]);
+        UART_PORT_CALL(handle, write_byte_blocking)(handle, p_data[i]);
     }
 
     return 0;
@@ -113,8 +114,38 @@ int uart_read_blocking(uart_handle_t handle, uint8_t* p_data, size_t len) {
     }
 
     for (size_t i = 0; i < len; ++i) {
-        p_data[i] = handle->port_api->read_byte_blocking(handle);
+        p_data[i] = UART_PORT_CALL(handle, read_byte_blocking)(handle);
     }
 
     return 0;
 }
+
+int uart_set_rx_dma(uart_handle_t handle, bool enable) {
+    if (handle == NULL || !handle->context.is_initialized) {
+        return -1; // Invalid arguments
+    }
+    handle->port_api->set_rx_dma(handle, enable);
+    return 0;
+}
+
+const void* uart_get_data_register(uart_handle_t handle) {
+    if (handle == NULL || !handle->context.is_initialized) {
+        return NULL;
+    }
+    return handle->port_api->get_data_register(handle);
+}
+
+int uart_set_rx_event_interrupts(uart_handle_t handle, bool enable) {
+    if (handle == NULL || !handle->context.is_initialized) {
+        return -1; // Invalid arguments
+    }
+    handle->port_api->set_rx_event_interrupts(handle, enable);
+    return 0;
+}
+
+uint32_t uart_get_and_clear_rx_events(uart_handle_t handle) {
+    if (handle == NULL || !handle->context.is_initialized) {
+        return 0;
+    }
+    return handle->port_api->get_and_clear_rx_events(handle);
+}
@@ -51,6 +51,18 @@ typedef enum {
     UART_FLOW_CONTROL_RTS_CTS,  //!< RTS and CTS.
 } uart_flow_control_t;
 
+/**
+ * @brief Receive-side events reported by uart_get_and_clear_rx_events().
+ * @details Values are bit flags and may be combined.
+ */
+typedef enum {
+    UART_RX_EVENT_PARITY_ERROR  = (1 << 0), //!< Parity check failed.
+    UART_RX_EVENT_FRAMING_ERROR = (1 << 1), //!< Stop bit missing (also raised by a break).
+    UART_RX_EVENT_NOISE         = (1 << 2), //!< Noise detected while sampling a bit.
+    UART_RX_EVENT_OVERRUN       = (1 << 3), //!< A byte arrived before the previous one was read.
+    UART_RX_EVENT_IDLE          = (1 << 4), //!< The line went idle for one frame after data.
+} uart_rx_event_t;
+
 /**
  * @brief Configuration structure for UART initialization.
  * @details This structure is passed to uart_init() to configure a
@@ -124,4 +136,48 @@ int uart_write_blocking(uart_handle_t handle, const uint8_t* p_data, size_t len)
  */
 int uart_read_blocking(uart_handle_t handle, uint8_t* p_data, size_t len);
 
+/**
+ * @brief Enables or disables DMA requests for received data.
+ *
+ * @details With RX DMA enabled, each received byte raises a DMA request
+ *          that should be served by a stream reading uart_get_data_register().
+ *
+ * @param[in] handle The handle to the UART instance.
+ * @param[in] enable true to raise RX DMA requests, false to stop them.
+ *
+ * @return 0 on success, or a negative error code on failure.
+ */
+int uart_set_rx_dma(uart_handle_t handle, bool enable);
+
+/**
+ * @brief Gets the address of the data register, for use as a DMA source.
+ * @param[in] handle The handle to the UART instance.
+ * @return The data register address, or NULL for an invalid handle.
+ */
+const void* uart_get_data_register(uart_handle_t handle);
+
+/**
+ * @brief Enables or disables the peripheral interrupt for receive errors and line idle.
+ * @note The application provides the USARTx interrupt handler and enables
+ *       it in the NVIC; the handler should call uart_get_and_clear_rx_events().
+ *
+ * @param[in] handle The handle to the UART instance.
+ * @param[in] enable true to raise the interrupt on any uart_rx_event_t.
+ *
+ * @return 0 on success, or a negative error code on failure.
+ */
+int uart_set_rx_event_interrupts(uart_handle_t handle, bool enable);
+
+/**
+ * @brief Reads and clears the pending receive events.
+ *
+ * @details Clearing requires a data register read. When RX DMA is enabled
+ *          the DMA has normally already taken the byte, so the read only
+ *          discards a byte if the handler runs more than one frame late.
+ *
+ * @param[in] handle The handle to the UART instance.
+ * @return A bitmask of uart_rx_event_t flags, or 0 for an invalid handle.
+ */
+uint32_t uart_get_and_clear_rx_events(uart_handle_t handle);
+
 #endif // UART_H
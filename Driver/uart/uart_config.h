@@ -0,0 +1,33 @@
+/**
+ * @file      uart_config.h
+ * @brief     Compile-time configuration for the UART driver.
+ */
+
+#ifndef UART_CONFIG_H
+#define UART_CONFIG_H
+
+/**
+ * @brief Defines the maximum number of UART instances the driver can manage.
+ * @details This sets the size of the static handle pool. Adjust based on
+ *          the number of UART peripherals you intend to use simultaneously.
+ */
+#define UART_MAX_INSTANCES 3
+
+/**
+ * @brief Selects compile-time binding of the port for the per-byte transfer loops.
+ * @details When 1, uart_write_blocking() and uart_read_blocking() call the
+ *          static inline port functions from UART_PORT_INLINE_HEADER directly
+ *          instead of making an indirect call per byte. All instances then
+ *          share one port. Leave at 0 for ports that only provide the function
+ *          table (e.g. a host-test port).
+ */
+#ifndef UART_PORT_STATIC
+#define UART_PORT_STATIC 0
+#endif
+
+/**
+ * @brief Port header providing the inline per-byte functions.
+ */
+#define UART_PORT_INLINE_HEADER "port/stm32f407/uart_port_stm32f407_inline.h"
+
+#endif // UART_CONFIG_H
@@ -0,0 +1,119 @@
+/**
+ * @file      analog_capture.h
+ * @brief     ADC scan capture interleaved with the digital edge stream.
+ *
+ * @details   ADC1 scans up to four inputs on every TIM8 update event and
+ *            DMA2 Stream4 copies each result into a 16-bit ring in the last
+ *            arena segment, which the digital front-ends leave free. TIM8
+ *            runs on the APB2 timer clock, which equals the capture
+ *            timebase, so the trigger time of every scan follows from its
+ *            index alone and needs no per-sample interrupt.
+ *
+ *            The mode has no poller of its own: SPI_SAMPLE and TIMER_CAPTURE
+ *            merge the scans into the edge stream in time order with their
+ *            own edges, as records flagged EDGE_FLAG_ANALOG. Each input of a
+ *            scan becomes one record, [t,input,reading,2], with t the scan's
+ *            trigger time.
+ *
+ *            The ADC analog watchdog can guard one of the inputs and trigger
+ *            an armed edge stream (see edge_stream_arm()) on the first scan
+ *            that reads outside a voltage window, such as a supply droop.
+ *            The comparison runs in hardware on every scan, so waiting for
+ *            it costs no CPU time.
+ *
+ *            Wiring (signal -> analyzer, 0 to 3.3 V):
+ *              - Input 0 -> PC0 (ADC1_IN10)
+ *              - Input 1 -> PC1 (ADC1_IN11)
+ *              - Input 2 -> PC2 (ADC1_IN12)
+ *              - Input 3 -> PC3 (ADC1_IN13)
+ */
+
+#ifndef ANALOG_CAPTURE_H
+#define ANALOG_CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "adc.h"
+#include "system_clock.h"
+
+/** @brief Most analog inputs scanned together. */
+#define ANALOG_CAPTURE_MAX_CHANNELS     4U
+
+/** @brief Default scan rate in Hz. */
+#define ANALOG_CAPTURE_DEFAULT_RATE_HZ  1000U
+
+/** @brief Highest scan rate in Hz; faster scans could not be shipped anyway. */
+#define ANALOG_CAPTURE_MAX_RATE_HZ      20000U
+
+/** @brief ADC kernel clock (APB2 / 4, as set by the ADC port). */
+#define ANALOG_CAPTURE_ADC_HZ           (SYSTEM_CLOCK_APB2_HZ / 4UL)
+
+/** @brief Upper bound for the ring in samples. */
+#define ANALOG_CAPTURE_MAX_RING_SAMPLES 8192U
+
+/** @brief Smallest usable ring in samples. */
+#define ANALOG_CAPTURE_MIN_RING_SAMPLES 256U
+
+/** @brief NVIC priority of the ring and watchdog interrupts (FreeRTOS-safe). */
+#define ANALOG_CAPTURE_IRQ_PRIORITY     (6 << 4)
+
+/**
+ * @brief Starts scanning alongside a digital capture.
+ * @details Call after the digital front-end has started, so the edge stream
+ *          has already been reset.
+ *
+ * @param[in] config ADC resolution and the sample time of every input.
+ * @param[in] channel_count Inputs scanned, 1 to ANALOG_CAPTURE_MAX_CHANNELS.
+ * @param[in] rate_hz Scans per second, 1 to ANALOG_CAPTURE_MAX_RATE_HZ, and
+ *                    slow enough for one scan to convert within a period.
+ *
+ * @return 0 on success, -1 if already running or the arguments are invalid,
+ *         -2 if a peripheral could not be claimed.
+ */
+int analog_capture_start(const adc_config_t* config, uint8_t channel_count, uint32_t rate_hz);
+
+/**
+ * @brief Stops scanning and releases every peripheral claimed by the mode.
+ */
+void analog_capture_stop(void);
+
+/**
+ * @brief Triggers the edge stream when an input leaves a voltage window.
+ * @details The first scan that reads the input below `low_threshold` or
+ *          above `high_threshold` calls edge_stream_trigger() with the scan's
+ *          time, and the watchdog then turns itself off. Arm the edge stream
+ *          first. Stopping the capture disarms the watchdog.
+ *
+ * @param[in] input Scanned input to guard (0 to channel_count - 1).
+ * @param[in] low_threshold Lower bound on the 12-bit scale (0-4095).
+ * @param[in] high_threshold Upper bound on the 12-bit scale, at least `low_threshold`.
+ *
+ * @return 0 on success, -1 if not running, already armed or the arguments are invalid.
+ */
+int analog_capture_arm_watchdog(uint8_t input, uint16_t low_threshold, uint16_t high_threshold);
+
+/**
+ * @brief Gets the trigger time of the next scan to merge.
+ * @details The scan may still be converting. Scans the ring lost are skipped.
+ *
+ * @param[out] time Trigger time in capture timebase ticks.
+ *
+ * @return true if scanning is running, false otherwise.
+ */
+bool analog_capture_next_time(uint32_t* time);
+
+/**
+ * @brief Queues the next scan on the edge stream, one record per input.
+ * @details Must be called from task context.
+ *
+ * @return true if the scan was consumed (queued, or dropped because the DMA
+ *         overwrote it while it was read), false if it is still converting
+ *         or the edge stream has no room for it.
+ */
+bool analog_capture_push_next(void);
+
+/** @brief Returns the ring length in samples, or 0 when not running. */
+uint32_t analog_capture_get_ring_samples(void);
+
+#endif // ANALOG_CAPTURE_H
@@ -0,0 +1,67 @@
+/**
+ * @file      can_decoder.h
+ * @brief     CAN 2.0A/B frame decoder fed from the edge stream.
+ *
+ * @details   Decodes one CAN RX line (transceiver output, dominant low)
+ *            captured by SPI_SAMPLE or TIMER_CAPTURE. Each bit is sampled at
+ *            CAN_DECODER_SAMPLE_POINT_PCT of its time, with a hard
+ *            synchronisation on the start-of-frame edge and a soft one,
+ *            limited to CAN_DECODER_SJW_PCT of a bit, on every recessive to
+ *            dominant edge inside the frame. Stuff bits are removed and the
+ *            CRC-15 is checked on the device.
+ *
+ *            Only frames passing both the ID mask and the ID range are
+ *            reported, as
+ *            {"can":{"t":time,"id":n,"ext":0|1,"rtr":0|1,"dlc":n,"data":"hex"}},
+ *            with t the start-of-frame time in capture timebase ticks. A
+ *            frame is reported at its ACK delimiter, its last edge.
+ *
+ *            Every error is reported, whatever the filter, with the running
+ *            error counters of the capture:
+ *            {"can_error":{"t":time,"type":"stuff|crc|form|ack","stuff":n,"crc":n,"form":n,"ack":n}}.
+ *            The decoder then waits for 11 recessive bits before it looks
+ *            for the next frame.
+ */
+
+#ifndef CAN_DECODER_H
+#define CAN_DECODER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "edge_stream.h"
+
+/** @brief Bit rate used when none is given, in bit/s. */
+#define CAN_DECODER_DEFAULT_BITRATE     500000U
+
+/** @brief Sample point, in percent of the bit time. */
+#define CAN_DECODER_SAMPLE_POINT_PCT    75U
+
+/** @brief Largest phase correction per resynchronisation, in percent of the bit time. */
+#define CAN_DECODER_SJW_PCT             10U
+
+/** @brief Largest 29-bit identifier. */
+#define CAN_DECODER_MAX_ID              0x1FFFFFFFUL
+
+/** @brief Decoder settings. */
+typedef struct {
+    uint8_t channel;        // Edge-stream channel of the RX line
+    uint32_t bitrate;       // Nominal bit rate in bit/s
+    uint32_t id_mask;       // Identifier bits compared with id_match (0 = any)
+    uint32_t id_match;
+    uint32_t id_min;        // Inclusive identifier range
+    uint32_t id_max;
+} can_decoder_config_t;
+
+/** @brief The decoder, to pass to a capture front-end. */
+extern const edge_decoder_t can_decoder;
+
+/**
+ * @brief Sets up the decoder for the next capture.
+ * @note Call before the front-end starts; its reset clears the error counters.
+ * @param[in] config Decoder settings.
+ * @return 0 on success, -1 if the settings are invalid.
+ */
+int can_decoder_configure(const can_decoder_config_t* config);
+
+#endif // CAN_DECODER_H
@@ -0,0 +1,85 @@
+/**
+ * @file      capture_arena.h
+ * @brief     Capture-memory manager for the DMA sample buffers.
+ *
+ * @details   At boot the arena claims every byte of SRAM1/SRAM2 that the
+ *            linker left free between the newlib heap and the MSP stack
+ *            (see `_scapture_arena` / `_ecapture_arena` in the linker
+ *            scripts). The arena is then carved into a configurable number
+ *            of equally sized DMA segments: a few large segments give the
+ *            deepest one-shot capture, many small ones give the lowest
+ *            latency between a sample being taken and it being decoded.
+ */
+
+#ifndef CAPTURE_ARENA_H
+#define CAPTURE_ARENA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/** @brief Type of a single raw sample as written by the DMA (GPIOB IDR). */
+typedef uint16_t capture_sample_t;
+
+/** @brief Fewest segments the acquisition ISR can rotate through. */
+#define CAPTURE_ARENA_MIN_SEGMENTS      2
+
+/** @brief Most segments the arena can be split into. */
+#define CAPTURE_ARENA_MAX_SEGMENTS      32
+
+/** @brief Segment count for a deep one-shot capture ("memory": "deep"). */
+#define CAPTURE_ARENA_DEEP_SEGMENTS     CAPTURE_ARENA_MIN_SEGMENTS
+
+/** @brief Segment count for low-latency streaming ("memory": "stream"). */
+#define CAPTURE_ARENA_STREAM_SEGMENTS   16
+
+/**
+ * @brief Alignment (in bytes) of every segment base and length.
+ * @details 16 bytes keeps 4-beat word bursts from ever straddling a 1 KB
+ *          boundary, which the DMA controller does not allow.
+ */
+#define CAPTURE_ARENA_SEGMENT_ALIGN     16U
+
+/** @brief Largest segment a single DMA transfer can fill (16-bit NDTR). */
+#define CAPTURE_ARENA_MAX_SEGMENT_SAMPLES \
+    (0xFFFFU & ~((CAPTURE_ARENA_SEGMENT_ALIGN / sizeof(capture_sample_t)) - 1U))
+
+/**
+ * @brief Claims the free SRAM region reserved by the linker.
+ * @details Must be called once before any other arena function. The arena
+ *          starts out split into CAPTURE_ARENA_DEEP_SEGMENTS segments.
+ */
+void capture_arena_init(void);
+
+/**
+ * @brief Re-carves the arena into a new number of segments.
+ * @note Must not be called while a capture is running.
+ *
+ * @param[in] segment_count Number of segments
+ *                          (CAPTURE_ARENA_MIN_SEGMENTS..CAPTURE_ARENA_MAX_SEGMENTS).
+ *
+ * @return true on success, false if the count is out of range or the
+ *         arena is too small to give every segment at least one aligned block.
+ */
+bool capture_arena_configure(uint8_t segment_count);
+
+/**
+ * @brief Returns the base address of a segment.
+ * @param[in] index Segment index (0 to segment count - 1).
+ * @return Pointer to the first sample of the segment, or NULL if out of range.
+ */
+capture_sample_t* capture_arena_get_segment(uint8_t index);
+
+/** @brief Returns the current number of segments. */
+uint8_t capture_arena_get_segment_count(void);
+
+/** @brief Returns the number of samples held by each segment. */
+uint32_t capture_arena_get_segment_samples(void);
+
+/** @brief Returns the total capture depth in samples (all segments). */
+uint32_t capture_arena_get_depth(void);
+
+/** @brief Returns the size in bytes of the SRAM region claimed at boot. */
+size_t capture_arena_get_size_bytes(void);
+
+#endif // CAPTURE_ARENA_H
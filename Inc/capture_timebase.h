@@ -0,0 +1,39 @@
+/**
+ * @file      capture_timebase.h
+ * @brief     Common timestamp source for hardware-assisted capture modes.
+ *
+ * @details   Events captured outside the sampled GPIO stream (chip-select
+ *            edges, received UART chunks, ...) are stamped with the DWT cycle
+ *            counter, so all of them share one clock and can be lined up on
+ *            the host. Timestamps are 32-bit and wrap; the host unwraps them
+ *            using CAPTURE_TIMEBASE_HZ, which every mode reports as "tick_hz".
+ */
+
+#ifndef CAPTURE_TIMEBASE_H
+#define CAPTURE_TIMEBASE_H
+
+#include <stdint.h>
+
+#include "dwt.h"
+#include "system_clock.h"
+
+/** @brief Timestamp tick rate in Hz (CPU clock). */
+#define CAPTURE_TIMEBASE_HZ     SYSTEM_CLOCK_HZ
+
+/**
+ * @brief Starts the timestamp counter. Safe to call more than once.
+ */
+static inline void capture_timebase_init(void) {
+    if (!(DWT_CTRL & DWT_CTRL_CYCCNTENA)) {
+        dwt_enable_cycle_counter();
+    }
+}
+
+/**
+ * @brief Reads the current timestamp. Callable from any context.
+ */
+static inline uint32_t capture_timebase_now(void) {
+    return dwt_get_cycles();
+}
+
+#endif // CAPTURE_TIMEBASE_H
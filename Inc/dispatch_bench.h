@@ -0,0 +1,31 @@
+/**
+ * @file      dispatch_bench.h
+ * @brief     On-target cycle count of the driver hot-path calls.
+ *
+ * @details   Times the DMA calls an ISR makes for every transfer event
+ *            (flag test + clear, current buffer query) with the DWT cycle
+ *            counter and reports the average cost per call. The result
+ *            includes which port binding the driver was built with
+ *            (DMA_PORT_STATIC), so running it on a vtable build and on a
+ *            static build shows the cost of the indirect dispatch.
+ */
+
+#ifndef DISPATCH_BENCH_H
+#define DISPATCH_BENCH_H
+
+#include <stddef.h>
+
+/** @brief Number of calls timed per measurement. */
+#define DISPATCH_BENCH_ITERATIONS   1024U
+
+/**
+ * @brief Runs the measurements and formats the results.
+ * @note Borrows the capture benchmark's DMA stream, so it must only be run
+ *       while no capture is in progress.
+ *
+ * @param[out] json_buffer Buffer receiving the JSON result line.
+ * @param[in] json_buffer_size Size of the buffer in bytes.
+ */
+void dispatch_bench_run(char* json_buffer, size_t json_buffer_size);
+
+#endif // DISPATCH_BENCH_H
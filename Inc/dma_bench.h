@@ -0,0 +1,41 @@
+/**
+ * @file      dma_bench.h
+ * @brief     On-target throughput test for the GPIO-to-SRAM capture DMA.
+ *
+ * @details   For each DMA FIFO/burst/packing profile, the test paces a DMA2
+ *            stream from TIM8 update events at increasing rates and reads
+ *            GPIOB into the capture arena. A rate counts as stable when the
+ *            stream finishes without FIFO or transfer errors, and in the time
+ *            the timer needs to issue that many requests. If it takes longer,
+ *            some requests were dropped. The highest stable rate for each
+ *            profile is reported as JSON, with the number of reads per run.
+ */
+
+#ifndef DMA_BENCH_H
+#define DMA_BENCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "system_clock.h"
+
+/** @brief CPU (DWT cycle counter) clock in Hz. */
+#define DMA_BENCH_CPU_HZ            SYSTEM_CLOCK_HZ
+
+/** @brief TIM8 kernel clock in Hz (APB2 timer clock). */
+#define DMA_BENCH_TIMER_CLOCK_HZ    SYSTEM_CLOCK_APB2_TIMER_HZ
+
+/** @brief Number of peripheral reads per test run, at most one arena segment's samples. */
+#define DMA_BENCH_SAMPLES           4096U
+
+/**
+ * @brief Runs every profile at every test rate and formats the results.
+ * @note Uses the capture arena as the DMA target, so it must only be run
+ *       while no capture is in progress.
+ *
+ * @param[out] json_buffer Buffer receiving the JSON result line.
+ * @param[in] json_buffer_size Size of the buffer in bytes.
+ */
+void dma_bench_run(char* json_buffer, size_t json_buffer_size);
+
+#endif // DMA_BENCH_H
@@ -0,0 +1,67 @@
+/**
+ * @file      dma_memcpy.h
+ * @brief     Asynchronous memory-to-memory copy service on a dedicated DMA2 stream.
+ *
+ * @details   Bulk copies (capture data into output frames, staging buffers,
+ *            etc.) are queued here and executed by DMA2 Stream 7, the only
+ *            controller on the F407 that can do memory-to-memory transfers.
+ *            The CPU is free to keep decoding while a copy runs. Requests are
+ *            served in FIFO order. Copies larger than a single DMA transfer
+ *            are split into chunks transparently.
+ */
+
+#ifndef DMA_MEMCPY_H
+#define DMA_MEMCPY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/** @brief Maximum number of copies that can be pending at once. */
+#define DMA_MEMCPY_QUEUE_LENGTH     8
+
+/** @brief NVIC priority of the copy-complete interrupt (FreeRTOS-safe). */
+#define DMA_MEMCPY_IRQ_PRIORITY     (6 << 4)
+
+/**
+ * @brief Completion callback type.
+ * @note Runs in interrupt context; use only FreeRTOS "FromISR" APIs.
+ * @param status 0 if the copy completed, or a negative error code on a DMA
+ *               transfer error or if the stream could not be set up for it.
+ * @param user_data The pointer passed to dma_memcpy_async().
+ */
+typedef void (*dma_memcpy_callback_t)(int status, void* user_data);
+
+/**
+ * @brief Claims the DMA2 stream used by the copy service.
+ * @return 0 on success, or a negative error code on failure.
+ */
+int dma_memcpy_init(void);
+
+/**
+ * @brief Queues an asynchronous copy of `len` bytes from `src` to `dest`.
+ *
+ * @details Word-aligned copies move 32 bits per beat, and 16-byte-aligned
+ *          copies additionally use 4-beat bursts. Anything else falls back to
+ *          byte transfers. Neither buffer may be touched until the callback
+ *          has run. Both must be in DMA-reachable SRAM (not CCM RAM).
+ *          Must be called from task context.
+ *
+ * @param[out] dest Destination buffer.
+ * @param[in] src Source buffer.
+ * @param[in] len Number of bytes to copy.
+ * @param[in] callback Function called when the copy finishes. Can be NULL.
+ * @param[in] user_data Passed unchanged to the callback.
+ *
+ * @return 0 on success, -1 on invalid arguments, -2 if the queue is full,
+ *         -3 if the stream could not be set up for the copy.
+ */
+int dma_memcpy_async(void* dest, const void* src, size_t len, dma_memcpy_callback_t callback, void* user_data);
+
+/**
+ * @brief Reports whether every queued copy has completed.
+ * @return true if the service is idle, false if copies are pending.
+ */
+bool dma_memcpy_is_idle(void);
+
+#endif // DMA_MEMCPY_H
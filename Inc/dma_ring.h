@@ -0,0 +1,98 @@
+/**
+ * @file      dma_ring.h
+ * @brief     Byte rings filled by a circular DMA stream, with absolute positions.
+ *
+ * @details   A ring tracks how often its stream has wrapped, so any point in
+ *            the received data has an absolute position (bytes since start).
+ *            ISRs record positions when events happen. Tasks later read the
+ *            bytes between two positions and check that the DMA has not
+ *            overwritten them in the meantime. Ring lengths are a power of
+ *            two so positions stay consistent when they pass 2^32.
+ */
+
+#ifndef DMA_RING_H
+#define DMA_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "dma.h"
+
+typedef struct {
+    dma_handle_t dma;
+    uint8_t* buffer;
+    uint32_t length;            // Items; a power of two no larger than 32768
+    volatile uint32_t wraps;    // Completed passes, counted by the TC interrupt
+} dma_ring_t;
+
+/**
+ * @brief Gets the largest usable ring length for a memory region.
+ * @param[in] available_bytes Size of the region backing the ring, in items.
+ * @param[in] max_bytes Upper bound for the ring in items (at most 32768).
+ * @return The largest power of two no larger than either bound, or 0 if
+ *         `available_bytes` is 0.
+ */
+uint32_t dma_ring_fit_length(uint32_t available_bytes, uint32_t max_bytes);
+
+/**
+ * @brief Starts a circular transfer from a peripheral into the ring.
+ * @details `dma` must be configured for circular, peripheral-to-memory
+ *          transfers. Lengths and positions count transfer items: bytes for
+ *          8-bit streams, half-words or words for 16- and 32-bit ones (the
+ *          buffer then holds `length` of them). The TC interrupt is enabled; its handler must
+ *          call dma_ring_handle_wrap().
+ */
+void dma_ring_start(dma_ring_t* ring, dma_handle_t dma, const void* peripheral, uint8_t* buffer, uint32_t length);
+
+/**
+ * @brief Counts a wrap if the stream's transfer-complete flag is set.
+ * @note Call from the stream's interrupt handler.
+ * @return true if a wrap was counted.
+ */
+bool dma_ring_handle_wrap(dma_ring_t* ring);
+
+/**
+ * @brief Gets the absolute write position of the ring.
+ * @note Must run at the ring interrupt priority, or with it masked, so the
+ *       wrap count cannot change mid-read. A wrap whose interrupt is still
+ *       pending is detected from the TC flag.
+ */
+uint32_t dma_ring_position(dma_ring_t* ring);
+
+/**
+ * @brief Checks whether data from `position` onwards may have been overwritten.
+ * @note Task context; masks interrupts briefly to read the position.
+ */
+bool dma_ring_is_overwritten(dma_ring_t* ring, uint32_t position);
+
+/**
+ * @brief Reads one byte at an absolute position.
+ */
+static inline uint8_t dma_ring_byte_at(const dma_ring_t* ring, uint32_t position) {
+    return ring->buffer[position & (ring->length - 1U)];
+}
+
+/**
+ * @brief Reads one half-word at an absolute position of a 16-bit ring.
+ */
+static inline uint16_t dma_ring_halfword_at(const dma_ring_t* ring, uint32_t position) {
+    return ((const uint16_t*)ring->buffer)[position & (ring->length - 1U)];
+}
+
+/**
+ * @brief Reads one word at an absolute position of a 32-bit ring.
+ */
+static inline uint32_t dma_ring_word_at(const dma_ring_t* ring, uint32_t position) {
+    return ((const uint32_t*)ring->buffer)[position & (ring->length - 1U)];
+}
+
+/**
+ * @brief Appends `count` bytes starting at `position` as uppercase hex.
+ * @details Stops early if the buffer fills. The output is always
+ *          NUL-terminated, and the buffer pointer and remaining size are
+ *          advanced past the written digits.
+ */
+void dma_ring_append_hex(const dma_ring_t* ring, uint32_t position, uint32_t count, char** buf, size_t* remaining);
+
+#endif // DMA_RING_H
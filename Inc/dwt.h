@@ -0,0 +1,45 @@
+/*
+ * dwt.h
+ *
+ * Cortex-M4 DWT cycle counter, used to time hot paths in CPU cycles.
+ */
+
+#ifndef INC_DWT_H_
+#define INC_DWT_H_
+#pragma once
+#include "common.h"
+
+/** DEMCR: Debug Exception and Monitor Control Register */
+#define SCB_DEMCR			MMIO32(SCS_BASE + 0xDFC)
+#define SCB_DEMCR_TRCENA		BIT24
+
+/** DWT_CTRL: Control register */
+#define DWT_CTRL			MMIO32(DWT_BASE + 0x00)
+#define DWT_CTRL_CYCCNTENA		BIT0
+
+/** DWT_CYCCNT: Cycle count register */
+#define DWT_CYCCNT			MMIO32(DWT_BASE + 0x04)
+
+/** DWT_LAR: Lock access register */
+#define DWT_LAR				MMIO32(DWT_BASE + CORESIGHT_LAR_OFFSET)
+
+/**
+ * @brief Enables the free-running CPU cycle counter.
+ */
+static inline void dwt_enable_cycle_counter(void)
+{
+	SCB_DEMCR |= SCB_DEMCR_TRCENA;
+	DWT_LAR = CORESIGHT_LAR_KEY;
+	DWT_CYCCNT = 0;
+	DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+}
+
+/**
+ * @brief Reads the cycle counter. Differences wrap correctly as uint32_t.
+ */
+static inline uint32_t dwt_get_cycles(void)
+{
+	return DWT_CYCCNT;
+}
+
+#endif /* INC_DWT_H_ */
@@ -0,0 +1,197 @@
+/**
+ * @file      edge_stream.h
+ * @brief     Common edge-record stream between capture front-ends and decoders.
+ *
+ * @details   Capture modes that see individual signal transitions (the SPI
+ *            bit sampler, timer input capture, ...) reduce them to edge
+ *            records: a timestamp in capture_timebase ticks, a channel and
+ *            the line level after the edge. Records are queued in time order
+ *            and drained by edge_stream_poll(). With no decoder attached they
+ *            are reported as raw `edges` records. With a decoder attached,
+ *            each record is fed to it and it reports what it decodes.
+ *
+ *            A decoder can only see time pass through edges, so one that
+ *            ends a frame on a quiet line also provides flush(). The
+ *            front-ends call it once the queue is drained, with the time up
+ *            to which every edge has been fed, and a final time when the
+ *            capture stops.
+ *
+ *            A record flagged EDGE_FLAG_SYNC is not a transition. It gives
+ *            the channel's level when the stream starts, or restarts after
+ *            data was lost, and decoders treat it as a reset.
+ *
+ *            A record flagged EDGE_FLAG_ANALOG is an ADC reading taken
+ *            alongside the digital capture: its channel numbers the analog
+ *            input and its level holds the conversion result. Decoders
+ *            ignore these records.
+ *
+ *            An armed stream holds its records back until a trigger, using
+ *            the queue as the pre-trigger ring: the newest records are kept
+ *            and the older ones overwritten. The trigger latches the ring,
+ *            and the stream then reports the records from a set time before
+ *            the trigger onwards.
+ */
+
+#ifndef EDGE_STREAM_H
+#define EDGE_STREAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/** @brief Number of records buffered between producers and the poller (a power of two). */
+#define EDGE_STREAM_QUEUE_LENGTH        1024U
+
+/** @brief Most records per raw `edges` JSON record. */
+#define EDGE_STREAM_MAX_RECORD_EDGES    64U
+
+/** @brief Set in edge_t.flags for a level marker rather than a transition. */
+#define EDGE_FLAG_SYNC                  (1U << 0)
+
+/** @brief Set in edge_t.flags for an analog sample rather than a digital edge. */
+#define EDGE_FLAG_ANALOG                (1U << 1)
+
+/** @brief One edge record. */
+typedef struct {
+    uint32_t time;      // capture_timebase ticks
+    uint8_t channel;
+    uint8_t flags;      // EDGE_FLAG_* bits
+    uint16_t level;     // Line level after the edge (0 or 1), or an ADC reading
+} edge_t;
+
+/**
+ * @brief A protocol decoder fed from the edge stream.
+ */
+typedef struct {
+    const char* name;
+
+    /** @brief Drops any partial frame; called when the stream is reset. */
+    void (*reset)(void);
+
+    /**
+     * @brief Consumes one edge record.
+     * @return true if a JSON record was written to the buffer.
+     */
+    bool (*feed)(const edge_t* edge, char* json_buffer, size_t json_buffer_size);
+
+    /**
+     * @brief Reports what the line staying quiet until `now` completes; may be NULL.
+     * @details `now` never precedes the last edge fed. With `final` set the
+     *          capture has ended and anything still pending is reported and
+     *          dropped. Like feed(), writes at most one record per call; it is
+     *          called again while it returns true.
+     * @return true if a JSON record was written to the buffer.
+     */
+    bool (*flush)(uint32_t now, bool final, char* json_buffer, size_t json_buffer_size);
+} edge_decoder_t;
+
+/**
+ * @brief Empties the queue and selects who consumes it.
+ * @note Call while no producer is running.
+ * @param[in] decoder Decoder to feed, or NULL to report raw edges.
+ */
+void edge_stream_reset(const edge_decoder_t* decoder);
+
+/**
+ * @brief Holds the stream back until edge_stream_trigger() is called.
+ * @details Until the trigger is taken up by edge_stream_poll(), pushes never
+ *          fail but overwrite the oldest records, and polling reports
+ *          nothing. The pre-trigger history is therefore at most
+ *          EDGE_STREAM_QUEUE_LENGTH records, however long `pre_trigger_ticks`
+ *          is. edge_stream_reset() disarms the stream.
+ * @note Call from the producer's task, after edge_stream_reset().
+ *
+ * @param[in] pre_trigger_ticks History to report from before the trigger,
+ *                              in capture_timebase ticks.
+ */
+void edge_stream_arm(uint32_t pre_trigger_ticks);
+
+/**
+ * @brief Marks the trigger point of an armed stream.
+ * @note Callable from an ISR. Ignored if the stream is not armed or has
+ *       already been triggered.
+ * @param[in] time Trigger time in capture_timebase ticks.
+ */
+void edge_stream_trigger(uint32_t time);
+
+/**
+ * @brief Gets the number of records that can be pushed without dropping any.
+ * @details An armed stream reports the whole queue, as pushes never fail.
+ */
+uint32_t edge_stream_free(void);
+
+/**
+ * @brief Queues one record.
+ * @note Single producer; records must be pushed in time order.
+ * @return true if queued, false if the queue was full and the record dropped.
+ */
+bool edge_stream_push(uint32_t time, uint8_t channel, uint16_t level, uint8_t flags);
+
+/**
+ * @brief Extracts the edges of a packed 1-bit sample stream.
+ *
+ * @details Samples are packed MSB first, 8 per byte. Each change between
+ *          consecutive samples is queued as an edge at the time of the first
+ *          sample with the new level. Bytes with no change are skipped as a
+ *          whole, so idle stretches cost one compare per 8 samples.
+ *
+ * @param[in] channel Channel number for the records.
+ * @param[in] bits Packed samples.
+ * @param[in] count Number of bytes in `bits`.
+ * @param[in] time Timestamp of the first sample.
+ * @param[in] ticks_per_bit Sample period in capture_timebase ticks.
+ * @param[in,out] level Level before the first sample; updated to the level
+ *                      after the last one.
+ *
+ * @return The number of edges queued.
+ */
+uint32_t edge_stream_extract_packed(uint8_t channel, const uint8_t* bits, uint32_t count,
+                                    uint32_t time, uint32_t ticks_per_bit, uint8_t* level);
+
+/**
+ * @brief Drains queued records into the decoder, or formats them raw.
+ *
+ * @details Raw records are formatted as
+ *          `{"edges":[[t,ch,level],...]}` with up to
+ *          EDGE_STREAM_MAX_RECORD_EDGES entries. Flagged records carry
+ *          their flags as a fourth element (`1` for level markers, `2` for
+ *          analog samples). Once an armed stream has been triggered, the
+ *          first record is `{"trigger":{"t":time}}` and the raw records
+ *          or decoder output follow. Must be called from task context.
+ *
+ * @param[out] json_buffer Buffer receiving the JSON record.
+ * @param[in] json_buffer_size Size of the buffer in bytes.
+ *
+ * @return true if a record was written, false if the queue is empty.
+ */
+bool edge_stream_poll(char* json_buffer, size_t json_buffer_size);
+
+/**
+ * @brief Lets the decoder report what a quiet line completes.
+ * @details Does nothing unless the queue is empty, the stream is not held
+ *          back by a trigger, and the decoder has a flush() callback. Called
+ *          by the front-ends from their poll functions.
+ *
+ * @param[in] now Time in capture_timebase ticks up to which every edge has
+ *                been queued and fed.
+ * @param[out] json_buffer Buffer receiving the JSON record.
+ * @param[in] json_buffer_size Size of the buffer in bytes.
+ *
+ * @return true if a record was written.
+ */
+bool edge_stream_flush(uint32_t now, char* json_buffer, size_t json_buffer_size);
+
+/**
+ * @brief Reports what is left in the stream once its producer has stopped.
+ * @details Drains the queued records like edge_stream_poll(), then calls the
+ *          decoder's final flush() at the time of the last edge or flush.
+ *          Call repeatedly until it returns false.
+ *
+ * @param[out] json_buffer Buffer receiving the JSON record.
+ * @param[in] json_buffer_size Size of the buffer in bytes.
+ *
+ * @return true if a record was written, false once nothing is left.
+ */
+bool edge_stream_finish(char* json_buffer, size_t json_buffer_size);
+
+#endif // EDGE_STREAM_H
@@ -0,0 +1,71 @@
+/**
+ * @file      encoder_capture.h
+ * @brief     Quadrature encoder position and velocity using the timer encoder interface.
+ *
+ * @details   TIM3 runs in encoder mode, counting every edge of the A and B
+ *            lines (x4) up or down in hardware, whatever the speed. Its
+ *            update interrupt extends the 16-bit counter to a signed 64-bit
+ *            position, so long runs never wrap. TIM7 takes position
+ *            snapshots at a fixed rate, each stamped with the capture
+ *            timebase; the poller turns them into position/velocity records.
+ *
+ *            Wiring (signal -> analyzer, pulled up):
+ *              - A -> PA6 (TIM3_CH1)
+ *              - B -> PA7 (TIM3_CH2)
+ *
+ *            Records: {"encoder":{"samples":[[t,position,velocity],...]}},
+ *            with t in capture timebase ticks and velocity in counts per
+ *            second over the preceding snapshot interval.
+ */
+
+#ifndef ENCODER_CAPTURE_H
+#define ENCODER_CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/** @brief Default snapshot rate in Hz. */
+#define ENCODER_CAPTURE_DEFAULT_RATE_HZ     100U
+
+/** @brief Highest snapshot rate in Hz. */
+#define ENCODER_CAPTURE_MAX_RATE_HZ         1000U
+
+/** @brief Snapshots buffered between polls (a power of two). */
+#define ENCODER_CAPTURE_QUEUE_LENGTH        64U
+
+/** @brief Most snapshots per JSON record. */
+#define ENCODER_CAPTURE_MAX_RECORD_SAMPLES  16U
+
+/** @brief NVIC priority of both encoder interrupts (FreeRTOS-safe). */
+#define ENCODER_CAPTURE_IRQ_PRIORITY        (6 << 4)
+
+/**
+ * @brief Configures the encoder interface and the snapshot timer and starts counting.
+ * @details The position starts at 0.
+ *
+ * @param[in] filter Input filter for both lines, 0 (off) to 15.
+ * @param[in] rate_hz Snapshot rate, 1 to ENCODER_CAPTURE_MAX_RATE_HZ.
+ *
+ * @return 0 on success, -1 if already running or the arguments are invalid,
+ *         -2 if a peripheral could not be claimed.
+ */
+int encoder_capture_start(uint8_t filter, uint32_t rate_hz);
+
+/**
+ * @brief Stops counting and releases every peripheral claimed by the mode.
+ */
+void encoder_capture_stop(void);
+
+/**
+ * @brief Formats the next batch of snapshots, if any.
+ * @details Must be called from task context.
+ *
+ * @param[out] json_buffer Buffer receiving the JSON record.
+ * @param[in] json_buffer_size Size of the buffer in bytes.
+ *
+ * @return true if a record was written, false if nothing is pending.
+ */
+bool encoder_capture_poll(char* json_buffer, size_t json_buffer_size);
+
+#endif // ENCODER_CAPTURE_H
@@ -0,0 +1,86 @@
+/**
+ * @file      freq_counter.h
+ * @brief     Continuous frequency, period and duty-cycle measurement using timer counting.
+ *
+ * @details   Each channel's pin drives the ETR input of its own timer, so
+ *            edges are counted in hardware with no per-edge CPU or DMA work.
+ *            TIM6 slices time into FREQ_COUNTER_SLICE_US steps; its update
+ *            interrupt collects each counter's 16-bit delta and stamps the
+ *            slice with the capture timebase, so interrupt latency does not
+ *            bias the measured window.
+ *
+ *            Every gate period is split in two halves:
+ *              - Edge half: the counter is clocked by rising edges on ETR,
+ *                giving the frequency (and its mean period).
+ *              - Duty half: the counter runs on its kernel clock gated by the
+ *                ETR level, giving the fraction of time the line is high.
+ *            One result per enabled channel is published after every gate
+ *            period.
+ *
+ *            Wiring (signal -> analyzer):
+ *              - Channel 0 -> PE7 (TIM1_ETR), up to 18 MHz
+ *              - Channel 1 -> PD2 (TIM3_ETR), up to 18 MHz
+ *              - Channel 2 -> PE0 (TIM4_ETR), up to 18 MHz
+ *              - Channel 3 -> PA0 (TIM8_ETR), up to 18 MHz
+ *
+ *            The limits are a quarter of each timer's kernel clock (72 MHz
+ *            on both APB buses under clock_setup()), the fastest ETR signal
+ *            the timer resynchronizes reliably. The
+ *            sampling timer (TIM2) and its DMA are not used.
+ */
+
+#ifndef FREQ_COUNTER_H
+#define FREQ_COUNTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/** @brief Number of counter channels. */
+#define FREQ_COUNTER_CHANNELS           4
+
+/** @brief Length of one counting slice; no 16-bit counter wraps twice in it. */
+#define FREQ_COUNTER_SLICE_US           250U
+
+/** @brief Default gate period (edge half plus duty half) in milliseconds. */
+#define FREQ_COUNTER_DEFAULT_GATE_MS    100U
+
+/** @brief Shortest accepted gate period in milliseconds. */
+#define FREQ_COUNTER_MIN_GATE_MS        2U
+
+/** @brief Longest accepted gate period in milliseconds. */
+#define FREQ_COUNTER_MAX_GATE_MS        1000U
+
+/** @brief NVIC priority of the slice interrupt (FreeRTOS-safe). */
+#define FREQ_COUNTER_IRQ_PRIORITY       (6 << 4)
+
+/**
+ * @brief Configures the counter timers and the slice timer and starts measuring.
+ *
+ * @param[in] channel_mask Bit n enables channel n (0 to 3).
+ * @param[in] filter ETR input filter for all channels, 0 (off) to 15.
+ * @param[in] gate_ms Gate period in milliseconds, rounded to whole slices.
+ *
+ * @return 0 on success, -1 if already running or the arguments are invalid,
+ *         -2 if a peripheral could not be claimed.
+ */
+int freq_counter_start(uint8_t channel_mask, uint8_t filter, uint32_t gate_ms);
+
+/**
+ * @brief Stops measuring and releases every peripheral claimed by the mode.
+ */
+void freq_counter_stop(void);
+
+/**
+ * @brief Formats the latest result if a new gate period has completed.
+ * @details Must be called from task context. Results not polled before the
+ *          next gate period ends are replaced by it.
+ *
+ * @param[out] json_buffer Buffer receiving the JSON record.
+ * @param[in] json_buffer_size Size of the buffer in bytes.
+ *
+ * @return true if a record was written, false if nothing is pending.
+ */
+bool freq_counter_poll(char* json_buffer, size_t json_buffer_size);
+
+#endif // FREQ_COUNTER_H
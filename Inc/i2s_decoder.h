@@ -0,0 +1,85 @@
+/**
+ * @file      i2s_decoder.h
+ * @brief     I2S, left-justified and TDM audio decoder for GPIOB sample segments.
+ *
+ * @details   Audio bit clocks run at MHz rates, far beyond the edge stream, so
+ *            this decoder works on the raw GPIOB samples of the legacy
+ *            capture path. Best is the external clock (the "clock":
+ *            "ext_rising" setting) with BCLK on PE7: every sample is then
+ *            taken on a rising BCLK edge, where receivers sample SD and FS.
+ *            With TIM2 sampling, the rising edges of the BCLK pin select the
+ *            samples instead, which only suits slow links.
+ *
+ *            Frame alignment follows the format:
+ *              - I2S: a WS edge starts a slot one bit later; WS low is slot 0.
+ *              - Left-justified: a WS edge starts a slot at once; WS high is slot 0.
+ *              - TDM: a rising FS edge starts slot 0 one bit later, and the
+ *                other slots follow back to back.
+ *            Each slot's first slot_bits bits, MSB first, form a signed sample.
+ *
+ *            Each segment is reported as one block:
+ *            {"protocol":"I2S","ts":n,"frames":n,"bits":n,"pcm":["b64",...],"peak":[...],"rms":[...]}
+ *            ts is the index of the segment's first sample, frames counts the
+ *            frames completed in it, and "pcm" holds one base64 string per
+ *            slot of little-endian samples, 2, 3 or 4 bytes each. When the
+ *            link cannot carry the audio, "pcm" can be left out and only the
+ *            peak and RMS of each slot sent. Samples that do not fit in the
+ *            record are left out of "pcm", counted in "dropped", and still
+ *            counted in the summary.
+ */
+
+#ifndef I2S_DECODER_H
+#define I2S_DECODER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/** @brief Most slots per frame. */
+#define I2S_DECODER_MAX_SLOTS           8U
+
+/** @brief Raw PCM bytes per block, over all slots; sized to fit the output record as base64. */
+#define I2S_DECODER_MAX_BLOCK_BYTES     1152U
+
+/** @brief Frame formats. */
+typedef enum {
+    I2S_FORMAT_I2S = 0,
+    I2S_FORMAT_LEFT_JUSTIFIED,
+    I2S_FORMAT_TDM,
+} i2s_format_t;
+
+/** @brief Decoder settings. */
+typedef struct {
+    i2s_format_t format;
+    uint8_t slot_bits;          // Bits per sample, 8 to 32
+    uint8_t slots;              // Slots per frame; 2 for I2S and left-justified
+    uint8_t bclk_pin;           // GPIOB pins
+    uint8_t fs_pin;
+    uint8_t sd_pin;
+    bool pcm;                   // Send the samples
+    bool summary;               // Send peak and RMS per slot
+} i2s_decoder_config_t;
+
+/**
+ * @brief Sets up the decoder for the next capture.
+ * @param[in] config Decoder settings.
+ * @return 0 on success, -1 if the settings are invalid.
+ */
+int i2s_decoder_configure(const i2s_decoder_config_t* config);
+
+/**
+ * @brief Decodes one segment of GPIOB samples into a JSON block.
+ * @note Segments must be passed in order; the first one (first_sample == 0)
+ *       restarts the frame alignment.
+ *
+ * @param[in] samples GPIOB samples.
+ * @param[in] count Number of samples.
+ * @param[in] first_sample Index of the first sample within the capture.
+ * @param[in] clocked true if every sample was taken on a rising BCLK edge.
+ * @param[out] json_buffer Buffer receiving the JSON record.
+ * @param[in] json_buffer_size Size of the buffer in bytes.
+ */
+void i2s_decoder_process(const uint16_t* samples, uint32_t count, uint32_t first_sample, bool clocked,
+                         char* json_buffer, size_t json_buffer_size);
+
+#endif // I2S_DECODER_H
@@ -0,0 +1,21 @@
+/**
+ * @file      json_text.h
+ * @brief     Helpers for building JSON records in a fixed-size buffer.
+ */
+
+#ifndef JSON_TEXT_H
+#define JSON_TEXT_H
+
+#include <stddef.h>
+
+/**
+ * @brief Appends text at the write position of a buffer.
+ * @details Text that does not fit is dropped whole, leaving the buffer
+ *          terminated after the last piece that did fit.
+ * @param[in,out] buf Write position; advanced past the text.
+ * @param[in,out] remaining Space left at `buf`, including the terminator.
+ * @param[in] text Null-terminated text to append.
+ */
+void json_text_append(char** buf, size_t* remaining, const char* text);
+
+#endif // JSON_TEXT_H
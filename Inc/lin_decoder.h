@@ -0,0 +1,63 @@
+/**
+ * @file      lin_decoder.h
+ * @brief     LIN frame decoder fed from the edge stream.
+ *
+ * @details   Decodes one LIN bus line captured by SPI_SAMPLE or
+ *            TIMER_CAPTURE. A frame starts with a break, a low pulse of at
+ *            least 11 bit times, and a 0x55 sync field. The bit time is
+ *            measured over the sync field's falling edges, which span 8 bits,
+ *            so the decoder follows the master's actual baud rate; a fixed
+ *            nominal rate only narrows which breaks are accepted. The
+ *            protected identifier's parity bits are checked, and the response
+ *            bytes are read as 8N1 characters sampled mid-bit.
+ *
+ *            LIN frames carry no length, so a frame ends at the next break, or
+ *            once the longest allowed frame time has passed, or when the
+ *            capture stops, and is reported then, with its last byte taken as
+ *            the checksum:
+ *            {"lin":{"t":time,"baud":n,"id":n,"data":"hex","checksum":"classic|enhanced|bad|none"}}
+ *            with t the break time in capture timebase ticks. "none" means
+ *            no slave answered the header. Frames whose identifier is not in
+ *            the filter are dropped. Errors are reported whatever the filter:
+ *            {"lin_error":{"t":time,"type":"sync|parity|framing|length"}}
+ *            after which the decoder waits for the next break. With a fixed
+ *            rate, a break followed by a bad sync field is an error; while
+ *            auto-bauding, it is only a low pulse that was not a break.
+ */
+
+#ifndef LIN_DECODER_H
+#define LIN_DECODER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "edge_stream.h"
+
+/** @brief Lowest and highest LIN bit rates in bit/s. */
+#define LIN_DECODER_MIN_BITRATE         1000U
+#define LIN_DECODER_MAX_BITRATE         20000U
+
+/** @brief Allowed deviation of the measured rate from a fixed rate, in percent. */
+#define LIN_DECODER_BITRATE_TOLERANCE_PCT   15U
+
+/** @brief Filter passing every identifier. */
+#define LIN_DECODER_ALL_IDS             0xFFFFFFFFFFFFFFFFULL
+
+/** @brief Decoder settings. */
+typedef struct {
+    uint8_t channel;        // Edge-stream channel of the bus line
+    uint32_t bitrate;       // Nominal bit rate in bit/s, or 0 to accept any rate
+    uint64_t id_filter;     // Bit n set to report frames with identifier n
+} lin_decoder_config_t;
+
+/** @brief The decoder, to pass to a capture front-end. */
+extern const edge_decoder_t lin_decoder;
+
+/**
+ * @brief Sets up the decoder for the next capture.
+ * @param[in] config Decoder settings.
+ * @return 0 on success, -1 if the settings are invalid.
+ */
+int lin_decoder_configure(const lin_decoder_config_t* config);
+
+#endif // LIN_DECODER_H
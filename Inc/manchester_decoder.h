@@ -0,0 +1,76 @@
+/**
+ * @file      manchester_decoder.h
+ * @brief     Manchester and biphase-mark decoder fed from the edge stream.
+ *
+ * @details   Decodes one self-clocked line captured by SPI_SAMPLE or
+ *            TIMER_CAPTURE. Every interval between edges is classified as one
+ *            or two half-bit periods, and each classified interval pulls the
+ *            half-bit estimate towards what was measured, so the decoder
+ *            follows a transmitter up to 10% off the nominal rate and the
+ *            drift within a packet. The cost is a few operations per edge.
+ *
+ *              - Manchester (IEEE 802.3): a rising mid-bit edge is a 1.
+ *              - Manchester (G. E. Thomas): a falling mid-bit edge is a 1.
+ *              - Biphase mark (BMC): an edge at every bit boundary, and one
+ *                more in the middle of a 1; the levels do not matter.
+ *
+ *            A packet starts at the first edge after the line has been quiet
+ *            for more than 2.5 half-bits. The decoder locks on to the bit
+ *            phase at the first two-half-bit interval, which a preamble of
+ *            alternating bits provides, then looks for the sync word. The
+ *            bits after it are packed into payload bytes, and the packet is
+ *            reported when the line goes quiet, the payload is full, the
+ *            timing breaks down, or the capture stops:
+ *            {"manchester":{"t":time,"code":"ieee|thomas|bmc","rate":n,"bits":n,"data":"hex"}}
+ *            with t the time of the packet's first edge in capture timebase
+ *            ticks and rate the recovered bit rate. A packet cut short by a
+ *            bad interval carries "error":"timing". Packets in which the sync
+ *            word never appeared are not reported.
+ */
+
+#ifndef MANCHESTER_DECODER_H
+#define MANCHESTER_DECODER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "edge_stream.h"
+
+/** @brief Lowest and highest bit rates in bit/s. */
+#define MANCHESTER_DECODER_MIN_BITRATE      100U
+#define MANCHESTER_DECODER_MAX_BITRATE      2000000U
+
+/** @brief Bit rate used when none is given, in bit/s. */
+#define MANCHESTER_DECODER_DEFAULT_BITRATE  10000U
+
+/** @brief Most payload bytes per packet record. */
+#define MANCHESTER_DECODER_MAX_BYTES        64U
+
+/** @brief Line codes. */
+typedef enum {
+    MANCHESTER_CODE_IEEE = 0,
+    MANCHESTER_CODE_THOMAS,
+    MANCHESTER_CODE_BMC,
+} manchester_code_t;
+
+/** @brief Decoder settings. */
+typedef struct {
+    uint8_t channel;            // Edge-stream channel of the line
+    manchester_code_t code;
+    uint32_t bitrate;           // Nominal bit rate in bit/s
+    uint32_t sync_word;         // Pattern ending the preamble, last bit received in bit 0
+    uint8_t sync_bits;          // Length of sync_word, 0 to 32; 0 starts the payload at the first bit
+    bool lsb_first;             // Payload bit order within each byte
+} manchester_decoder_config_t;
+
+/** @brief The decoder, to pass to a capture front-end. */
+extern const edge_decoder_t manchester_decoder;
+
+/**
+ * @brief Sets up the decoder for the next capture.
+ * @param[in] config Decoder settings.
+ * @return 0 on success, -1 if the settings are invalid.
+ */
+int manchester_decoder_configure(const manchester_decoder_config_t* config);
+
+#endif // MANCHESTER_DECODER_H
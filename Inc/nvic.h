@@ -9,7 +9,7 @@
 #define INC_NVIC_H_
 #pragma once
 #include "common.h"
-#define NVIC_IRQ_COUNT 0
+#define NVIC_IRQ_COUNT 82 // STM32F407 device interrupts
 
 #define SCB_SHPR(ipr_id)		MMIO8(SCS_BASE + 0xD18 + (ipr_id))
 
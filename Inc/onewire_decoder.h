@@ -0,0 +1,59 @@
+/**
+ * @file      onewire_decoder.h
+ * @brief     1-Wire transaction decoder fed from the edge stream.
+ *
+ * @details   Decodes one 1-Wire bus line captured by SPI_SAMPLE or
+ *            TIMER_CAPTURE. Every low pulse is classified by its width: a
+ *            reset pulse, the presence pulse that answers it, or a time slot.
+ *            A slot shorter than the master's sampling point reads as 1 and
+ *            a longer one as 0, whether the master wrote it or a slave held
+ *            the line in a read slot. A standard-speed reset returns the
+ *            decoder to standard timing, and the Overdrive Skip/Match ROM
+ *            commands switch it to overdrive timing.
+ *
+ *            Bits are assembled LSB first into the ROM command, then the ROM
+ *            phase the command implies (the 64-bit ROM of Read/Match ROM, or
+ *            the bit triplets of a Search ROM pass, of which the direction
+ *            bits give the ROM found), then the function command and its
+ *            payload. Each transaction, from a reset to the next one, is
+ *            reported as a single record when the next reset ends it, the
+ *            line has stayed high for 1 ms, or the capture stops:
+ *            {"onewire":{"t":time,"od":0|1,"presence":0|1,"rom_cmd":n,
+ *            "rom":"hex","rom_crc":0|1,"data":"hex","data_crc":0|1|null}}
+ *            with t the reset time in capture timebase ticks. The ROM is
+ *            given as transmitted, family code first, and rom_crc checks its
+ *            CRC-8. data_crc is given only for Read Scratchpad (0xBE): 1 when
+ *            the 9-byte scratchpad ends with its own CRC-8, 0 when it does
+ *            not, and null when the master read fewer bytes. Fields
+ *            with nothing to report are left out; "bits", "bad_slots" and
+ *            "data_bytes" appear only for a trailing partial byte, for
+ *            over-long slots and for a payload longer than the record keeps.
+ */
+
+#ifndef ONEWIRE_DECODER_H
+#define ONEWIRE_DECODER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "edge_stream.h"
+
+/** @brief Most payload bytes kept per transaction; later ones are only counted. */
+#define ONEWIRE_DECODER_MAX_DATA_BYTES  32U
+
+/** @brief Decoder settings. */
+typedef struct {
+    uint8_t channel;        // Edge-stream channel of the bus line
+} onewire_decoder_config_t;
+
+/** @brief The decoder, to pass to a capture front-end. */
+extern const edge_decoder_t onewire_decoder;
+
+/**
+ * @brief Sets up the decoder for the next capture.
+ * @param[in] config Decoder settings.
+ * @return 0 on success, -1 if the settings are invalid.
+ */
+int onewire_decoder_configure(const onewire_decoder_config_t* config);
+
+#endif // ONEWIRE_DECODER_H
@@ -0,0 +1,57 @@
+/**
+ * @file      pwm_stats.h
+ * @brief     Per-channel pulse-width statistics over the edge stream.
+ *
+ * @details   Instead of decoding a protocol, this consumer of the edge stream
+ *            condenses every channel's transitions into running statistics:
+ *            count, minimum, maximum, mean and standard deviation of the high
+ *            and low times, the mean period and the duty cycle, and a
+ *            histogram of each pulse width in octave bins. Memory is fixed
+ *            and the output is one summary per channel and window, so a
+ *            capture can run indefinitely at a tiny link load.
+ *
+ *            A channel's window ends at its first edge at least window_ms
+ *            after the window started, or once window_ms has passed on a line
+ *            that stays quiet, and when the capture stops. It is reported as
+ *            {"pwm":{"ch":n,"t":time,"span":ticks,"period":ticks,"freq_millihz":n,"duty":n,
+ *            "high":{"n":n,"min":t,"max":t,"mean":t,"sd":t,"hist":[first,[counts]]},"low":{...}}}
+ *            All times are in capture timebase ticks, t being the window
+ *            start. freq_millihz is the frequency in millihertz and duty
+ *            the share of the window spent high in 0.01 % steps, so a channel
+ *            stuck at one level reports 0 or 10000 with no widths. Histogram bin
+ *            first + i counts the widths from 2^(first + i) to
+ *            2^(first + i + 1) - 1 ticks; the bins are listed from the first
+ *            to the last non-empty one.
+ */
+
+#ifndef PWM_STATS_H
+#define PWM_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "edge_stream.h"
+
+/** @brief Channels tracked, numbered as on the edge stream. */
+#define PWM_STATS_MAX_CHANNELS      4U
+
+/** @brief Default and largest summary window in ms. */
+#define PWM_STATS_DEFAULT_WINDOW_MS 1000U
+#define PWM_STATS_MAX_WINDOW_MS     10000U
+
+/** @brief Statistics settings. */
+typedef struct {
+    uint32_t window_ms;     // One summary per channel and window
+} pwm_stats_config_t;
+
+/** @brief The statistics engine, to pass to a capture front-end as its decoder. */
+extern const edge_decoder_t pwm_stats_decoder;
+
+/**
+ * @brief Sets up the statistics for the next capture.
+ * @param[in] config Settings.
+ * @return 0 on success, -1 if the settings are invalid.
+ */
+int pwm_stats_configure(const pwm_stats_config_t* config);
+
+#endif // PWM_STATS_H
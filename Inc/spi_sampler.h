@@ -0,0 +1,96 @@
+/**
+ * @file      spi_sampler.h
+ * @brief     High-rate single-line sampling using SPI1 as a receive-only deserializer.
+ *
+ * @details   SPI1 runs as a receive-only master, clocked from its own
+ *            prescaler, and shifts in the level of its MISO pin once per bit
+ *            clock. A circular DMA ring in the capture arena collects the
+ *            samples packed 8 per byte, MSB first, with no per-sample CPU
+ *            work. The poller walks the ring and turns changes into edge
+ *            records on the common edge stream, where they are reported raw
+ *            or fed to a decoder.
+ *
+ *            Wiring (signal -> analyzer):
+ *              - Signal -> PA6 (SPI1_MISO)
+ *
+ *            The sample clock is the APB2 clock divided by the prescaler, so
+ *            DIV_2 gives 42 Msps. SCK is not routed to a pin. At the highest
+ *            rates a 32 KB ring holds about 6 ms, so a busy signal can outrun
+ *            the poller; lost stretches are marked with level markers.
+ *
+ *            Scans from analog_capture, if running, are merged into the
+ *            stream in time order with the edges.
+ */
+
+#ifndef SPI_SAMPLER_H
+#define SPI_SAMPLER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "spi.h"
+#include "edge_stream.h"
+#include "system_clock.h"
+
+/** @brief Clock feeding the SPI1 prescaler (APB2) in Hz. */
+#define SPI_SAMPLER_KERNEL_HZ           SYSTEM_CLOCK_APB2_HZ
+
+/** @brief Upper bound for the DMA ring; the ring is a power of two in size. */
+#define SPI_SAMPLER_MAX_RING_BYTES      32768U
+
+/** @brief Smallest usable ring; the arena must provide at least this. */
+#define SPI_SAMPLER_MIN_RING_BYTES      1024U
+
+/** @brief Most ring bytes scanned per extraction step. */
+#define SPI_SAMPLER_EXTRACT_BYTES       1024U
+
+/** @brief NVIC priority of the ring interrupt (FreeRTOS-safe). */
+#define SPI_SAMPLER_IRQ_PRIORITY        (6 << 4)
+
+/** @brief Channel number of the sampled line in edge records. */
+#define SPI_SAMPLER_CHANNEL             0
+
+/**
+ * @brief Configures SPI1 and its DMA ring and starts sampling.
+ * @note Uses arena segment 0 as the ring and resets the edge stream, so no
+ *       other capture may be running.
+ *
+ * @param[in] prescaler Divider from SPI_SAMPLER_KERNEL_HZ to the sample rate.
+ * @param[in] decoder Decoder fed with the edges, or NULL to report them raw.
+ *
+ * @return 0 on success, -1 if already running or the arena is too small,
+ *         -2 if a peripheral could not be claimed.
+ */
+int spi_sampler_start(spi_baud_rate_t prescaler, const edge_decoder_t* decoder);
+
+/**
+ * @brief Stops sampling and releases every peripheral claimed by the sampler.
+ */
+void spi_sampler_stop(void);
+
+/**
+ * @brief Extracts edges from the ring and formats the next record, if any.
+ * @details Must be called from task context. Once every captured edge is
+ *          decoded, the decoder's flush() is called with the time captured
+ *          up to, so it can close what an idle line ends.
+ *
+ * @param[out] json_buffer Buffer receiving the JSON record.
+ * @param[in] json_buffer_size Size of the buffer in bytes.
+ *
+ * @return true if a record was written, false if nothing is pending.
+ */
+bool spi_sampler_poll(char* json_buffer, size_t json_buffer_size);
+
+/**
+ * @brief Gets the sample rate of the current run in Hz, or 0 if not running.
+ */
+uint32_t spi_sampler_get_sample_rate(void);
+
+/**
+ * @brief Gets the size of the DMA ring for the current run.
+ * @return Ring size in bytes, or 0 if the sampler is not running.
+ */
+uint32_t spi_sampler_get_ring_bytes(void);
+
+#endif // SPI_SAMPLER_H
@@ -0,0 +1,89 @@
+/**
+ * @file      spi_sniffer.h
+ * @brief     Wire-speed SPI capture using two SPI peripherals as receive-only slaves.
+ *
+ * @details   SPI1 listens to the target's MOSI line and SPI2 to its MISO line.
+ *            Both are clocked by the target's SCK and gated by its CS. Each
+ *            one feeds a circular DMA ring in the capture arena, so bytes are
+ *            captured without any per-bit CPU work. CS edges are timestamped
+ *            through EXTI. When CS is released, the bytes received since it
+ *            was asserted are reported as one frame.
+ *
+ *            Wiring (target -> analyzer):
+ *              - SCK  -> PA5 (SPI1_SCK) and PB13 (SPI2_SCK)
+ *              - CS   -> PA4 (SPI1_NSS) and PB12 (SPI2_NSS)
+ *              - MOSI -> PA7 (SPI1_MOSI)
+ *              - MISO -> PB15 (SPI2_MOSI)
+ *
+ *            SPI2 sits on APB1, which limits the MISO channel to about 21 MHz
+ *            SCK. Start the sniffer while the bus is idle so both slaves are
+ *            byte-aligned with the first frame.
+ */
+
+#ifndef SPI_SNIFFER_H
+#define SPI_SNIFFER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "spi.h"
+
+/** @brief Upper bound for each DMA ring; rings are a power of two in size. */
+#define SPI_SNIFFER_MAX_RING_BYTES      32768U
+
+/** @brief Smallest usable ring; the arena must provide at least this per line. */
+#define SPI_SNIFFER_MIN_RING_BYTES      256U
+
+/** @brief Number of CS edges buffered between the EXTI ISR and the poller. */
+#define SPI_SNIFFER_EVENT_QUEUE_LENGTH  32
+
+/** @brief Most bytes per direction included in one frame record. */
+#define SPI_SNIFFER_MAX_FRAME_BYTES     128U
+
+/** @brief NVIC priority shared by the ring and CS interrupts (FreeRTOS-safe). */
+#define SPI_SNIFFER_IRQ_PRIORITY        (6 << 4)
+
+/**
+ * @brief Configures both slaves, their DMA rings and the CS interrupt, and starts listening.
+ * @note Uses arena segments 0 and 1 as the rings, so the arena must be split
+ *       into at least two segments and no sampled capture may be running.
+ *
+ * @param[in] cpol Clock polarity of the target bus.
+ * @param[in] cpha Clock phase of the target bus.
+ * @param[in] bit_order Bit order of the target bus.
+ *
+ * @return 0 on success, -1 if already running or the arena is too small,
+ *         -2 if a peripheral could not be claimed.
+ */
+int spi_sniffer_start(spi_clock_polarity_t cpol, spi_clock_phase_t cpha, spi_bit_order_t bit_order);
+
+/**
+ * @brief Stops listening and releases every peripheral claimed by the sniffer.
+ */
+void spi_sniffer_stop(void);
+
+/**
+ * @brief Formats the next completed frame, if any.
+ *
+ * @details Produces `{"spi_sniff":{"t_start":..,"t_end":..,"len":..,"mosi":"..","miso":".."}}`
+ *          with timestamps in capture_timebase ticks and data as hex. Frames
+ *          longer than SPI_SNIFFER_MAX_FRAME_BYTES are cut and flagged with
+ *          "truncated". A frame whose bytes were overwritten before they
+ *          could be read is flagged with "overrun" and carries no data.
+ *          Must be called from task context.
+ *
+ * @param[out] json_buffer Buffer receiving the JSON record.
+ * @param[in] json_buffer_size Size of the buffer in bytes.
+ *
+ * @return true if a record was written, false if no frame is pending.
+ */
+bool spi_sniffer_poll(char* json_buffer, size_t json_buffer_size);
+
+/**
+ * @brief Gets the size of each DMA ring for the current run.
+ * @return Ring size in bytes, or 0 if the sniffer is not running.
+ */
+uint32_t spi_sniffer_get_ring_bytes(void);
+
+#endif // SPI_SNIFFER_H
@@ -0,0 +1,51 @@
+/**
+ * @file      swd_decoder.h
+ * @brief     Serial Wire Debug transaction decoder fed from the edge stream.
+ *
+ * @details   Decodes SWDIO against SWCLK, captured as two TIMER_CAPTURE
+ *            channels, so the debug clock must stay within what input capture
+ *            can follow (about 1 MHz). SWDIO is read on every rising SWCLK
+ *            edge, the edge on which both host and target bits are valid.
+ *
+ *            A transaction starts with a request whose start, stop, park and
+ *            parity bits check out, followed by the turnaround and the ACK,
+ *            and for an OK ACK by the 32-bit data phase and its parity, in
+ *            the direction the request gives. 50 or more clocks with SWDIO
+ *            high form a line reset.
+ *
+ *            Identical consecutive transactions, such as a debugger polling
+ *            DHCSR or retrying on WAIT, are folded into one record with a
+ *            count. A record is therefore reported when a different
+ *            transaction follows it, SWCLK has stopped for 100 ms, or the
+ *            capture stops:
+ *            {"swd":{"t":time,"n":count,"op":"rd|wr","port":"dp|ap","addr":n,"ack":"ok|wait|fault|none","data":n,"parity":0|1}}
+ *            or {"swd":{"t":time,"n":count,"op":"reset"}}, with t the time of
+ *            the first one in capture timebase ticks, "t_last" that of the
+ *            last one when n > 1, and data and parity only for an OK ACK.
+ */
+
+#ifndef SWD_DECODER_H
+#define SWD_DECODER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "edge_stream.h"
+
+/** @brief Decoder settings. */
+typedef struct {
+    uint8_t clock_channel;      // Edge-stream channel of SWCLK
+    uint8_t data_channel;       // Edge-stream channel of SWDIO
+} swd_decoder_config_t;
+
+/** @brief The decoder, to pass to a capture front-end. */
+extern const edge_decoder_t swd_decoder;
+
+/**
+ * @brief Sets up the decoder for the next capture.
+ * @param[in] config Decoder settings.
+ * @return 0 on success, -1 if the settings are invalid.
+ */
+int swd_decoder_configure(const swd_decoder_config_t* config);
+
+#endif // SWD_DECODER_H
@@ -0,0 +1,65 @@
+/**
+ * @file      sync_sampler.h
+ * @brief     Synchronous (state) sampling of GPIOB on the edges of an external clock.
+ *
+ * @details   TIM1 is clocked from its ETR pin in external clock mode 1, so
+ *            every selected edge of the target's clock is a trigger event.
+ *            Each trigger event raises a DMA request that copies GPIOB IDR
+ *            into the capture arena: exactly one sample per bus cycle, with
+ *            no oversampling. The stream runs in double-buffer mode and is
+ *            handed the next arena segment on every transfer-complete, so
+ *            segments fill back to back without losing a clock edge.
+ *
+ *            Wiring (signal -> analyzer):
+ *              - Bus clock -> PE7 (TIM1_ETR)
+ *              - Data      -> PB0..PB7 (sampled as in the internal-clock mode)
+ *
+ *            Samples are indexed by clock cycle rather than time. One DMA
+ *            request per edge limits the bus clock to about
+ *            SYNC_SAMPLER_MAX_CLOCK_HZ; faster clocks lose cycles silently.
+ *            After the last segment is reported, a few trailing samples may
+ *            still land at the start of segment 0, which by then has long
+ *            been handed off.
+ */
+
+#ifndef SYNC_SAMPLER_H
+#define SYNC_SAMPLER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Highest external clock the DMA keeps up with, in Hz. */
+#define SYNC_SAMPLER_MAX_CLOCK_HZ       10000000UL
+
+/** @brief NVIC priority of the segment interrupt (FreeRTOS-safe). */
+#define SYNC_SAMPLER_IRQ_PRIORITY       (6 << 4)
+
+/**
+ * @brief Called from the DMA interrupt each time an arena segment is full.
+ * @details Segments complete in order; the run stops by itself once the last
+ *          segment (capture_arena_get_segment_count() - 1) is reported.
+ */
+typedef void (*sync_sampler_segment_callback_t)(uint8_t segment);
+
+/**
+ * @brief Configures TIM1, GPIOB and the sample DMA and arms the capture.
+ * @note Fills the whole arena, so no other capture may be running. Any
+ *       earlier sync run is stopped first.
+ *
+ * @param[in] falling_edge true to sample on falling clock edges, false for rising.
+ * @param[in] filter ETR input filter, 0 (off) to 15.
+ * @param[in] on_segment Callback for each completed segment.
+ *
+ * @return 0 on success, -1 if the arguments are invalid or the arena has
+ *         too few segments, -2 if a peripheral could not be claimed.
+ */
+int sync_sampler_start(bool falling_edge, uint8_t filter, sync_sampler_segment_callback_t on_segment);
+
+/**
+ * @brief Stops sampling and releases every peripheral claimed by the sampler.
+ * @details A run that filled the arena has already stopped sampling, but
+ *          keeps its peripherals until this is called or the next run starts.
+ */
+void sync_sampler_stop(void);
+
+#endif // SYNC_SAMPLER_H
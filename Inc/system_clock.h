@@ -0,0 +1,29 @@
+/**
+ * @file      system_clock.h
+ * @brief     Core, bus and timer clocks set up by clock_setup() in main.c.
+ *
+ * @details   clock_setup() runs the core at 72 MHz from the 8 MHz HSE, with
+ *            APB1 at half that and APB2 undivided. Every module that turns a
+ *            rate into timer periods, baud divisors or timestamp ticks takes
+ *            its clock from here, so a new clock tree only changes this file.
+ */
+
+#ifndef SYSTEM_CLOCK_H
+#define SYSTEM_CLOCK_H
+
+/** @brief Core clock (HCLK) in Hz; also the DWT cycle counter rate. */
+#define SYSTEM_CLOCK_HZ             72000000UL
+
+/** @brief APB1 and APB2 prescalers from HCLK. */
+#define SYSTEM_CLOCK_APB1_DIV       2UL
+#define SYSTEM_CLOCK_APB2_DIV       1UL
+
+/** @brief Peripheral bus clocks (PCLK1, PCLK2) in Hz. */
+#define SYSTEM_CLOCK_APB1_HZ        (SYSTEM_CLOCK_HZ / SYSTEM_CLOCK_APB1_DIV)
+#define SYSTEM_CLOCK_APB2_HZ        (SYSTEM_CLOCK_HZ / SYSTEM_CLOCK_APB2_DIV)
+
+/** @brief Timer kernel clocks in Hz: twice the bus clock whenever the bus is divided. */
+#define SYSTEM_CLOCK_APB1_TIMER_HZ  (SYSTEM_CLOCK_APB1_DIV == 1UL ? SYSTEM_CLOCK_APB1_HZ : 2UL * SYSTEM_CLOCK_APB1_HZ)
+#define SYSTEM_CLOCK_APB2_TIMER_HZ  (SYSTEM_CLOCK_APB2_DIV == 1UL ? SYSTEM_CLOCK_APB2_HZ : 2UL * SYSTEM_CLOCK_APB2_HZ)
+
+#endif // SYSTEM_CLOCK_H
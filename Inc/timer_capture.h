@@ -0,0 +1,92 @@
+/**
+ * @file      timer_capture.h
+ * @brief     Edge timestamping on up to four pins using timer input capture and DMA.
+ *
+ * @details   TIM5 free-runs as a 32-bit counter at the APB1 timer clock.
+ *            Each enabled channel latches the counter into its CCR on both
+ *            edges of its pin, and a DMA stream copies every capture into a
+ *            word ring in the capture arena. Nothing is stored while a line
+ *            is idle, and edges are resolved to one timer count (14 ns at
+ *            72 MHz). The poller merges the channels in time order onto the
+ *            common edge stream, converted to capture_timebase ticks.
+ *
+ *            Wiring (signal -> analyzer):
+ *              - Channel 0 -> PA0 (TIM5_CH1)
+ *              - Channel 1 -> PA1 (TIM5_CH2)
+ *              - Channel 2 -> PA2 (TIM5_CH3)
+ *              - Channel 3 -> PA3 (TIM5_CH4)
+ *
+ *            Edges are merged only once they are TIMER_CAPTURE_GUARD_TICKS
+ *            old, so a capture still in flight on one channel cannot be
+ *            overtaken by a later edge on another. A lost capture or a ring
+ *            overrun is reported as a level marker on that channel.
+ *            Scans from analog_capture, if running, are merged the same way.
+ */
+
+#ifndef TIMER_CAPTURE_H
+#define TIMER_CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "edge_stream.h"
+#include "system_clock.h"
+
+/** @brief Number of input-capture channels. */
+#define TIMER_CAPTURE_CHANNELS          4
+
+/** @brief TIM5 counter clock in Hz (APB1 timer clock). */
+#define TIMER_CAPTURE_TIMER_HZ          SYSTEM_CLOCK_APB1_TIMER_HZ
+
+/** @brief Upper bound for each channel's ring, in captures (a power of two). */
+#define TIMER_CAPTURE_MAX_RING_WORDS    4096U
+
+/** @brief Smallest usable ring; segment 0 must hold four of these. */
+#define TIMER_CAPTURE_MIN_RING_WORDS    64U
+
+/** @brief Age, in capture_timebase ticks, before an edge is merged (10 us). */
+#define TIMER_CAPTURE_GUARD_TICKS       (SYSTEM_CLOCK_HZ / 100000UL)
+
+/** @brief NVIC priority of the ring interrupts (FreeRTOS-safe). */
+#define TIMER_CAPTURE_IRQ_PRIORITY      (6 << 4)
+
+/**
+ * @brief Configures TIM5, the selected channels and their DMA rings, and starts capturing.
+ * @note Splits arena segment 0 into the rings and resets the edge stream,
+ *       so no other capture may be running.
+ *
+ * @param[in] channel_mask Bit n enables channel n (0 to 3).
+ * @param[in] filter Input filter for all channels, 0 (off) to 15.
+ * @param[in] decoder Decoder fed with the edges, or NULL to report them raw.
+ *
+ * @return 0 on success, -1 if already running, the arguments are invalid or
+ *         the arena is too small, -2 if a peripheral could not be claimed.
+ */
+int timer_capture_start(uint8_t channel_mask, uint8_t filter, const edge_decoder_t* decoder);
+
+/**
+ * @brief Stops capturing and releases every peripheral claimed by the mode.
+ */
+void timer_capture_stop(void);
+
+/**
+ * @brief Merges captured edges onto the edge stream and formats the next record, if any.
+ * @details Must be called from task context. Once every captured edge is
+ *          decoded, the decoder's flush() is called with the time captured
+ *          up to, so it can close what an idle line ends.
+ *
+ * @param[out] json_buffer Buffer receiving the JSON record.
+ * @param[in] json_buffer_size Size of the buffer in bytes.
+ *
+ * @return true if a record was written, false if nothing is pending.
+ */
+bool timer_capture_poll(char* json_buffer, size_t json_buffer_size);
+
+/**
+ * @brief Gets the size of each channel's ring for the current run.
+ * @return Ring size in captures, or 0 if the mode is not running.
+ */
+uint32_t timer_capture_get_ring_words(void);
+
+#endif // TIMER_CAPTURE_H
@@ -0,0 +1,87 @@
+/**
+ * @file      timing_check.h
+ * @brief     Glitch and timing-violation detector over the edge stream.
+ *
+ * @details   Rather than decoding traffic, this consumer of the edge stream
+ *            watches the timing of every transition and reports only the
+ *            anomalies, so it can run for hours on a busy bus. Timer input
+ *            capture timestamps each edge to one tick, so even glitches far
+ *            shorter than a sample period are seen; its input filter must be
+ *            0 for this. The checks are:
+ *              - glitch: a pulse on any channel shorter than min_pulse_ns.
+ *              - lost: edges dropped on a channel after it started, most
+ *                often a burst of glitches too fast to capture.
+ *              - setup: a data edge less than setup_ns before the clock edge
+ *                that samples it.
+ *              - hold: a data edge less than hold_ns after the clock edge it
+ *                must be held past; the sampling edge for SPI, and the
+ *                falling SCL edge for I2C, where SDA edges with SCL high are
+ *                START and STOP conditions and not checked.
+ *              - skew: channels of skew_mask that switch within
+ *                skew_window_ns of each other, as one transition, but spread
+ *                over more than skew_ns.
+ *            A limit of 0 turns its check off.
+ *
+ *            A flag opens a window holding the edges just before it, and
+ *            the window is reported once TIMING_CHECK_CONTEXT_EDGES more edges
+ *            have followed the last flag in it, it holds
+ *            TIMING_CHECK_MAX_WINDOW_EDGES edges, no edge has come for 10 ms,
+ *            or the capture stops:
+ *            {"timing":{"flags":[{"type":"glitch","t":time,"ch":n,"ticks":n,"limit":n},...],
+ *            "more":n,"edges":[[t,ch,level],...]}}
+ *            ticks is the measured width, gap or spread and limit the limit it
+ *            broke, both in capture timebase ticks. "more" counts the flags
+ *            beyond TIMING_CHECK_MAX_FLAGS. Edges are listed as in raw
+ *            `edges` records, level markers with a fourth element 1.
+ */
+
+#ifndef TIMING_CHECK_H
+#define TIMING_CHECK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "edge_stream.h"
+
+/** @brief Channels checked, numbered as on the edge stream. */
+#define TIMING_CHECK_MAX_CHANNELS       4U
+
+/** @brief Edges kept before the first flag and after the last one of a window. */
+#define TIMING_CHECK_CONTEXT_EDGES      8U
+
+/** @brief Most edges and flags per reported window. */
+#define TIMING_CHECK_MAX_WINDOW_EDGES   32U
+#define TIMING_CHECK_MAX_FLAGS          8U
+
+/** @brief Clocked bus checked for setup and hold. */
+typedef enum {
+    TIMING_BUS_NONE = 0,
+    TIMING_BUS_SPI,
+    TIMING_BUS_I2C,
+} timing_bus_t;
+
+/** @brief Detector settings; limits in ns, 0 to turn a check off. */
+typedef struct {
+    uint32_t min_pulse_ns;
+    timing_bus_t bus;
+    uint8_t clock_channel;      // SCK or SCL
+    uint8_t data_channel;       // MOSI, MISO or SDA
+    bool sample_falling;        // SPI: data sampled on falling clock edges
+    uint32_t setup_ns;
+    uint32_t hold_ns;
+    uint8_t skew_mask;          // Channels that switch together
+    uint32_t skew_ns;
+    uint32_t skew_window_ns;    // Largest gap between edges of one transition
+} timing_check_config_t;
+
+/** @brief The detector, to pass to a capture front-end as its decoder. */
+extern const edge_decoder_t timing_check_decoder;
+
+/**
+ * @brief Sets up the detector for the next capture.
+ * @param[in] config Settings.
+ * @return 0 on success, -1 if the settings are invalid.
+ */
+int timing_check_configure(const timing_check_config_t* config);
+
+#endif // TIMING_CHECK_H
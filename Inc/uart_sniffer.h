@@ -0,0 +1,93 @@
+/**
+ * @file      uart_sniffer.h
+ * @brief     Multi-Mbaud UART capture using spare USART receivers and circular DMA.
+ *
+ * @details   Two USART receivers listen to up to two UART lines (typically
+ *            the TX and RX of one target link). Each one feeds a circular DMA
+ *            ring in the capture arena. Received bytes are reported in chunks.
+ *            A chunk ends when the line goes idle or when the DMA passes half
+ *            or the end of the ring. Chunks are stamped with the capture
+ *            timebase. Parity, framing, noise and overrun errors, and breaks,
+ *            are reported as separate events with the position of the byte
+ *            they affected.
+ *
+ *            Wiring (target -> analyzer):
+ *              - Channel 0 -> PC7 (USART6_RX)
+ *              - Channel 1 -> PA3 (USART2_RX)
+ *
+ *            Both receivers use the same uart_config_t. Rates up to 4 Mbaud
+ *            are reachable: USART6 runs from APB2 and USART2 switches to 8x
+ *            oversampling above 2.6 Mbaud.
+ */
+
+#ifndef UART_SNIFFER_H
+#define UART_SNIFFER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "uart.h"
+
+/** @brief Number of UART lines captured at once. */
+#define UART_SNIFFER_CHANNELS           2
+
+/** @brief Upper bound for each DMA ring; rings are a power of two in size. */
+#define UART_SNIFFER_MAX_RING_BYTES     32768U
+
+/** @brief Smallest usable ring; the arena must provide at least this per channel. */
+#define UART_SNIFFER_MIN_RING_BYTES     256U
+
+/** @brief Number of chunk/error events buffered between the ISRs and the poller. */
+#define UART_SNIFFER_EVENT_QUEUE_LENGTH 64
+
+/** @brief Most data bytes per record; longer chunks are split across records. */
+#define UART_SNIFFER_MAX_RECORD_BYTES   512U
+
+/** @brief NVIC priority shared by the USART and ring interrupts (FreeRTOS-safe). */
+#define UART_SNIFFER_IRQ_PRIORITY       (6 << 4)
+
+/**
+ * @brief Configures both receivers and their DMA rings, and starts listening.
+ * @note Uses arena segments 0 and 1 as the rings, so the arena must be split
+ *       into at least two segments and no other capture may be running.
+ *
+ * @param[in] config Line settings shared by both channels. `word_length`
+ *                   counts the data bits only; a parity bit is added for it.
+ *
+ * @return 0 on success, -1 if already running, the arguments are invalid or
+ *         the arena is too small, -2 if a peripheral could not be claimed.
+ */
+int uart_sniffer_start(const uart_config_t* config);
+
+/**
+ * @brief Stops listening and releases every peripheral claimed by the sniffer.
+ */
+void uart_sniffer_stop(void);
+
+/**
+ * @brief Formats the next chunk or error record, if any.
+ *
+ * @details Chunks are formatted as
+ *          `{"uart_sniff":{"ch":..,"pos":..,"t_start":..,"t_end":..,"len":..,"data":".."}}`.
+ *          `pos` is the index of the first byte in the channel's stream. The
+ *          times are in capture_timebase ticks and are derived from the
+ *          time the chunk ended and the frame duration at the configured
+ *          rate. Errors are formatted as
+ *          `{"uart_sniff":{"ch":..,"pos":..,"t":..,"errors":[..]}}`.
+ *          Must be called from task context.
+ *
+ * @param[out] json_buffer Buffer receiving the JSON record.
+ * @param[in] json_buffer_size Size of the buffer in bytes.
+ *
+ * @return true if a record was written, false if nothing is pending.
+ */
+bool uart_sniffer_poll(char* json_buffer, size_t json_buffer_size);
+
+/**
+ * @brief Gets the size of each DMA ring for the current run.
+ * @return Ring size in bytes, or 0 if the sniffer is not running.
+ */
+uint32_t uart_sniffer_get_ring_bytes(void);
+
+#endif // UART_SNIFFER_H
@@ -0,0 +1,65 @@
+/**
+ * @file      ws2812_decoder.h
+ * @brief     WS2812 (addressable LED) stream decoder fed from the edge stream.
+ *
+ * @details   Decodes one single-wire NRZ LED data line, normally captured by
+ *            SPI_SAMPLE at a rate of several MHz. Each high pulse is one bit:
+ *            shorter than the threshold is a 0 (T0H), longer a 1 (T1H).
+ *            Every 24 bits, MSB first, form a pixel in the order the LEDs
+ *            receive it (G, R, B). A low time of at least the reset time
+ *            latches the frame.
+ *
+ *            Pixels are reported in runs of consecutive pixels, each run as
+ *            {"ws2812":{"frame":n,"first":index,"pixels":"GGRRBB..."}}.
+ *            A run is cut at WS2812_DECODER_RUN_PIXELS pixels, so runs stay
+ *            within one output record. The frame is closed by
+ *            {"ws2812_frame":{"t":time,"frame":n,"pixels":n,"changed":n,"first":index,"data":"GGRRBB..."}},
+ *            which carries the last run; its t is the time of the frame's first
+ *            bit in capture timebase ticks. A frame is closed once the line
+ *            has stayed low for the latch time, or when the capture stops.
+ *
+ *            With diffing on, only the pixels that differ from the previous
+ *            frame are sent, so a mostly static animation costs little more
+ *            than one frame record per frame. The first frame is sent whole.
+ *            Pixels beyond WS2812_DECODER_MAX_PIXELS are counted but not sent.
+ */
+
+#ifndef WS2812_DECODER_H
+#define WS2812_DECODER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "edge_stream.h"
+
+/** @brief Most pixels per frame that are decoded and compared. */
+#define WS2812_DECODER_MAX_PIXELS           1024U
+
+/** @brief Most pixels per run record. */
+#define WS2812_DECODER_RUN_PIXELS           128U
+
+/** @brief Default 0/1 high-time threshold in ns (T0H 400, T1H 800 at 800 kHz). */
+#define WS2812_DECODER_DEFAULT_THRESHOLD_NS 600U
+
+/** @brief Default latch (reset) low time in us. */
+#define WS2812_DECODER_DEFAULT_RESET_US     50U
+
+/** @brief Decoder settings. */
+typedef struct {
+    uint8_t channel;            // Edge-stream channel of the data line
+    uint32_t threshold_ns;      // High times from this on are a 1
+    uint32_t reset_us;          // Low time that latches a frame
+    bool diff;                  // Send only the pixels changed since the previous frame
+} ws2812_decoder_config_t;
+
+/** @brief The decoder, to pass to a capture front-end. */
+extern const edge_decoder_t ws2812_decoder;
+
+/**
+ * @brief Sets up the decoder for the next capture.
+ * @param[in] config Decoder settings.
+ * @return 0 on success, -1 if the settings are invalid.
+ */
+int ws2812_decoder_configure(const ws2812_decoder_config_t* config);
+
+#endif // WS2812_DECODER_H
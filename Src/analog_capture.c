@@ -0,0 +1,276 @@
+/**
+ * @file      analog_capture.c
+ * @brief     ADC scan capture interleaved with the digital edge stream.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "analog_capture.h"
+#include "capture_arena.h"
+#include "capture_timebase.h"
+#include "dma_ring.h"
+#include "edge_stream.h"
+#include "nvic.h"
+#include "dma.h"
+#include "gpio.h"
+#include "timer.h"
+
+#define GPIO_PORT_C             2
+#define ANALOG_PIN_MASK         0x000FU // PC0..PC3
+
+#define ANALOG_ADC_NUM          1
+#define PACING_TIMER_NUM        8       // Clocked at CAPTURE_TIMEBASE_HZ
+
+#if SYSTEM_CLOCK_APB2_TIMER_HZ != SYSTEM_CLOCK_HZ
+#error "TIM8 must count capture_timebase ticks, or scan times no longer follow from their index"
+#endif
+
+// ADC1 on DMA2 Stream4 Ch0
+#define ANALOG_DMA_NUM          2
+#define ANALOG_STREAM_NUM       4
+#define ANALOG_CHANNEL          0
+#define ANALOG_IRQN             60      // DMA2_Stream4_IRQn
+#define WATCHDOG_IRQN           18      // ADC_IRQn
+
+static const uint8_t s_adc_channels[ANALOG_CAPTURE_MAX_CHANNELS] = { 10, 11, 12, 13 };
+
+// ADC clocks per conversion, indexed by adc_sample_time_t / adc_resolution_t
+static const uint16_t s_sample_cycles[] = { 3, 15, 28, 56, 84, 112, 144, 480 };
+static const uint8_t s_resolution_cycles[] = { 12, 10, 8, 6 };
+
+// --- Static Data ---
+static adc_handle_t s_adc = NULL;
+static timer_handle_t s_timer = NULL;
+static gpio_handle_t s_pins = NULL;
+static dma_ring_t s_ring;
+static uint8_t s_channel_count = 0;
+static uint32_t s_ticks_per_scan = 0;
+static uint32_t s_read_pos = 0;     // Ring position of the next scan to merge
+static volatile uint32_t s_next_time = 0;   // Trigger time of that scan; read by the watchdog ISR
+static bool s_watchdog_armed = false;
+static bool s_running = false;
+
+// --- Private Helper Functions ---
+
+static void ring_callback(dma_handle_t dma, void* user_data) {
+    (void)dma;
+    (void)user_data;
+    dma_ring_handle_wrap(&s_ring);
+}
+
+static void skip_scans(uint32_t count) {
+    s_read_pos += count * s_channel_count;
+    s_next_time += count * s_ticks_per_scan;
+}
+
+/**
+ * @brief Gets the trigger time of the latest scan started by `now`.
+ * @details Measured from the next scan to merge, which is never far from
+ *          `now`, so the arithmetic stays clear of timebase wraps.
+ */
+static uint32_t latest_scan_time(uint32_t now) {
+    uint32_t reference = s_next_time;
+    if ((int32_t)(now - reference) >= 0) {
+        return reference + ((now - reference) / s_ticks_per_scan) * s_ticks_per_scan;
+    }
+    return reference - ((reference - now + s_ticks_per_scan - 1U) / s_ticks_per_scan) * s_ticks_per_scan;
+}
+
+/**
+ * @brief Fires the edge stream trigger on the first scan outside the window.
+ * @note Runs in the ADC interrupt, at the end of the guarded conversion.
+ */
+static void watchdog_callback(adc_handle_t adc, void* user_data) {
+    (void)user_data;
+    adc_disable_watchdog(adc);
+    edge_stream_trigger(latest_scan_time(capture_timebase_now()));
+}
+
+/**
+ * @brief Gets the ring write position, first skipping past scans the DMA has overwritten.
+ */
+static uint32_t catch_up(void) {
+    taskENTER_CRITICAL();
+    uint32_t available = dma_ring_position(&s_ring);
+    taskEXIT_CRITICAL();
+
+    // Resume half a ring behind the DMA, on a scan boundary
+    uint32_t lag = available - s_read_pos;
+    if (lag > s_ring.length) {
+        skip_scans((lag - s_ring.length / 2U) / s_channel_count + 1U);
+    }
+    return available;
+}
+
+// --- Public API Function Implementations ---
+
+int analog_capture_start(const adc_config_t* config, uint8_t channel_count, uint32_t rate_hz) {
+    if (s_running || config == NULL || channel_count == 0 || channel_count > ANALOG_CAPTURE_MAX_CHANNELS ||
+        rate_hz == 0 || rate_hz > ANALOG_CAPTURE_MAX_RATE_HZ ||
+        config->resolution > ADC_RESOLUTION_6_BIT || config->default_sample_time > ADC_SAMPLE_TIME_480_CYCLES ||
+        capture_arena_get_segment_count() < CAPTURE_ARENA_MIN_SEGMENTS) {
+        return -1;
+    }
+
+    // Every scan must finish converting before the next trigger
+    uint32_t scan_cycles = channel_count *
+        (s_sample_cycles[config->default_sample_time] + s_resolution_cycles[config->resolution]);
+    if (rate_hz * scan_cycles > ANALOG_CAPTURE_ADC_HZ) {
+        return -1;
+    }
+
+    uint32_t ring_samples = dma_ring_fit_length(capture_arena_get_segment_samples(), ANALOG_CAPTURE_MAX_RING_SAMPLES);
+    if (ring_samples < ANALOG_CAPTURE_MIN_RING_SAMPLES) {
+        return -1;
+    }
+
+    // TIM8 is 16-bit: prescale long periods, and time scans by the period actually used
+    uint32_t ticks = CAPTURE_TIMEBASE_HZ / rate_hz;
+    uint32_t prescaler = (ticks - 1U) / 0x10000U;
+    uint32_t period = ticks / (prescaler + 1U);
+    s_ticks_per_scan = (prescaler + 1U) * period;
+    s_channel_count = channel_count;
+    s_read_pos = 0;
+    capture_timebase_init();
+
+    const timer_config_t tim_cfg = {
+        .prescaler = prescaler,
+        .period = period - 1U,
+    };
+    const gpio_config_t pin_cfg = {
+        .mode = GPIO_MODE_ANALOG,
+        .pull = GPIO_PULL_NONE,
+        .output_type = GPIO_OUTPUT_TYPE_PUSH_PULL,
+        .speed = GPIO_SPEED_LOW,
+        .alternate_function = 0,
+    };
+    const dma_config_t dma_cfg = {
+        .channel = ANALOG_CHANNEL,
+        .direction = DMA_DIRECTION_PERIPHERAL_TO_MEMORY,
+        .priority = DMA_PRIORITY_HIGH,
+        .peripheral_data_size = DMA_DATA_SIZE_16_BIT,
+        .memory_data_size = DMA_DATA_SIZE_16_BIT,
+        .peripheral_increment = false,
+        .memory_increment = true,
+        .circular_mode = true,
+        .fifo_mode = false,
+        .fifo_threshold = DMA_FIFO_THRESHOLD_1_4,
+        .memory_burst = DMA_BURST_SINGLE,
+        .peripheral_burst = DMA_BURST_SINGLE,
+    };
+
+    s_running = true;
+    s_pins = gpio_init(GPIO_PORT_C, ANALOG_PIN_MASK & ((1U << channel_count) - 1U), &pin_cfg);
+    s_adc = adc_init(ANALOG_ADC_NUM, config);
+    s_timer = timer_init(PACING_TIMER_NUM, &tim_cfg);
+    dma_handle_t dma = dma_init(ANALOG_DMA_NUM, ANALOG_STREAM_NUM, &dma_cfg);
+    s_ring.dma = dma;
+    if (s_pins == NULL || s_adc == NULL || s_timer == NULL || dma == NULL) {
+        analog_capture_stop();
+        return -2;
+    }
+
+    dma_set_callback(dma, ring_callback, NULL);
+    nvic_set_priority(ANALOG_IRQN, ANALOG_CAPTURE_IRQ_PRIORITY);
+    nvic_enable_irq(ANALOG_IRQN);
+
+    // Arm the ring and the ADC before the first update event
+    timer_set_trigger_output(s_timer, TIMER_TRGO_UPDATE);
+    dma_ring_start(&s_ring, dma, adc_get_data_register(s_adc),
+                   (uint8_t*)capture_arena_get_segment(capture_arena_get_segment_count() - 1U), ring_samples);
+    adc_start_scan(s_adc, s_adc_channels, channel_count, ADC_TRIGGER_TIM8_TRGO);
+
+    // The first scan is triggered one full period after the counter starts
+    taskENTER_CRITICAL();
+    timer_start(s_timer);
+    s_next_time = capture_timebase_now() + s_ticks_per_scan;
+    taskEXIT_CRITICAL();
+    return 0;
+}
+
+void analog_capture_stop(void) {
+    if (!s_running) {
+        return;
+    }
+
+    if (s_watchdog_armed) {
+        nvic_disable_irq(WATCHDOG_IRQN);
+        adc_disable_watchdog(s_adc);
+        s_watchdog_armed = false;
+    }
+    nvic_disable_irq(ANALOG_IRQN);
+    if (s_timer) {
+        timer_stop(s_timer);
+    }
+    if (s_adc) {
+        adc_stop_scan(s_adc);
+    }
+    dma_deinit(&s_ring.dma);
+    timer_deinit(&s_timer);
+    adc_deinit(&s_adc);
+    gpio_deinit(&s_pins);
+
+    s_ring.length = 0;
+    s_channel_count = 0;
+    s_running = false;
+}
+
+int analog_capture_arm_watchdog(uint8_t input, uint16_t low_threshold, uint16_t high_threshold) {
+    if (!s_running || s_watchdog_armed || input >= s_channel_count) {
+        return -1;
+    }
+
+    const adc_watchdog_config_t watchdog_cfg = {
+        .channel = s_adc_channels[input],
+        .low_threshold = low_threshold,
+        .high_threshold = high_threshold,
+    };
+    if (adc_enable_watchdog(s_adc, &watchdog_cfg, watchdog_callback, NULL) != 0) {
+        return -1;
+    }
+
+    s_watchdog_armed = true;
+    nvic_set_priority(WATCHDOG_IRQN, ANALOG_CAPTURE_IRQ_PRIORITY);
+    nvic_enable_irq(WATCHDOG_IRQN);
+    return 0;
+}
+
+bool analog_capture_next_time(uint32_t* time) {
+    if (!s_running) {
+        return false;
+    }
+
+    catch_up();
+    *time = s_next_time;
+    return true;
+}
+
+bool analog_capture_push_next(void) {
+    if (!s_running) {
+        return false;
+    }
+
+    uint32_t available = catch_up();
+    if (available - s_read_pos < s_channel_count || edge_stream_free() < s_channel_count) {
+        return false;
+    }
+
+    uint16_t readings[ANALOG_CAPTURE_MAX_CHANNELS];
+    for (uint8_t i = 0; i < s_channel_count; ++i) {
+        readings[i] = dma_ring_halfword_at(&s_ring, s_read_pos + i);
+    }
+
+    // The DMA may have lapped the scan while it was read; drop it if so
+    if (!dma_ring_is_overwritten(&s_ring, s_read_pos)) {
+        for (uint8_t i = 0; i < s_channel_count; ++i) {
+            edge_stream_push(s_next_time, i, readings[i], EDGE_FLAG_ANALOG);
+        }
+    }
+    skip_scans(1);
+    return true;
+}
+
+uint32_t analog_capture_get_ring_samples(void) {
+    return s_running ? s_ring.length : 0;
+}
@@ -0,0 +1,441 @@
+/**
+ * @file      can_decoder.c
+ * @brief     CAN 2.0A/B frame decoder fed from the edge stream.
+ */
+
+#include <stdio.h>
+
+#include "can_decoder.h"
+#include "capture_timebase.h"
+
+#define CAN_MIN_BITRATE         1000U
+#define CAN_MAX_BITRATE         1000000U
+#define CAN_IDLE_BITS           11U     // Recessive bits that end a frame or an error frame
+#define CAN_STUFF_LIMIT         5U
+#define CAN_CRC_POLYNOMIAL      0x4599U
+#define CAN_MAX_DATA_BYTES      8U
+
+typedef enum {
+    CAN_STATE_IDLE,         // Bus idle: no bit clock until a start-of-frame edge
+    CAN_STATE_FRAME,
+    CAN_STATE_WAIT_IDLE,    // After a frame or an error, until the bus is idle again
+} can_state_t;
+
+typedef enum {
+    FIELD_SOF,
+    FIELD_ID_A,
+    FIELD_SRR_RTR,
+    FIELD_IDE,
+    FIELD_ID_B,
+    FIELD_RTR,
+    FIELD_RESERVED,
+    FIELD_DLC,
+    FIELD_DATA,
+    FIELD_CRC,              // Last stuffed field
+    FIELD_CRC_DELIMITER,
+    FIELD_ACK_SLOT,
+    FIELD_ACK_DELIMITER,
+} can_field_t;
+
+typedef enum {
+    CAN_ERROR_STUFF = 0,
+    CAN_ERROR_CRC,
+    CAN_ERROR_FORM,
+    CAN_ERROR_ACK,
+    CAN_ERROR_COUNT,
+} can_error_t;
+
+static const char* const s_error_names[CAN_ERROR_COUNT] = { "stuff", "crc", "form", "ack" };
+
+typedef struct {
+    uint32_t start_time;
+    uint32_t id;
+    uint8_t ext;
+    uint8_t rtr;
+    uint8_t dlc;
+    uint8_t data_length;    // Data bytes carried, from the DLC
+    uint8_t data_count;     // Data bytes received so far
+    uint8_t data[CAN_MAX_DATA_BYTES];
+} can_frame_t;
+
+// --- Static Data ---
+static can_decoder_config_t s_config = {
+    .channel = 0,
+    .bitrate = 500000,
+    .id_mask = 0,
+    .id_match = 0,
+    .id_min = 0,
+    .id_max = CAN_DECODER_MAX_ID,
+};
+static uint32_t s_ticks_per_bit = CAPTURE_TIMEBASE_HZ / 500000U;
+static uint32_t s_sample_offset = (CAPTURE_TIMEBASE_HZ / 500000U) * CAN_DECODER_SAMPLE_POINT_PCT / 100U;
+static uint32_t s_sjw = (CAPTURE_TIMEBASE_HZ / 500000U) * CAN_DECODER_SJW_PCT / 100U;
+
+static can_state_t s_state = CAN_STATE_IDLE;
+static uint8_t s_level = 1;
+static bool s_clocked = false;          // s_next_sample is valid
+static uint32_t s_next_sample = 0;
+static uint32_t s_recessive_bits = 0;   // Consecutive recessive bits while waiting for idle
+
+static can_field_t s_field = FIELD_SOF;
+static uint8_t s_field_left = 0;        // Bits still to collect in the field
+static uint32_t s_value = 0;
+static uint8_t s_run_bit = 0xFF;        // Level and length of the current run, for destuffing
+static uint8_t s_run_length = 0;
+static uint16_t s_crc = 0;
+static can_frame_t s_frame;
+
+static uint32_t s_errors[CAN_ERROR_COUNT];
+
+static char* s_out = NULL;              // Buffer of the feed call in progress
+static size_t s_out_size = 0;
+static bool s_written = false;
+
+// --- Private Helper Functions ---
+
+static bool is_older(uint32_t time, uint32_t reference) {
+    return (int32_t)(time - reference) < 0;
+}
+
+static void wait_idle(void) {
+    s_state = CAN_STATE_WAIT_IDLE;
+    s_recessive_bits = 0;
+}
+
+static void report_error(can_error_t type) {
+    s_errors[type]++;
+    if (!s_written) {
+        snprintf(s_out, s_out_size,
+                 "{\"can_error\":{\"t\":%lu,\"type\":\"%s\",\"stuff\":%lu,\"crc\":%lu,\"form\":%lu,\"ack\":%lu}}",
+                 (unsigned long)s_frame.start_time, s_error_names[type],
+                 (unsigned long)s_errors[CAN_ERROR_STUFF], (unsigned long)s_errors[CAN_ERROR_CRC],
+                 (unsigned long)s_errors[CAN_ERROR_FORM], (unsigned long)s_errors[CAN_ERROR_ACK]);
+        s_written = true;
+    }
+    wait_idle();
+}
+
+static bool passes_filter(uint32_t id) {
+    return ((id ^ s_config.id_match) & s_config.id_mask) == 0 && id >= s_config.id_min && id <= s_config.id_max;
+}
+
+static void finish_frame(void) {
+    if (!s_written && passes_filter(s_frame.id)) {
+        static const char hex_digits[] = "0123456789ABCDEF";
+        char data[CAN_MAX_DATA_BYTES * 2 + 1];
+        for (uint8_t i = 0; i < s_frame.data_length; ++i) {
+            data[i * 2] = hex_digits[s_frame.data[i] >> 4];
+            data[i * 2 + 1] = hex_digits[s_frame.data[i] & 0x0F];
+        }
+        data[s_frame.data_length * 2] = '\0';
+
+        snprintf(s_out, s_out_size,
+                 "{\"can\":{\"t\":%lu,\"id\":%lu,\"ext\":%u,\"rtr\":%u,\"dlc\":%u,\"data\":\"%s\"}}",
+                 (unsigned long)s_frame.start_time, (unsigned long)s_frame.id,
+                 s_frame.ext, s_frame.rtr, s_frame.dlc, data);
+        s_written = true;
+    }
+    wait_idle();
+}
+
+static void start_field(can_field_t field, uint8_t bits) {
+    s_field = field;
+    s_field_left = bits;
+    s_value = 0;
+}
+
+/**
+ * @brief Shifts a bit into the field value.
+ * @return true once the field is complete.
+ */
+static bool collect(uint8_t bit) {
+    s_value = (s_value << 1) | bit;
+    return --s_field_left == 0;
+}
+
+static void start_frame(uint32_t time) {
+    s_state = CAN_STATE_FRAME;
+    s_frame.start_time = time;
+    s_frame.data_length = 0;
+    s_frame.data_count = 0;
+    s_run_bit = 0xFF;
+    s_run_length = 0;
+    s_crc = 0;
+    start_field(FIELD_SOF, 1);
+}
+
+/**
+ * @brief Handles one destuffed bit of the frame.
+ */
+static void field_bit(uint8_t bit) {
+    // CRC-15 covers the start of frame through the data field
+    if (s_field <= FIELD_DATA) {
+        uint8_t next = bit ^ (uint8_t)(s_crc >> 14);
+        s_crc = (uint16_t)((s_crc << 1) & 0x7FFFU);
+        if (next) {
+            s_crc ^= CAN_CRC_POLYNOMIAL;
+        }
+    }
+
+    switch (s_field) {
+        case FIELD_SOF:
+            start_field(FIELD_ID_A, 11);
+            break;
+        case FIELD_ID_A:
+            if (collect(bit)) {
+                s_frame.id = s_value;
+                start_field(FIELD_SRR_RTR, 1);
+            }
+            break;
+        case FIELD_SRR_RTR:
+            s_frame.rtr = bit;                      // SRR in an extended frame
+            start_field(FIELD_IDE, 1);
+            break;
+        case FIELD_IDE:
+            s_frame.ext = bit;
+            if (bit) {
+                start_field(FIELD_ID_B, 18);
+            } else {
+                start_field(FIELD_RESERVED, 1);     // r0
+            }
+            break;
+        case FIELD_ID_B:
+            if (collect(bit)) {
+                s_frame.id = (s_frame.id << 18) | s_value;
+                start_field(FIELD_RTR, 1);
+            }
+            break;
+        case FIELD_RTR:
+            s_frame.rtr = bit;
+            start_field(FIELD_RESERVED, 2);         // r1, r0
+            break;
+        case FIELD_RESERVED:
+            if (collect(bit)) {
+                start_field(FIELD_DLC, 4);
+            }
+            break;
+        case FIELD_DLC:
+            if (collect(bit)) {
+                s_frame.dlc = (uint8_t)s_value;
+                if (!s_frame.rtr) {
+                    s_frame.data_length = s_frame.dlc < CAN_MAX_DATA_BYTES ? s_frame.dlc : CAN_MAX_DATA_BYTES;
+                }
+                if (s_frame.data_length > 0) {
+                    start_field(FIELD_DATA, 8);
+                } else {
+                    start_field(FIELD_CRC, 15);
+                }
+            }
+            break;
+        case FIELD_DATA:
+            if (collect(bit)) {
+                s_frame.data[s_frame.data_count++] = (uint8_t)s_value;
+                if (s_frame.data_count < s_frame.data_length) {
+                    start_field(FIELD_DATA, 8);
+                } else {
+                    start_field(FIELD_CRC, 15);
+                }
+            }
+            break;
+        case FIELD_CRC:
+            if (collect(bit)) {
+                if (s_value != s_crc) {
+                    report_error(CAN_ERROR_CRC);
+                } else {
+                    start_field(FIELD_CRC_DELIMITER, 1);
+                }
+            }
+            break;
+        case FIELD_CRC_DELIMITER:
+            if (!bit) {
+                report_error(CAN_ERROR_FORM);
+            } else {
+                start_field(FIELD_ACK_SLOT, 1);
+            }
+            break;
+        case FIELD_ACK_SLOT:
+            if (bit) {
+                report_error(CAN_ERROR_ACK);
+            } else {
+                start_field(FIELD_ACK_DELIMITER, 1);
+            }
+            break;
+        case FIELD_ACK_DELIMITER:
+            // A recessive delimiter is normally taken at its edge, in can_feed()
+            if (!bit) {
+                report_error(CAN_ERROR_FORM);
+            } else {
+                finish_frame();
+                s_recessive_bits = 1;
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Handles one sampled bit of the frame, removing stuff bits.
+ */
+static void take_bit(uint8_t bit) {
+    // A stuff bit may follow the last CRC bit too
+    if (s_field <= FIELD_CRC || (s_field == FIELD_CRC_DELIMITER && s_run_length == CAN_STUFF_LIMIT)) {
+        if (s_run_length == CAN_STUFF_LIMIT) {
+            if (bit == s_run_bit) {
+                report_error(CAN_ERROR_STUFF);
+                return;
+            }
+            s_run_bit = bit;
+            s_run_length = 1;
+            return;
+        }
+        if (bit == s_run_bit) {
+            s_run_length++;
+        } else {
+            s_run_bit = bit;
+            s_run_length = 1;
+        }
+    }
+    field_bit(bit);
+}
+
+/**
+ * @brief Takes every sample point before `until` at the current line level.
+ */
+static void run_samples(uint32_t until) {
+    while (s_clocked && is_older(s_next_sample, until)) {
+        if (s_state == CAN_STATE_WAIT_IDLE) {
+            // The level holds until the next edge, so count its bits at once
+            if (!s_level) {
+                s_recessive_bits = 0;
+                s_clocked = false;                  // Resynchronised by the next edge
+                return;
+            }
+            uint32_t bits = (until - s_next_sample - 1U) / s_ticks_per_bit + 1U;
+            s_recessive_bits += bits;
+            if (s_recessive_bits >= CAN_IDLE_BITS) {
+                s_state = CAN_STATE_IDLE;
+                s_clocked = false;
+                return;
+            }
+            s_next_sample += bits * s_ticks_per_bit;
+            return;
+        }
+
+        take_bit(s_level);
+        s_next_sample += s_ticks_per_bit;
+    }
+}
+
+// --- Decoder Interface ---
+
+static void can_reset(void) {
+    s_state = CAN_STATE_IDLE;
+    s_level = 1;
+    s_clocked = false;
+    s_recessive_bits = 0;
+    for (uint8_t i = 0; i < CAN_ERROR_COUNT; ++i) {
+        s_errors[i] = 0;
+    }
+}
+
+static bool can_feed(const edge_t* edge, char* json_buffer, size_t json_buffer_size) {
+    if (edge->channel != s_config.channel) {
+        return false;
+    }
+
+    s_out = json_buffer;
+    s_out_size = json_buffer_size;
+    s_written = false;
+    uint8_t level = edge->level ? 1U : 0U;
+
+    if (edge->flags & EDGE_FLAG_SYNC) {
+        // The line state is known again but not the bit position: wait for idle
+        s_level = level;
+        wait_idle();
+        s_next_sample = edge->time + s_sample_offset;
+        s_clocked = true;
+        return false;
+    }
+
+    run_samples(edge->time);
+    if (level == s_level) {
+        return s_written;
+    }
+    s_level = level;
+
+    switch (s_state) {
+        case CAN_STATE_IDLE:
+            if (!level) {
+                // Hard synchronisation on the start of frame
+                start_frame(edge->time);
+                s_next_sample = edge->time + s_sample_offset;
+                s_clocked = true;
+            }
+            break;
+        case CAN_STATE_WAIT_IDLE:
+            // Bit positions do not matter here; restart the count from the edge
+            s_recessive_bits = 0;
+            s_next_sample = edge->time + s_sample_offset;
+            s_clocked = true;
+            break;
+        case CAN_STATE_FRAME:
+            if (!level) {
+                // Soft synchronisation: move the sample point by the phase error, within the SJW
+                int32_t error = (int32_t)(edge->time - (s_next_sample - s_sample_offset));
+                if (error > (int32_t)s_sjw) {
+                    error = (int32_t)s_sjw;
+                } else if (error < -(int32_t)s_sjw) {
+                    error = -(int32_t)s_sjw;
+                }
+                s_next_sample += (uint32_t)error;
+            } else if (s_field == FIELD_ACK_DELIMITER) {
+                // The frame's last edge: report it now rather than at the next frame
+                finish_frame();
+                s_next_sample = edge->time + s_sample_offset;
+            }
+            break;
+    }
+    return s_written;
+}
+
+static bool can_flush(uint32_t now, bool final, char* json_buffer, size_t json_buffer_size) {
+    if (s_state != CAN_STATE_FRAME) {
+        return false;
+    }
+
+    s_out = json_buffer;
+    s_out_size = json_buffer_size;
+    s_written = false;
+
+    // The level holds until the next edge, so a missing ACK or a stuck line shows up now
+    run_samples(now);
+
+    // The capture ended inside the frame
+    if (final && s_state == CAN_STATE_FRAME) {
+        report_error(CAN_ERROR_FORM);
+    }
+    return s_written;
+}
+
+const edge_decoder_t can_decoder = {
+    .name = "can",
+    .reset = can_reset,
+    .feed = can_feed,
+    .flush = can_flush,
+};
+
+// --- Public API Function Implementations ---
+
+int can_decoder_configure(const can_decoder_config_t* config) {
+    // Invalid arguments
+    if (config == NULL || config->bitrate < CAN_MIN_BITRATE || config->bitrate > CAN_MAX_BITRATE ||
+        config->id_min > config->id_max) {
+        return -1;
+    }
+
+    s_config = *config;
+    s_ticks_per_bit = CAPTURE_TIMEBASE_HZ / config->bitrate;
+    s_sample_offset = s_ticks_per_bit * CAN_DECODER_SAMPLE_POINT_PCT / 100U;
+    s_sjw = s_ticks_per_bit * CAN_DECODER_SJW_PCT / 100U;
+    can_reset();
+    return 0;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file      capture_arena.c
+ * @brief     Capture-memory manager for the DMA sample buffers.
+ */
+
+#include "capture_arena.h"
+
+// Symbols defined in the linker script
+extern uint8_t _scapture_arena;
+extern uint8_t _ecapture_arena;
+
+// --- Static Data ---
+static uint8_t* s_arena_base = NULL;
+static size_t s_arena_size = 0;
+static uint8_t s_segment_count = 0;
+static uint32_t s_segment_samples = 0;
+
+// --- Public API Function Implementations ---
+
+void capture_arena_init(void) {
+    uintptr_t start = (uintptr_t)&_scapture_arena;
+    uintptr_t end = (uintptr_t)&_ecapture_arena;
+
+    // Round inwards so every segment starts on an aligned address
+    start = (start + CAPTURE_ARENA_SEGMENT_ALIGN - 1U) & ~(uintptr_t)(CAPTURE_ARENA_SEGMENT_ALIGN - 1U);
+    end &= ~(uintptr_t)(CAPTURE_ARENA_SEGMENT_ALIGN - 1U);
+
+    s_arena_base = (uint8_t*)start;
+    s_arena_size = (end > start) ? (size_t)(end - start) : 0;
+
+    capture_arena_configure(CAPTURE_ARENA_DEEP_SEGMENTS);
+}
+
+bool capture_arena_configure(uint8_t segment_count) {
+    if (segment_count < CAPTURE_ARENA_MIN_SEGMENTS || segment_count > CAPTURE_ARENA_MAX_SEGMENTS) {
+        return false;
+    }
+
+    size_t segment_bytes = (s_arena_size / segment_count) & ~(size_t)(CAPTURE_ARENA_SEGMENT_ALIGN - 1U);
+    uint32_t samples = (uint32_t)(segment_bytes / sizeof(capture_sample_t));
+    if (samples > CAPTURE_ARENA_MAX_SEGMENT_SAMPLES) {
+        samples = CAPTURE_ARENA_MAX_SEGMENT_SAMPLES;
+    }
+    if (samples == 0) {
+        return false;
+    }
+
+    s_segment_count = segment_count;
+    s_segment_samples = samples;
+    return true;
+}
+
+capture_sample_t* capture_arena_get_segment(uint8_t index) {
+    if (index >= s_segment_count) {
+        return NULL;
+    }
+    return (capture_sample_t*)s_arena_base + ((uint32_t)index * s_segment_samples);
+}
+
+uint8_t capture_arena_get_segment_count(void) {
+    return s_segment_count;
+}
+
+uint32_t capture_arena_get_segment_samples(void) {
+    return s_segment_samples;
+}
+
+uint32_t capture_arena_get_depth(void) {
+    return (uint32_t)s_segment_count * s_segment_samples;
+}
+
+size_t capture_arena_get_size_bytes(void) {
+    return s_arena_size;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file      dispatch_bench.c
+ * @brief     On-target cycle count of the driver hot-path calls.
+ */
+
+#include <stdio.h>
+
+#include "dispatch_bench.h"
+#include "dwt.h"
+#include "dma.h"
+#include "dma_config.h"
+
+// Same stream as the DMA throughput test; it is idle outside of that test
+#define DISPATCH_BENCH_DMA_NUM      2
+#define DISPATCH_BENCH_STREAM_NUM   1
+
+#if DMA_PORT_STATIC
+#define DISPATCH_BENCH_BINDING      "static"
+#else
+#define DISPATCH_BENCH_BINDING      "vtable"
+#endif
+
+// Keeps the compiler from merging or removing loop iterations
+#define COMPILER_BARRIER()          __asm volatile ("" ::: "memory")
+
+// --- Private Helper Functions ---
+
+static uint32_t time_empty_loop(void) {
+    uint32_t start = dwt_get_cycles();
+    for (uint32_t i = 0; i < DISPATCH_BENCH_ITERATIONS; ++i) {
+        COMPILER_BARRIER();
+    }
+    return dwt_get_cycles() - start;
+}
+
+/**
+ * @brief Times the flag handling every DMA ISR performs: test, then clear.
+ */
+static uint32_t time_flag_service(dma_handle_t dma) {
+    volatile bool pending;
+    uint32_t start = dwt_get_cycles();
+    for (uint32_t i = 0; i < DISPATCH_BENCH_ITERATIONS; ++i) {
+        pending = dma_is_interrupt_flag_set(dma, DMA_INTERRUPT_TRANSFER_COMPLETE);
+        dma_clear_interrupt_flag(dma, DMA_INTERRUPT_TRANSFER_COMPLETE);
+        COMPILER_BARRIER();
+    }
+    (void)pending;
+    return dwt_get_cycles() - start;
+}
+
+static uint32_t time_current_buffer(dma_handle_t dma) {
+    volatile uint8_t target;
+    uint32_t start = dwt_get_cycles();
+    for (uint32_t i = 0; i < DISPATCH_BENCH_ITERATIONS; ++i) {
+        target = dma_get_current_buffer(dma);
+        COMPILER_BARRIER();
+    }
+    (void)target;
+    return dwt_get_cycles() - start;
+}
+
+static uint32_t per_call(uint32_t total, uint32_t baseline) {
+    return (total > baseline) ? (total - baseline) / DISPATCH_BENCH_ITERATIONS : 0;
+}
+
+// --- Public API Function Implementations ---
+
+void dispatch_bench_run(char* json_buffer, size_t json_buffer_size) {
+    const dma_config_t dma_cfg = {
+        .channel = 0,
+        .direction = DMA_DIRECTION_PERIPHERAL_TO_MEMORY,
+        .priority = DMA_PRIORITY_LOW,
+        .peripheral_data_size = DMA_DATA_SIZE_16_BIT,
+        .memory_data_size = DMA_DATA_SIZE_16_BIT,
+        .peripheral_increment = false,
+        .memory_increment = true,
+        .circular_mode = false,
+        .fifo_mode = false,
+        .fifo_threshold = DMA_FIFO_THRESHOLD_1_4,
+        .memory_burst = DMA_BURST_SINGLE,
+        .peripheral_burst = DMA_BURST_SINGLE,
+    };
+
+    dma_handle_t dma = dma_init(DISPATCH_BENCH_DMA_NUM, DISPATCH_BENCH_STREAM_NUM, &dma_cfg);
+    if (dma == NULL) {
+        snprintf(json_buffer, json_buffer_size, "{\"dispatch_bench\":{\"error\":\"dma_unavailable\"}}");
+        return;
+    }
+
+    dwt_enable_cycle_counter();
+
+    // Run everything from a primed cache/prefetch state before measuring
+    (void)time_flag_service(dma);
+
+    uint32_t baseline = time_empty_loop();
+    uint32_t flag_service = time_flag_service(dma);
+    uint32_t current_buffer = time_current_buffer(dma);
+
+    dma_deinit(&dma);
+
+    snprintf(json_buffer, json_buffer_size,
+             "{\"dispatch_bench\":{\"binding\":\"%s\",\"iterations\":%u,"
+             "\"flag_service_cycles\":%lu,\"current_buffer_cycles\":%lu}}",
+             DISPATCH_BENCH_BINDING, DISPATCH_BENCH_ITERATIONS,
+             (unsigned long)per_call(flag_service, baseline),
+             (unsigned long)per_call(current_buffer, baseline));
+}
@@ -0,0 +1,157 @@
+/**
+ * @file      dma_bench.c
+ * @brief     On-target throughput test for the GPIO-to-SRAM capture DMA.
+ */
+
+#include <stdio.h>
+
+#include "dma_bench.h"
+#include "capture_arena.h"
+#include "dwt.h"
+#include "memorymap.h"
+#include "dma.h"
+#include "timer.h"
+
+// DMA2 Stream1 Channel7 is the TIM8_UP request; only DMA2 can reach AHB1 GPIO
+#define DMA_BENCH_DMA_NUM       2
+#define DMA_BENCH_STREAM_NUM    1
+#define DMA_BENCH_CHANNEL       7
+#define DMA_BENCH_TIMER_NUM     8
+
+#define DMA_BENCH_GPIOB_IDR     (GPIO_PORT_B_BASE + 0x10)
+
+// A run may overshoot the ideal duration by 1/64 plus a fixed start/stop cost
+#define DMA_BENCH_TOLERANCE_DIV     64U
+#define DMA_BENCH_OVERHEAD_CYCLES   512U
+
+typedef struct {
+    const char* name;
+    bool fifo_mode;
+    dma_fifo_threshold_t fifo_threshold;
+    dma_data_size_t peripheral_data_size;
+    dma_data_size_t memory_data_size;
+    dma_burst_t memory_burst;
+} dma_bench_profile_t;
+
+// --- Static Data ---
+
+static const dma_bench_profile_t s_profiles[] = {
+    // Direct mode, one 16-bit AHB write per sample (the classic capture path)
+    { "direct_16",         false, DMA_FIFO_THRESHOLD_1_4,  DMA_DATA_SIZE_16_BIT, DMA_DATA_SIZE_16_BIT, DMA_BURST_SINGLE },
+    // FIFO, 16-bit samples flushed as 4-beat bursts at half full
+    { "fifo_16_incr4",     true,  DMA_FIFO_THRESHOLD_1_2,  DMA_DATA_SIZE_16_BIT, DMA_DATA_SIZE_16_BIT, DMA_BURST_INCR4 },
+    // FIFO, 16-bit samples flushed as 8-beat bursts when full
+    { "fifo_16_incr8",     true,  DMA_FIFO_THRESHOLD_FULL, DMA_DATA_SIZE_16_BIT, DMA_DATA_SIZE_16_BIT, DMA_BURST_INCR8 },
+    // FIFO, 8-bit IDR reads (PB0-PB7) packed four to a word, 4-beat word bursts
+    { "packed_8_32_incr4", true,  DMA_FIFO_THRESHOLD_FULL, DMA_DATA_SIZE_8_BIT,  DMA_DATA_SIZE_32_BIT, DMA_BURST_INCR4 },
+};
+
+// Candidate rates in ascending order; those that do not divide the timer clock exactly are skipped
+static const uint32_t s_rates_hz[] = {
+    1000000, 2000000, 3000000, 4000000, 6000000, 8000000, 9000000, 10500000,
+    12000000, 14000000, 16800000, 18000000, 21000000, 24000000, 28000000, 36000000,
+};
+
+// --- Private Helper Functions ---
+
+/**
+ * @brief Performs one paced capture and reports whether it kept up.
+ */
+static bool run_once(const dma_bench_profile_t* profile, uint32_t rate_hz, void* dest, uint32_t samples) {
+    const dma_config_t dma_cfg = {
+        .channel = DMA_BENCH_CHANNEL,
+        .direction = DMA_DIRECTION_PERIPHERAL_TO_MEMORY,
+        .priority = DMA_PRIORITY_VERY_HIGH,
+        .peripheral_data_size = profile->peripheral_data_size,
+        .memory_data_size = profile->memory_data_size,
+        .peripheral_increment = false,
+        .memory_increment = true,
+        .circular_mode = false,
+        .fifo_mode = profile->fifo_mode,
+        .fifo_threshold = profile->fifo_threshold,
+        .memory_burst = profile->memory_burst,
+        .peripheral_burst = DMA_BURST_SINGLE,
+    };
+    const timer_config_t tim_cfg = {
+        .prescaler = 0,
+        .period = (DMA_BENCH_TIMER_CLOCK_HZ / rate_hz) - 1,
+    };
+
+    dma_handle_t dma = dma_init(DMA_BENCH_DMA_NUM, DMA_BENCH_STREAM_NUM, &dma_cfg);
+    timer_handle_t tim = timer_init(DMA_BENCH_TIMER_NUM, &tim_cfg);
+    if (dma == NULL || tim == NULL) {
+        dma_deinit(&dma);
+        timer_deinit(&tim);
+        return false;
+    }
+
+    const uint32_t expected = (uint32_t)(((uint64_t)samples * DMA_BENCH_CPU_HZ) / rate_hz);
+    uint32_t elapsed;
+    bool done;
+
+    dma_start_transfer(dma, (const void*)DMA_BENCH_GPIOB_IDR, dest, samples);
+    timer_enable_update_dma_request(tim);
+
+    uint32_t start = dwt_get_cycles();
+    timer_start(tim);
+    do {
+        done = dma_is_interrupt_flag_set(dma, DMA_INTERRUPT_TRANSFER_COMPLETE);
+        elapsed = dwt_get_cycles() - start;
+    } while (!done && elapsed < 2 * expected);
+    timer_stop(tim);
+
+    bool errors = dma_is_interrupt_flag_set(dma, DMA_INTERRUPT_TRANSFER_ERROR) ||
+                  dma_is_interrupt_flag_set(dma, DMA_INTERRUPT_FIFO_ERROR);
+
+    timer_disable_update_dma_request(tim);
+    timer_deinit(&tim);
+    dma_deinit(&dma);
+
+    // Every update event must have produced a transfer; dropped requests stretch the run
+    return done && !errors &&
+           elapsed <= expected + (expected / DMA_BENCH_TOLERANCE_DIV) + DMA_BENCH_OVERHEAD_CYCLES;
+}
+
+// --- Public API Function Implementations ---
+
+void dma_bench_run(char* json_buffer, size_t json_buffer_size) {
+    char* ptr = json_buffer;
+    size_t remaining = json_buffer_size;
+    int written;
+    void* dest = capture_arena_get_segment(0);
+
+    // Reads are at most 16 bits wide, so a segment holds as many as it holds samples
+    uint32_t samples = capture_arena_get_segment_samples();
+    if (samples > DMA_BENCH_SAMPLES) {
+        samples = DMA_BENCH_SAMPLES;
+    }
+    if (dest == NULL || samples == 0) {
+        snprintf(json_buffer, json_buffer_size, "{\"log\":\"No arena segment for the DMA bench\"}");
+        return;
+    }
+
+    dwt_enable_cycle_counter();
+
+    written = snprintf(ptr, remaining, "{\"dma_bench\":{\"samples\":%lu,\"profiles\":[", (unsigned long)samples);
+    if (written > 0 && (size_t)written < remaining) { ptr += written; remaining -= written; }
+
+    for (size_t p = 0; p < sizeof(s_profiles) / sizeof(s_profiles[0]); ++p) {
+        uint32_t max_stable_hz = 0;
+
+        for (size_t r = 0; r < sizeof(s_rates_hz) / sizeof(s_rates_hz[0]); ++r) {
+            if (DMA_BENCH_TIMER_CLOCK_HZ % s_rates_hz[r] != 0) {
+                continue;
+            }
+            if (!run_once(&s_profiles[p], s_rates_hz[r], dest, samples)) {
+                break;
+            }
+            max_stable_hz = s_rates_hz[r];
+        }
+
+        written = snprintf(ptr, remaining, "%s{\"profile\":\"%s\",\"max_rate_hz\":%lu}",
+                           (p == 0) ? "" : ",", s_profiles[p].name, (unsigned long)max_stable_hz);
+        if (written > 0 && (size_t)written < remaining) { ptr += written; remaining -= written; }
+    }
+
+    snprintf(ptr, remaining, "]}}");
+}
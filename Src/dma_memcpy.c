@@ -0,0 +1,242 @@
+/**
+ * @file      dma_memcpy.c
+ * @brief     Asynchronous memory-to-memory copy service on a dedicated DMA2 stream.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "dma_memcpy.h"
+#include "nvic.h"
+#include "dma.h"
+
+#define DMA_MEMCPY_DMA_NUM      2
+#define DMA_MEMCPY_STREAM_NUM   7
+#define DMA_MEMCPY_IRQN         70      // DMA2_Stream7_IRQn
+
+#if NVIC_IRQ_COUNT <= DMA_MEMCPY_IRQN
+#error "NVIC_IRQ_COUNT must cover DMA2_Stream7, or its priority lands in a system handler register"
+#endif
+
+// Largest chunk per transfer: 16-bit NDTR, kept a multiple of one 4-beat burst
+#define DMA_MEMCPY_MAX_ITEMS    0xFFFCU
+
+/** @brief Transfer width class, chosen from the alignment of each request. */
+typedef enum {
+    COPY_CLASS_BYTE = 0,    // Any alignment, 8-bit beats
+    COPY_CLASS_WORD,        // 4-byte aligned, 32-bit beats
+    COPY_CLASS_WORD_BURST,  // 16-byte aligned, 4-beat 32-bit bursts
+} copy_class_t;
+
+typedef struct {
+    uint8_t* dest;
+    const uint8_t* src;
+    size_t remaining;
+    dma_memcpy_callback_t callback;
+    void* user_data;
+} memcpy_request_t;
+
+// --- Static Data ---
+static memcpy_request_t s_queue[DMA_MEMCPY_QUEUE_LENGTH];
+static volatile uint8_t s_head = 0;     // Request currently on the stream
+static volatile uint8_t s_count = 0;    // Requests queued, including the running one
+static dma_handle_t s_dma = NULL;
+static copy_class_t s_class = COPY_CLASS_BYTE;
+static size_t s_chunk_bytes = 0;
+
+// --- Private Helper Functions ---
+
+static void stream_callback(dma_handle_t dma, void* context);
+
+static copy_class_t classify(const memcpy_request_t* req) {
+    uintptr_t bits = (uintptr_t)req->dest | (uintptr_t)req->src | (uintptr_t)req->remaining;
+    if ((bits & 0xFU) == 0) {
+        return COPY_CLASS_WORD_BURST;
+    }
+    if ((bits & 0x3U) == 0) {
+        return COPY_CLASS_WORD;
+    }
+    return COPY_CLASS_BYTE;
+}
+
+/**
+ * @brief Builds the stream settings for a transfer class.
+ * @details Memory-to-memory requires FIFO mode; the copy runs at low priority so
+ *          capture streams always win arbitration.
+ */
+static dma_config_t class_config(copy_class_t cls) {
+    const dma_data_size_t size = (cls == COPY_CLASS_BYTE) ? DMA_DATA_SIZE_8_BIT : DMA_DATA_SIZE_32_BIT;
+    const dma_burst_t burst = (cls == COPY_CLASS_WORD_BURST) ? DMA_BURST_INCR4 : DMA_BURST_SINGLE;
+    const dma_config_t cfg = {
+        .channel = 0,
+        .direction = DMA_DIRECTION_MEMORY_TO_MEMORY,
+        .priority = DMA_PRIORITY_LOW,
+        .peripheral_data_size = size,
+        .memory_data_size = size,
+        .peripheral_increment = true,
+        .memory_increment = true,
+        .circular_mode = false,
+        .fifo_mode = true,
+        .fifo_threshold = DMA_FIFO_THRESHOLD_FULL,
+        .memory_burst = burst,
+        .peripheral_burst = burst,
+    };
+    return cfg;
+}
+
+/**
+ * @brief Reprograms the stream for a transfer class if it differs from the current one.
+ * @details The stream keeps its handle, so this is safe from the stream interrupt.
+ * @return 0 on success, -1 if the stream could not be reprogrammed.
+ */
+static int configure_for(copy_class_t cls) {
+    if (cls == s_class) {
+        return 0;
+    }
+
+    const dma_config_t cfg = class_config(cls);
+    if (dma_reconfigure(s_dma, &cfg) != 0) {
+        return -1;
+    }
+    dma_enable_interrupt(s_dma, DMA_INTERRUPT_TRANSFER_COMPLETE);
+    dma_enable_interrupt(s_dma, DMA_INTERRUPT_TRANSFER_ERROR);
+    s_class = cls;
+    return 0;
+}
+
+/**
+ * @brief Puts the next chunk of a request on the stream.
+ * @return 0 on success, -1 if the stream could not be set up for it.
+ */
+static int start_chunk(memcpy_request_t* req) {
+    if (configure_for(classify(req)) != 0) {
+        return -1;
+    }
+
+    size_t item_bytes = (s_class == COPY_CLASS_BYTE) ? 1 : 4;
+    size_t items = req->remaining / item_bytes;
+    if (items > DMA_MEMCPY_MAX_ITEMS) {
+        items = DMA_MEMCPY_MAX_ITEMS;
+    }
+    s_chunk_bytes = items * item_bytes;
+
+    // For memory-to-memory the port treats the source as the "peripheral" side
+    dma_start_transfer(s_dma, req->src, req->dest, (uint16_t)items);
+    return 0;
+}
+
+/**
+ * @brief Starts the request at the head of the queue, failing any that cannot be started.
+ * @note Called from the stream interrupt.
+ */
+static void start_next(void) {
+    while (s_count > 0) {
+        memcpy_request_t* req = &s_queue[s_head];
+        if (start_chunk(req) == 0) {
+            return;
+        }
+
+        dma_memcpy_callback_t callback = req->callback;
+        void* user_data = req->user_data;
+        s_head = (s_head + 1) % DMA_MEMCPY_QUEUE_LENGTH;
+        s_count--;
+        if (callback) {
+            callback(-1, user_data);
+        }
+    }
+}
+
+// --- Public API Function Implementations ---
+
+int dma_memcpy_init(void) {
+    const dma_config_t cfg = class_config(COPY_CLASS_BYTE);
+
+    // The stream is claimed once; later width changes reprogram it in place
+    s_dma = dma_init(DMA_MEMCPY_DMA_NUM, DMA_MEMCPY_STREAM_NUM, &cfg);
+    if (s_dma == NULL) {
+        return -1;
+    }
+    s_class = COPY_CLASS_BYTE;
+    dma_set_callback(s_dma, stream_callback, NULL);
+    dma_enable_interrupt(s_dma, DMA_INTERRUPT_TRANSFER_COMPLETE);
+    dma_enable_interrupt(s_dma, DMA_INTERRUPT_TRANSFER_ERROR);
+    nvic_set_priority(DMA_MEMCPY_IRQN, DMA_MEMCPY_IRQ_PRIORITY);
+    nvic_enable_irq(DMA_MEMCPY_IRQN);
+    return 0;
+}
+
+int dma_memcpy_async(void* dest, const void* src, size_t len, dma_memcpy_callback_t callback, void* user_data) {
+    if (dest == NULL || src == NULL || len == 0 || s_dma == NULL) {
+        return -1; // Invalid arguments
+    }
+
+    taskENTER_CRITICAL();
+    if (s_count >= DMA_MEMCPY_QUEUE_LENGTH) {
+        taskEXIT_CRITICAL();
+        return -2; // Queue full
+    }
+
+    uint8_t slot = (s_head + s_count) % DMA_MEMCPY_QUEUE_LENGTH;
+    s_queue[slot].dest = (uint8_t*)dest;
+    s_queue[slot].src = (const uint8_t*)src;
+    s_queue[slot].remaining = len;
+    s_queue[slot].callback = callback;
+    s_queue[slot].user_data = user_data;
+
+    // The stream was idle: start this request now, otherwise the ISR chains it
+    if (s_count == 0 && start_chunk(&s_queue[slot]) != 0) {
+        taskEXIT_CRITICAL();
+        return -3; // Stream could not be set up
+    }
+    s_count++;
+    taskEXIT_CRITICAL();
+
+    return 0;
+}
+
+bool dma_memcpy_is_idle(void) {
+    return s_count == 0;
+}
+
+// --- ISR Callback ---
+
+static void stream_callback(dma_handle_t dma, void* context) {
+    (void)dma;
+    (void)context;
+    int status = 0;
+
+    if (dma_is_interrupt_flag_set(s_dma, DMA_INTERRUPT_TRANSFER_ERROR)) {
+        dma_clear_interrupt_flag(s_dma, DMA_INTERRUPT_TRANSFER_ERROR);
+        status = -1;
+    } else if (dma_is_interrupt_flag_set(s_dma, DMA_INTERRUPT_TRANSFER_COMPLETE)) {
+        dma_clear_interrupt_flag(s_dma, DMA_INTERRUPT_TRANSFER_COMPLETE);
+    } else {
+        return;
+    }
+
+    memcpy_request_t* req = &s_queue[s_head];
+
+    // Continue a long copy with its next chunk
+    if (status == 0) {
+        req->dest += s_chunk_bytes;
+        req->src += s_chunk_bytes;
+        req->remaining -= s_chunk_bytes;
+        if (req->remaining > 0 && start_chunk(req) == 0) {
+            return;
+        }
+        if (req->remaining > 0) {
+            status = -1;
+        }
+    }
+
+    dma_memcpy_callback_t callback = req->callback;
+    void* user_data = req->user_data;
+
+    s_head = (s_head + 1) % DMA_MEMCPY_QUEUE_LENGTH;
+    s_count--;
+    start_next();
+
+    if (callback) {
+        callback(status, user_data);
+    }
+}
@@ -0,0 +1,78 @@
+/**
+ * @file      dma_ring.c
+ * @brief     Byte rings filled by a circular DMA stream, with absolute positions.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "dma_ring.h"
+
+// --- Public API Function Implementations ---
+
+uint32_t dma_ring_fit_length(uint32_t available_bytes, uint32_t max_bytes) {
+    uint32_t length = max_bytes;
+    while (length > available_bytes) {
+        length >>= 1;
+    }
+    // Round a non-power-of-two bound down as well
+    while (length & (length - 1U)) {
+        length &= length - 1U;
+    }
+    return length;
+}
+
+void dma_ring_start(dma_ring_t* ring, dma_handle_t dma, const void* peripheral, uint8_t* buffer, uint32_t length) {
+    ring->dma = dma;
+    ring->buffer = buffer;
+    ring->length = length;
+    ring->wraps = 0;
+
+    dma_enable_interrupt(dma, DMA_INTERRUPT_TRANSFER_COMPLETE);
+    dma_start_transfer(dma, peripheral, buffer, (uint16_t)length);
+}
+
+bool dma_ring_handle_wrap(dma_ring_t* ring) {
+    if (dma_is_interrupt_flag_set(ring->dma, DMA_INTERRUPT_TRANSFER_COMPLETE)) {
+        dma_clear_interrupt_flag(ring->dma, DMA_INTERRUPT_TRANSFER_COMPLETE);
+        ring->wraps++;
+        return true;
+    }
+    return false;
+}
+
+uint32_t dma_ring_position(dma_ring_t* ring) {
+    uint32_t wraps = ring->wraps;
+    uint32_t remaining = dma_get_remaining_count(ring->dma);
+
+    // NDTR reloads at the wrap; a high count with TC still pending means
+    // the wrap happened but has not been counted yet
+    if (dma_is_interrupt_flag_set(ring->dma, DMA_INTERRUPT_TRANSFER_COMPLETE) &&
+        remaining > ring->length / 2) {
+        wraps++;
+    }
+    return wraps * ring->length + (ring->length - remaining);
+}
+
+bool dma_ring_is_overwritten(dma_ring_t* ring, uint32_t position) {
+    taskENTER_CRITICAL();
+    uint32_t now = dma_ring_position(ring);
+    taskEXIT_CRITICAL();
+
+    return (now - position) > ring->length;
+}
+
+void dma_ring_append_hex(const dma_ring_t* ring, uint32_t position, uint32_t count, char** buf, size_t* remaining) {
+    static const char hex_digits[] = "0123456789ABCDEF";
+
+    for (uint32_t i = 0; i < count && *remaining > 2; ++i) {
+        uint8_t byte = dma_ring_byte_at(ring, position + i);
+        (*buf)[0] = hex_digits[byte >> 4];
+        (*buf)[1] = hex_digits[byte & 0x0F];
+        *buf += 2;
+        *remaining -= 2;
+    }
+    if (*remaining > 0) {
+        **buf = '\0';
+    }
+}
@@ -0,0 +1,198 @@
+/**
+ * @file      edge_stream.c
+ * @brief     Common edge-record stream between capture front-ends and decoders.
+ */
+
+#include <stdio.h>
+
+#include "edge_stream.h"
+#include "json_text.h"
+
+// --- Static Data ---
+static edge_t s_edges[EDGE_STREAM_QUEUE_LENGTH];
+static volatile uint32_t s_head = 0;    // Free-running; written by the producer
+static volatile uint32_t s_tail = 0;    // Free-running; written by the poller
+static volatile uint32_t s_dropped = 0;
+static const edge_decoder_t* s_decoder = NULL;
+static bool s_armed = false;            // Holding records back as pre-trigger history
+static uint32_t s_pre_trigger_ticks = 0;
+static volatile bool s_triggered = false;
+static volatile uint32_t s_trigger_time = 0;
+static uint32_t s_stream_time = 0;      // Time up to which the decoder has seen the line
+
+// --- Private Helper Functions ---
+
+static void format_raw(char* json_buffer, size_t json_buffer_size) {
+    char* ptr = json_buffer;
+    size_t remaining = json_buffer_size;
+    char field[40];
+
+    json_text_append(&ptr, &remaining, "{\"edges\":[");
+    for (uint32_t i = 0; i < EDGE_STREAM_MAX_RECORD_EDGES && s_tail != s_head; ++i) {
+        const edge_t* edge = &s_edges[s_tail & (EDGE_STREAM_QUEUE_LENGTH - 1U)];
+        if (edge->flags) {
+            snprintf(field, sizeof(field), "%s[%lu,%u,%u,%u]", (i == 0) ? "" : ",",
+                     (unsigned long)edge->time, edge->channel, edge->level, edge->flags);
+        } else {
+            snprintf(field, sizeof(field), "%s[%lu,%u,%u]", (i == 0) ? "" : ",",
+                     (unsigned long)edge->time, edge->channel, edge->level);
+        }
+        json_text_append(&ptr, &remaining, field);
+        s_tail++;
+    }
+    json_text_append(&ptr, &remaining, "]");
+
+    if (s_dropped > 0) {
+        snprintf(field, sizeof(field), ",\"dropped\":%lu", (unsigned long)s_dropped);
+        json_text_append(&ptr, &remaining, field);
+        s_dropped = 0;
+    }
+    json_text_append(&ptr, &remaining, "}");
+}
+
+/**
+ * @brief Latches the pre-trigger history and releases the stream.
+ * @details Records older than the pre-trigger window are discarded, and a
+ *          decoder starts afresh at the first record kept.
+ */
+static void release_trigger(char* json_buffer, size_t json_buffer_size) {
+    uint32_t window_start = s_trigger_time - s_pre_trigger_ticks;
+    while (s_tail != s_head &&
+           (int32_t)(s_edges[s_tail & (EDGE_STREAM_QUEUE_LENGTH - 1U)].time - window_start) < 0) {
+        s_tail++;
+    }
+    s_armed = false;
+    s_dropped = 0;
+    if (s_decoder && s_decoder->reset) {
+        s_decoder->reset();
+    }
+    snprintf(json_buffer, json_buffer_size, "{\"trigger\":{\"t\":%lu}}", (unsigned long)s_trigger_time);
+}
+
+// --- Public API Function Implementations ---
+
+void edge_stream_reset(const edge_decoder_t* decoder) {
+    s_head = 0;
+    s_tail = 0;
+    s_dropped = 0;
+    s_armed = false;
+    s_triggered = false;
+    s_stream_time = 0;
+    s_decoder = decoder;
+    if (decoder && decoder->reset) {
+        decoder->reset();
+    }
+}
+
+void edge_stream_arm(uint32_t pre_trigger_ticks) {
+    s_pre_trigger_ticks = pre_trigger_ticks;
+    s_triggered = false;
+    s_armed = true;
+}
+
+void edge_stream_trigger(uint32_t time) {
+    if (s_armed && !s_triggered) {
+        s_trigger_time = time;
+        s_triggered = true;
+    }
+}
+
+uint32_t edge_stream_free(void) {
+    return s_armed ? EDGE_STREAM_QUEUE_LENGTH : EDGE_STREAM_QUEUE_LENGTH - (s_head - s_tail);
+}
+
+bool edge_stream_push(uint32_t time, uint8_t channel, uint16_t level, uint8_t flags) {
+    uint32_t head = s_head;
+    if (head - s_tail >= EDGE_STREAM_QUEUE_LENGTH) {
+        if (!s_armed) {
+            s_dropped++;
+            return false;
+        }
+        s_tail++;   // Pre-trigger ring: the oldest record makes way
+    }
+
+    edge_t* edge = &s_edges[head & (EDGE_STREAM_QUEUE_LENGTH - 1U)];
+    edge->time = time;
+    edge->channel = channel;
+    edge->level = level;
+    edge->flags = flags;
+    s_head = head + 1U;
+    return true;
+}
+
+uint32_t edge_stream_extract_packed(uint8_t channel, const uint8_t* bits, uint32_t count,
+                                    uint32_t time, uint32_t ticks_per_bit, uint8_t* level) {
+    uint32_t edges = 0;
+    uint8_t current = *level;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        uint8_t byte = bits[i];
+        if (byte == (current ? 0xFFU : 0x00U)) {
+            continue;
+        }
+
+        // Bit k differs from the sample before it (bit k+1, or the previous level for bit 7)
+        uint8_t changes = byte ^ (uint8_t)((byte >> 1) | (current << 7));
+        while (changes) {
+            uint32_t bit = (uint32_t)__builtin_clz(changes) - 24U;   // 0 = first sample of the byte
+            changes &= (uint8_t)~(0x80U >> bit);
+            current ^= 1U;
+            edge_stream_push(time + (i * 8U + bit) * ticks_per_bit, channel, current, 0);
+            edges++;
+        }
+    }
+
+    *level = current;
+    return edges;
+}
+
+bool edge_stream_poll(char* json_buffer, size_t json_buffer_size) {
+    if (s_armed) {
+        if (!s_triggered) {
+            return false;
+        }
+        release_trigger(json_buffer, json_buffer_size);
+        return true;
+    }
+
+    if (s_decoder == NULL) {
+        if (s_tail == s_head) {
+            return false;
+        }
+        format_raw(json_buffer, json_buffer_size);
+        return true;
+    }
+
+    while (s_tail != s_head) {
+        const edge_t* edge = &s_edges[s_tail & (EDGE_STREAM_QUEUE_LENGTH - 1U)];
+        bool written = false;
+        if (!(edge->flags & EDGE_FLAG_ANALOG)) {
+            s_stream_time = edge->time;
+            written = s_decoder->feed(edge, json_buffer, json_buffer_size);
+        }
+        s_tail++;
+        if (written) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool edge_stream_flush(uint32_t now, char* json_buffer, size_t json_buffer_size) {
+    if (s_armed || s_tail != s_head || s_decoder == NULL || s_decoder->flush == NULL) {
+        return false;
+    }
+
+    s_stream_time = now;
+    return s_decoder->flush(now, false, json_buffer, json_buffer_size);
+}
+
+bool edge_stream_finish(char* json_buffer, size_t json_buffer_size) {
+    if (edge_stream_poll(json_buffer, json_buffer_size)) {
+        return true;
+    }
+    if (s_armed || s_decoder == NULL || s_decoder->flush == NULL) {
+        return false;
+    }
+    return s_decoder->flush(s_stream_time, true, json_buffer, json_buffer_size);
+}
@@ -0,0 +1,254 @@
+/**
+ * @file      encoder_capture.c
+ * @brief     Quadrature encoder position and velocity using the timer encoder interface.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "encoder_capture.h"
+#include "capture_timebase.h"
+#include "system_clock.h"
+#include "json_text.h"
+#include "nvic.h"
+#include "gpio.h"
+#include "timer.h"
+
+#define GPIO_PORT_A             0
+#define GPIO_AF_TIM3            2
+#define ENCODER_PIN_A           6       // PA6 = TIM3_CH1
+#define ENCODER_PIN_B           7       // PA7 = TIM3_CH2
+
+#define ENCODER_TIMER_NUM       3
+#define ENCODER_IRQN            29      // TIM3_IRQn
+#define ENCODER_WRAP            0x10000
+
+// TIM7 counts at 10 kHz from the APB1 timer clock
+#define SNAPSHOT_TIMER_NUM      7
+#define SNAPSHOT_TIMER_HZ       SYSTEM_CLOCK_APB1_TIMER_HZ
+#define SNAPSHOT_COUNT_HZ       10000UL
+#define SNAPSHOT_IRQN           55      // TIM7_IRQn
+
+typedef struct {
+    uint32_t time;
+    int64_t position;
+} encoder_snapshot_t;
+
+// --- Static Data ---
+static timer_handle_t s_encoder = NULL;
+static timer_handle_t s_snapshot_timer = NULL;
+static gpio_handle_t s_pins = NULL;
+static volatile int64_t s_wraps = 0;    // Position of counter value 0
+static encoder_snapshot_t s_snapshots[ENCODER_CAPTURE_QUEUE_LENGTH];
+static volatile uint32_t s_head = 0;    // Free-running; written by the snapshot ISR
+static volatile uint32_t s_tail = 0;    // Free-running; written by the poller
+static volatile uint32_t s_dropped = 0;
+static encoder_snapshot_t s_last;       // Previous reported snapshot, for velocity
+static bool s_have_last = false;
+static bool s_running = false;
+
+// --- Private Helper Functions ---
+
+/**
+ * @brief Reads the extended position.
+ * @note Called from the snapshot ISR, which the wrap ISR cannot preempt, so a
+ *       wrap the counter has made may not be accounted for yet.
+ */
+static int64_t read_position(void) {
+    bool pending;
+    uint16_t count;
+
+    // Retry until the count and the pending-wrap flag belong together
+    do {
+        pending = timer_is_update_interrupt_flag_set(s_encoder);
+        count = (uint16_t)timer_get_counter(s_encoder);
+    } while (pending != timer_is_update_interrupt_flag_set(s_encoder));
+
+    int64_t base = s_wraps;
+    if (pending) {
+        base += (count < 0x8000U) ? ENCODER_WRAP : -ENCODER_WRAP;
+    }
+    return base + count;
+}
+
+static void take_snapshot(void) {
+    uint32_t head = s_head;
+    if (head - s_tail >= ENCODER_CAPTURE_QUEUE_LENGTH) {
+        s_dropped++;
+        return;
+    }
+
+    encoder_snapshot_t* snapshot = &s_snapshots[head & (ENCODER_CAPTURE_QUEUE_LENGTH - 1U)];
+    snapshot->time = capture_timebase_now();
+    snapshot->position = read_position();
+    s_head = head + 1U;
+}
+
+/**
+ * @brief Formats a signed 64-bit value (printf's %lld is not available in newlib-nano).
+ */
+static void format_int64(char* buf, int64_t value) {
+    char digits[20];
+    uint64_t magnitude = (value < 0) ? (uint64_t)(-(value + 1)) + 1U : (uint64_t)value;
+    int count = 0;
+
+    do {
+        digits[count++] = (char)('0' + (magnitude % 10U));
+        magnitude /= 10U;
+    } while (magnitude > 0);
+
+    if (value < 0) {
+        *buf++ = '-';
+    }
+    while (count > 0) {
+        *buf++ = digits[--count];
+    }
+    *buf = '\0';
+}
+
+// --- Public API Function Implementations ---
+
+int encoder_capture_start(uint8_t filter, uint32_t rate_hz) {
+    if (s_running || filter > 15 || rate_hz == 0 || rate_hz > ENCODER_CAPTURE_MAX_RATE_HZ) {
+        return -1;
+    }
+
+    // Full 16-bit range; the wrap interrupt carries the rest
+    const timer_config_t encoder_cfg = {
+        .prescaler = 0,
+        .period = 0xFFFFU,
+    };
+    const timer_encoder_config_t interface_cfg = {
+        .mode = TIMER_ENCODER_TI12,
+        .invert_ti1 = false,
+        .invert_ti2 = false,
+        .filter = filter,
+    };
+    const timer_config_t snapshot_cfg = {
+        .prescaler = SNAPSHOT_TIMER_HZ / SNAPSHOT_COUNT_HZ - 1U,
+        .period = SNAPSHOT_COUNT_HZ / rate_hz - 1U,
+    };
+    const gpio_config_t pin_cfg = {
+        .mode = GPIO_MODE_ALTERNATE_FUNCTION,
+        .pull = GPIO_PULL_UP,
+        .output_type = GPIO_OUTPUT_TYPE_PUSH_PULL,
+        .speed = GPIO_SPEED_HIGH,
+        .alternate_function = GPIO_AF_TIM3,
+    };
+
+    s_wraps = 0;
+    s_head = 0;
+    s_tail = 0;
+    s_dropped = 0;
+    s_have_last = false;
+    capture_timebase_init();
+
+    s_running = true;
+    s_pins = gpio_init(GPIO_PORT_A, (1 << ENCODER_PIN_A) | (1 << ENCODER_PIN_B), &pin_cfg);
+    s_encoder = timer_init(ENCODER_TIMER_NUM, &encoder_cfg);
+    s_snapshot_timer = timer_init(SNAPSHOT_TIMER_NUM, &snapshot_cfg);
+    if (s_pins == NULL || s_encoder == NULL || s_snapshot_timer == NULL) {
+        encoder_capture_stop();
+        return -2;
+    }
+
+    timer_configure_encoder(s_encoder, &interface_cfg);
+    timer_clear_update_interrupt_flag(s_encoder);
+    timer_enable_update_interrupt(s_encoder);
+    timer_clear_update_interrupt_flag(s_snapshot_timer);
+    timer_enable_update_interrupt(s_snapshot_timer);
+
+    // Same priority, so a snapshot never interrupts a wrap half-way
+    nvic_set_priority(ENCODER_IRQN, ENCODER_CAPTURE_IRQ_PRIORITY);
+    nvic_set_priority(SNAPSHOT_IRQN, ENCODER_CAPTURE_IRQ_PRIORITY);
+    nvic_enable_irq(ENCODER_IRQN);
+    nvic_enable_irq(SNAPSHOT_IRQN);
+
+    timer_start(s_encoder);
+    timer_start(s_snapshot_timer);
+    return 0;
+}
+
+void encoder_capture_stop(void) {
+    if (!s_running) {
+        return;
+    }
+
+    nvic_disable_irq(SNAPSHOT_IRQN);
+    nvic_disable_irq(ENCODER_IRQN);
+    if (s_snapshot_timer) {
+        timer_disable_update_interrupt(s_snapshot_timer);
+    }
+    if (s_encoder) {
+        timer_disable_update_interrupt(s_encoder);
+    }
+    timer_deinit(&s_snapshot_timer);
+    timer_deinit(&s_encoder);
+    gpio_deinit(&s_pins);
+
+    s_running = false;
+}
+
+bool encoder_capture_poll(char* json_buffer, size_t json_buffer_size) {
+    if (!s_running || s_tail == s_head) {
+        return false;
+    }
+
+    char* ptr = json_buffer;
+    size_t remaining = json_buffer_size;
+    char position[24];
+    char velocity[24];
+    char field[80];
+
+    json_text_append(&ptr, &remaining, "{\"encoder\":{\"samples\":[");
+    for (uint32_t i = 0; i < ENCODER_CAPTURE_MAX_RECORD_SAMPLES && s_tail != s_head; ++i) {
+        encoder_snapshot_t snapshot = s_snapshots[s_tail & (ENCODER_CAPTURE_QUEUE_LENGTH - 1U)];
+        s_tail++;
+
+        int64_t counts_per_second = 0;
+        uint32_t elapsed = snapshot.time - s_last.time;
+        if (s_have_last && elapsed > 0) {
+            counts_per_second = (snapshot.position - s_last.position) * (int64_t)CAPTURE_TIMEBASE_HZ / (int64_t)elapsed;
+        }
+        s_last = snapshot;
+        s_have_last = true;
+
+        format_int64(position, snapshot.position);
+        format_int64(velocity, counts_per_second);
+        snprintf(field, sizeof(field), "%s[%lu,%s,%s]", (i == 0) ? "" : ",",
+                 (unsigned long)snapshot.time, position, velocity);
+        json_text_append(&ptr, &remaining, field);
+    }
+    json_text_append(&ptr, &remaining, "]");
+
+    if (s_dropped > 0) {
+        taskENTER_CRITICAL();
+        uint32_t dropped = s_dropped;
+        s_dropped = 0;
+        taskEXIT_CRITICAL();
+        snprintf(field, sizeof(field), ",\"dropped\":%lu", (unsigned long)dropped);
+        json_text_append(&ptr, &remaining, field);
+    }
+    json_text_append(&ptr, &remaining, "}}");
+    return true;
+}
+
+// --- ISRs ---
+
+void TIM3_IRQHandler(void) {
+    if (timer_is_update_interrupt_flag_set(s_encoder)) {
+        timer_clear_update_interrupt_flag(s_encoder);
+        // The counter is just past the wrap, near 0 going up or near 0xFFFF going down
+        uint16_t count = (uint16_t)timer_get_counter(s_encoder);
+        s_wraps += (count < 0x8000U) ? ENCODER_WRAP : -ENCODER_WRAP;
+    }
+}
+
+void TIM7_IRQHandler(void) {
+    if (timer_is_update_interrupt_flag_set(s_snapshot_timer)) {
+        timer_clear_update_interrupt_flag(s_snapshot_timer);
+        take_snapshot();
+    }
+}
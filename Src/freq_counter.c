@@ -0,0 +1,319 @@
+/**
+ * @file      freq_counter.c
+ * @brief     Continuous frequency, period and duty-cycle measurement using timer counting.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "freq_counter.h"
+#include "capture_timebase.h"
+#include "system_clock.h"
+#include "json_text.h"
+#include "nvic.h"
+#include "gpio.h"
+#include "timer.h"
+
+#define GPIO_PORT_A             0
+#define GPIO_PORT_D             3
+#define GPIO_PORT_E             4
+
+// TIM6 slices time on the APB1 timer clock
+#define SLICE_TIMER_NUM         6
+#define SLICE_TIMER_HZ          SYSTEM_CLOCK_APB1_TIMER_HZ
+
+#define APB1_TIMER_MHZ          (SYSTEM_CLOCK_APB1_TIMER_HZ / 1000000UL)
+#define APB2_TIMER_MHZ          (SYSTEM_CLOCK_APB2_TIMER_HZ / 1000000UL)
+#define SLICE_IRQN              54      // TIM6_DAC_IRQn
+
+#define TIMEBASE_TICKS_PER_US   (CAPTURE_TIMEBASE_HZ / 1000000UL)
+
+/** @brief Fixed hardware resources of one counter channel. */
+typedef struct {
+    uint8_t timer_num;
+    uint8_t port;
+    uint8_t pin;
+    uint8_t alternate_function;
+    uint8_t kernel_mhz;     // Timer kernel clock, which the gated half counts
+} channel_hw_t;
+
+static const channel_hw_t s_channel_hw[FREQ_COUNTER_CHANNELS] = {
+    { .timer_num = 1, .port = GPIO_PORT_E, .pin = 7, .alternate_function = 1, .kernel_mhz = APB2_TIMER_MHZ },
+    { .timer_num = 3, .port = GPIO_PORT_D, .pin = 2, .alternate_function = 2, .kernel_mhz = APB1_TIMER_MHZ },
+    { .timer_num = 4, .port = GPIO_PORT_E, .pin = 0, .alternate_function = 2, .kernel_mhz = APB1_TIMER_MHZ },
+    { .timer_num = 8, .port = GPIO_PORT_A, .pin = 0, .alternate_function = 3, .kernel_mhz = APB2_TIMER_MHZ },
+};
+
+typedef struct {
+    timer_handle_t timer;
+    gpio_handle_t pin;
+    uint16_t last_count;    // Counter value at the end of the previous slice
+    uint32_t accumulated;   // Counts collected in the current half
+} counter_channel_t;
+
+/** @brief Raw totals of one gate period. */
+typedef struct {
+    uint32_t edges;         // Rising edges in the edge half
+    uint32_t edge_ticks;    // Length of the edge half (capture timebase ticks)
+    uint32_t high_counts;   // Kernel clocks spent high in the duty half
+    uint32_t duty_ticks;    // Length of the duty half (capture timebase ticks)
+} counter_result_t;
+
+// --- Static Data ---
+static counter_channel_t s_channels[FREQ_COUNTER_CHANNELS];
+static uint8_t s_channel_mask = 0;
+static timer_handle_t s_slice_timer = NULL;
+static timer_clock_config_t s_input_cfg;
+static uint32_t s_gate_ms = 0;
+static uint32_t s_half_slices = 0;
+static uint32_t s_slice = 0;            // Slices completed in the current half
+static uint32_t s_half_start = 0;       // Timestamp of the current half's baseline
+static bool s_duty_half = false;
+static counter_result_t s_pending[FREQ_COUNTER_CHANNELS];
+static counter_result_t s_results[FREQ_COUNTER_CHANNELS];
+static volatile uint32_t s_result_seq = 0;
+static uint32_t s_reported_seq = 0;
+static bool s_running = false;
+
+// --- Private Helper Functions ---
+
+/**
+ * @brief Puts every counter into the mode of the current half and takes a new baseline.
+ */
+static void begin_half(void) {
+    for (uint8_t i = 0; i < FREQ_COUNTER_CHANNELS; ++i) {
+        counter_channel_t* ch = &s_channels[i];
+        if (!(s_channel_mask & (1U << i))) {
+            continue;
+        }
+        if (s_duty_half) {
+            timer_set_gated_clock(ch->timer, &s_input_cfg);
+        } else {
+            timer_set_clock_source(ch->timer, &s_input_cfg);
+        }
+        ch->last_count = (uint16_t)timer_get_counter(ch->timer);
+        ch->accumulated = 0;
+    }
+    s_half_start = capture_timebase_now();
+}
+
+/**
+ * @brief Collects one slice and closes the half once it is complete.
+ * @note Runs in the slice timer interrupt.
+ */
+static void end_slice(void) {
+    // No counter advances more than 42000 in a slice, so 16-bit deltas are exact
+    for (uint8_t i = 0; i < FREQ_COUNTER_CHANNELS; ++i) {
+        counter_channel_t* ch = &s_channels[i];
+        if (s_channel_mask & (1U << i)) {
+            uint16_t count = (uint16_t)timer_get_counter(ch->timer);
+            ch->accumulated += (uint16_t)(count - ch->last_count);
+            ch->last_count = count;
+        }
+    }
+    uint32_t now = capture_timebase_now();
+
+    if (++s_slice < s_half_slices) {
+        return;
+    }
+    s_slice = 0;
+
+    for (uint8_t i = 0; i < FREQ_COUNTER_CHANNELS; ++i) {
+        if (!s_duty_half) {
+            s_pending[i].edges = s_channels[i].accumulated;
+            s_pending[i].edge_ticks = now - s_half_start;
+        } else {
+            s_pending[i].high_counts = s_channels[i].accumulated;
+            s_pending[i].duty_ticks = now - s_half_start;
+            s_results[i] = s_pending[i];
+        }
+    }
+    if (s_duty_half) {
+        s_result_seq++;
+    }
+
+    s_duty_half = !s_duty_half;
+    begin_half();
+}
+
+static void format_channel(char* buf, size_t size, uint8_t index, const counter_result_t* result) {
+    uint64_t hz_milli = 0;
+    uint64_t period_ps = 0;
+    if (result->edges > 0 && result->edge_ticks > 0) {
+        hz_milli = (uint64_t)result->edges * TIMEBASE_TICKS_PER_US * 1000000000ULL / result->edge_ticks;
+        period_ps = (uint64_t)result->edge_ticks * 1000000ULL / ((uint64_t)TIMEBASE_TICKS_PER_US * result->edges);
+    }
+
+    // Hundredths of a percent of the kernel clocks in the duty half
+    uint64_t duty = 0;
+    if (result->duty_ticks > 0) {
+        duty = (uint64_t)result->high_counts * TIMEBASE_TICKS_PER_US * 10000ULL /
+               ((uint64_t)result->duty_ticks * s_channel_hw[index].kernel_mhz);
+        if (duty > 10000) {
+            duty = 10000;
+        }
+    }
+
+    snprintf(buf, size, "{\"ch\":%u,\"hz\":%lu.%03lu,\"period_ns\":%lu.%03lu,\"duty\":%lu.%02lu}",
+             index, (unsigned long)(hz_milli / 1000), (unsigned long)(hz_milli % 1000),
+             (unsigned long)(period_ps / 1000), (unsigned long)(period_ps % 1000),
+             (unsigned long)(duty / 100), (unsigned long)(duty % 100));
+}
+
+static int start_channel(uint8_t index) {
+    const channel_hw_t* hw = &s_channel_hw[index];
+    counter_channel_t* ch = &s_channels[index];
+
+    // Free-running 16-bit counter; only its deltas are used
+    const timer_config_t tim_cfg = {
+        .prescaler = 0,
+        .period = 0xFFFFU,
+    };
+    const gpio_config_t pin_cfg = {
+        .mode = GPIO_MODE_ALTERNATE_FUNCTION,
+        .pull = GPIO_PULL_NONE,
+        .output_type = GPIO_OUTPUT_TYPE_PUSH_PULL,
+        .speed = GPIO_SPEED_VERY_HIGH,
+        .alternate_function = hw->alternate_function,
+    };
+
+    ch->pin = gpio_init(hw->port, (1 << hw->pin), &pin_cfg);
+    ch->timer = timer_init(hw->timer_num, &tim_cfg);
+    if (ch->pin == NULL || ch->timer == NULL) {
+        return -2;
+    }
+    return 0;
+}
+
+static void stop_channel(uint8_t index) {
+    counter_channel_t* ch = &s_channels[index];
+    timer_deinit(&ch->timer);
+    gpio_deinit(&ch->pin);
+}
+
+// --- Public API Function Implementations ---
+
+int freq_counter_start(uint8_t channel_mask, uint8_t filter, uint32_t gate_ms) {
+    if (s_running || channel_mask == 0 || channel_mask >= (1U << FREQ_COUNTER_CHANNELS) || filter > 15 ||
+        gate_ms < FREQ_COUNTER_MIN_GATE_MS || gate_ms > FREQ_COUNTER_MAX_GATE_MS) {
+        return -1;
+    }
+
+    const timer_config_t slice_cfg = {
+        .prescaler = 0,
+        .period = (SLICE_TIMER_HZ / 1000000UL) * FREQ_COUNTER_SLICE_US - 1U,
+    };
+
+    s_input_cfg.source = TIMER_CLOCK_ETR;
+    s_input_cfg.polarity = TIMER_IC_POLARITY_RISING;
+    s_input_cfg.filter = filter;
+    s_half_slices = (gate_ms * 1000U) / (FREQ_COUNTER_SLICE_US * 2U);
+    s_gate_ms = (s_half_slices * FREQ_COUNTER_SLICE_US * 2U) / 1000U;
+    s_slice = 0;
+    s_duty_half = false;
+    s_result_seq = 0;
+    s_reported_seq = 0;
+    capture_timebase_init();
+
+    s_running = true;
+    s_channel_mask = channel_mask;
+    int status = 0;
+    for (uint8_t i = 0; i < FREQ_COUNTER_CHANNELS && status == 0; ++i) {
+        if (channel_mask & (1U << i)) {
+            status = start_channel(i);
+        }
+    }
+    s_slice_timer = timer_init(SLICE_TIMER_NUM, &slice_cfg);
+    if (status != 0 || s_slice_timer == NULL) {
+        freq_counter_stop();
+        return -2;
+    }
+
+    for (uint8_t i = 0; i < FREQ_COUNTER_CHANNELS; ++i) {
+        if (channel_mask & (1U << i)) {
+            timer_start(s_channels[i].timer);
+        }
+    }
+
+    timer_clear_update_interrupt_flag(s_slice_timer);
+    timer_enable_update_interrupt(s_slice_timer);
+    nvic_set_priority(SLICE_IRQN, FREQ_COUNTER_IRQ_PRIORITY);
+    nvic_enable_irq(SLICE_IRQN);
+
+    taskENTER_CRITICAL();
+    begin_half();
+    timer_start(s_slice_timer);
+    taskEXIT_CRITICAL();
+    return 0;
+}
+
+void freq_counter_stop(void) {
+    if (!s_running) {
+        return;
+    }
+
+    nvic_disable_irq(SLICE_IRQN);
+    if (s_slice_timer) {
+        timer_disable_update_interrupt(s_slice_timer);
+    }
+    timer_deinit(&s_slice_timer);
+    for (uint8_t i = 0; i < FREQ_COUNTER_CHANNELS; ++i) {
+        if (s_channel_mask & (1U << i)) {
+            stop_channel(i);
+        }
+    }
+
+    s_channel_mask = 0;
+    s_running = false;
+}
+
+bool freq_counter_poll(char* json_buffer, size_t json_buffer_size) {
+    if (!s_running) {
+        return false;
+    }
+
+    counter_result_t results[FREQ_COUNTER_CHANNELS];
+    taskENTER_CRITICAL();
+    bool fresh = (s_result_seq != s_reported_seq);
+    if (fresh) {
+        for (uint8_t i = 0; i < FREQ_COUNTER_CHANNELS; ++i) {
+            results[i] = s_results[i];
+        }
+        s_reported_seq = s_result_seq;
+    }
+    taskEXIT_CRITICAL();
+    if (!fresh) {
+        return false;
+    }
+
+    char* ptr = json_buffer;
+    size_t remaining = json_buffer_size;
+    char field[128];
+
+    snprintf(field, sizeof(field), "{\"counter\":{\"gate_ms\":%lu,\"channels\":[", (unsigned long)s_gate_ms);
+    json_text_append(&ptr, &remaining, field);
+    bool first = true;
+    for (uint8_t i = 0; i < FREQ_COUNTER_CHANNELS; ++i) {
+        if (s_channel_mask & (1U << i)) {
+            if (!first) {
+                json_text_append(&ptr, &remaining, ",");
+            }
+            format_channel(field, sizeof(field), i, &results[i]);
+            json_text_append(&ptr, &remaining, field);
+            first = false;
+        }
+    }
+    json_text_append(&ptr, &remaining, "]}}");
+    return true;
+}
+
+// --- ISRs ---
+
+void TIM6_DAC_IRQHandler(void) {
+    if (timer_is_update_interrupt_flag_set(s_slice_timer)) {
+        timer_clear_update_interrupt_flag(s_slice_timer);
+        end_slice();
+    }
+}
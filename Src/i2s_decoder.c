@@ -0,0 +1,275 @@
+/**
+ * @file      i2s_decoder.c
+ * @brief     I2S, left-justified and TDM audio decoder for GPIOB sample segments.
+ */
+
+#include <stdio.h>
+
+#include "i2s_decoder.h"
+#include "json_text.h"
+
+#define GPIOB_PIN_COUNT         16U
+#define RMS_ACCUMULATOR_BITS    24U     // Wider samples are scaled down before squaring
+
+// --- Static Data ---
+static i2s_decoder_config_t s_config = {
+    .format = I2S_FORMAT_I2S,
+    .slot_bits = 16,
+    .slots = 2,
+    .bclk_pin = 2,
+    .fs_pin = 1,
+    .sd_pin = 0,
+    .pcm = true,
+    .summary = false,
+};
+static uint8_t s_bytes_per_sample = 2;
+static uint32_t s_slot_capacity = 0;    // PCM samples kept per slot and block
+
+// Frame alignment, kept across segments
+static uint8_t s_prev_bclk = 0;
+static uint8_t s_prev_fs = 0;
+static bool s_aligned = false;
+static bool s_slot_done = false;        // Current slot complete; ignore bits until the next slot starts
+static uint8_t s_slot = 0;
+static uint8_t s_bits = 0;
+static uint32_t s_value = 0;
+
+// Current block
+static uint8_t s_pcm[I2S_DECODER_MAX_BLOCK_BYTES];
+static uint32_t s_pcm_count[I2S_DECODER_MAX_SLOTS];
+static uint32_t s_sample_count[I2S_DECODER_MAX_SLOTS];
+static uint32_t s_peak[I2S_DECODER_MAX_SLOTS];
+static uint64_t s_sum_squares[I2S_DECODER_MAX_SLOTS];
+static uint32_t s_frames = 0;
+static uint32_t s_dropped = 0;
+
+// --- Private Helper Functions ---
+
+static void append_base64(char** buf, size_t* remaining, const uint8_t* bytes, uint32_t count) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    char quad[5] = { 0 };
+
+    for (uint32_t i = 0; i < count; i += 3) {
+        uint32_t left = count - i;
+        uint32_t group = (uint32_t)bytes[i] << 16;
+        if (left > 1) group |= (uint32_t)bytes[i + 1] << 8;
+        if (left > 2) group |= bytes[i + 2];
+
+        quad[0] = alphabet[(group >> 18) & 0x3F];
+        quad[1] = alphabet[(group >> 12) & 0x3F];
+        quad[2] = (left > 1) ? alphabet[(group >> 6) & 0x3F] : '=';
+        quad[3] = (left > 2) ? alphabet[group & 0x3F] : '=';
+        json_text_append(buf, remaining, quad);
+    }
+}
+
+static uint32_t isqrt64(uint64_t value) {
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
+
+static void start_block(void) {
+    for (uint8_t i = 0; i < I2S_DECODER_MAX_SLOTS; ++i) {
+        s_pcm_count[i] = 0;
+        s_sample_count[i] = 0;
+        s_peak[i] = 0;
+        s_sum_squares[i] = 0;
+    }
+    s_frames = 0;
+    s_dropped = 0;
+}
+
+static void take_sample(uint8_t slot, int32_t sample) {
+    uint32_t magnitude = (sample < 0) ? (uint32_t)(-(int64_t)sample) : (uint32_t)sample;
+    if (magnitude > s_peak[slot]) {
+        s_peak[slot] = magnitude;
+    }
+
+    // Squares of samples past 24 bits would overflow the sum within a block
+    uint8_t shift = (s_config.slot_bits > RMS_ACCUMULATOR_BITS) ? s_config.slot_bits - RMS_ACCUMULATOR_BITS : 0;
+    uint64_t scaled = magnitude >> shift;
+    s_sum_squares[slot] += scaled * scaled;
+    s_sample_count[slot]++;
+
+    if (s_config.pcm) {
+        if (s_pcm_count[slot] < s_slot_capacity) {
+            uint8_t* out = &s_pcm[(slot * s_slot_capacity + s_pcm_count[slot]) * s_bytes_per_sample];
+            for (uint8_t i = 0; i < s_bytes_per_sample; ++i) {
+                out[i] = (uint8_t)((uint32_t)sample >> (8U * i));
+            }
+            s_pcm_count[slot]++;
+        } else {
+            s_dropped++;
+        }
+    }
+
+    if (slot + 1U == s_config.slots) {
+        s_frames++;
+    }
+}
+
+static void shift_bit(uint8_t bit) {
+    if (!s_aligned || s_slot_done) {
+        return;
+    }
+
+    s_value = (s_value << 1) | bit;
+    if (++s_bits < s_config.slot_bits) {
+        return;
+    }
+
+    // Sign-extend from the slot width
+    uint8_t unused = 32U - s_config.slot_bits;
+    take_sample(s_slot, (int32_t)(s_value << unused) >> unused);
+
+    if (s_config.format == I2S_FORMAT_TDM && s_slot + 1U < s_config.slots) {
+        s_slot++;
+        s_bits = 0;
+        s_value = 0;
+    } else {
+        s_slot_done = true;
+    }
+}
+
+/**
+ * @brief Handles the SD and FS levels read on one rising BCLK edge.
+ */
+static void take_clock(uint8_t sd, uint8_t fs) {
+    bool start;
+    uint8_t slot = 0;
+    switch (s_config.format) {
+        case I2S_FORMAT_TDM:
+            start = fs && !s_prev_fs;
+            break;
+        case I2S_FORMAT_LEFT_JUSTIFIED:
+            start = fs != s_prev_fs;
+            slot = !fs;
+            break;
+        default:
+            start = fs != s_prev_fs;
+            slot = fs;
+            break;
+    }
+    s_prev_fs = fs;
+
+    if (!start) {
+        shift_bit(sd);
+        return;
+    }
+
+    // With a one-bit delay, the bit read with the frame edge ends the slot before
+    bool delayed = s_config.format != I2S_FORMAT_LEFT_JUSTIFIED;
+    if (delayed) {
+        shift_bit(sd);
+    }
+    s_aligned = true;
+    s_slot_done = false;
+    s_slot = slot;
+    s_bits = 0;
+    s_value = 0;
+    if (!delayed) {
+        shift_bit(sd);
+    }
+}
+
+static void format_block(uint32_t first_sample, char* json_buffer, size_t json_buffer_size) {
+    char* ptr = json_buffer;
+    size_t remaining = json_buffer_size;
+    char field[48];
+
+    snprintf(field, sizeof(field), "{\"protocol\":\"I2S\",\"ts\":%lu,\"frames\":%lu,\"bits\":%u",
+             (unsigned long)first_sample, (unsigned long)s_frames, s_config.slot_bits);
+    json_text_append(&ptr, &remaining, field);
+
+    if (s_config.pcm) {
+        json_text_append(&ptr, &remaining, ",\"pcm\":[");
+        for (uint8_t slot = 0; slot < s_config.slots; ++slot) {
+            json_text_append(&ptr, &remaining, (slot == 0) ? "\"" : ",\"");
+            append_base64(&ptr, &remaining, &s_pcm[slot * s_slot_capacity * s_bytes_per_sample],
+                          s_pcm_count[slot] * s_bytes_per_sample);
+            json_text_append(&ptr, &remaining, "\"");
+        }
+        json_text_append(&ptr, &remaining, "]");
+        if (s_dropped > 0) {
+            snprintf(field, sizeof(field), ",\"dropped\":%lu", (unsigned long)s_dropped);
+            json_text_append(&ptr, &remaining, field);
+        }
+    }
+
+    if (s_config.summary) {
+        json_text_append(&ptr, &remaining, ",\"peak\":[");
+        for (uint8_t slot = 0; slot < s_config.slots; ++slot) {
+            snprintf(field, sizeof(field), "%s%lu", (slot == 0) ? "" : ",", (unsigned long)s_peak[slot]);
+            json_text_append(&ptr, &remaining, field);
+        }
+        json_text_append(&ptr, &remaining, "],\"rms\":[");
+        uint8_t shift = (s_config.slot_bits > RMS_ACCUMULATOR_BITS) ? s_config.slot_bits - RMS_ACCUMULATOR_BITS : 0;
+        for (uint8_t slot = 0; slot < s_config.slots; ++slot) {
+            uint32_t rms = s_sample_count[slot] ? isqrt64(s_sum_squares[slot] / s_sample_count[slot]) << shift : 0;
+            snprintf(field, sizeof(field), "%s%lu", (slot == 0) ? "" : ",", (unsigned long)rms);
+            json_text_append(&ptr, &remaining, field);
+        }
+        json_text_append(&ptr, &remaining, "]");
+    }
+    json_text_append(&ptr, &remaining, "}");
+}
+
+// --- Public API Function Implementations ---
+
+int i2s_decoder_configure(const i2s_decoder_config_t* config) {
+    // Invalid arguments
+    if (config == NULL || config->format > I2S_FORMAT_TDM || config->slot_bits < 8 || config->slot_bits > 32 ||
+        config->slots == 0 || config->slots > I2S_DECODER_MAX_SLOTS ||
+        (config->format != I2S_FORMAT_TDM && config->slots != 2) ||
+        config->bclk_pin >= GPIOB_PIN_COUNT || config->fs_pin >= GPIOB_PIN_COUNT || config->sd_pin >= GPIOB_PIN_COUNT) {
+        return -1;
+    }
+
+    s_config = *config;
+    s_bytes_per_sample = (uint8_t)((config->slot_bits + 7U) / 8U);
+    s_slot_capacity = I2S_DECODER_MAX_BLOCK_BYTES / (config->slots * s_bytes_per_sample);
+    s_aligned = false;
+    return 0;
+}
+
+void i2s_decoder_process(const uint16_t* samples, uint32_t count, uint32_t first_sample, bool clocked,
+                         char* json_buffer, size_t json_buffer_size) {
+    if (samples == NULL || count == 0) {
+        return;
+    }
+
+    if (first_sample == 0) {
+        s_aligned = false;
+        s_prev_fs = (samples[0] >> s_config.fs_pin) & 0x01;
+        s_prev_bclk = (samples[0] >> s_config.bclk_pin) & 0x01;
+    }
+    start_block();
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint16_t sample = samples[i];
+        if (!clocked) {
+            uint8_t bclk = (sample >> s_config.bclk_pin) & 0x01;
+            bool rising = bclk && !s_prev_bclk;
+            s_prev_bclk = bclk;
+            if (!rising) {
+                continue;
+            }
+        }
+        take_clock((sample >> s_config.sd_pin) & 0x01, (sample >> s_config.fs_pin) & 0x01);
+    }
+
+    format_block(first_sample, json_buffer, json_buffer_size);
+}
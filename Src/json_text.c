@@ -0,0 +1,18 @@
+/**
+ * @file      json_text.c
+ * @brief     Helpers for building JSON records in a fixed-size buffer.
+ */
+
+#include <stdio.h>
+
+#include "json_text.h"
+
+// --- Public API Function Implementations ---
+
+void json_text_append(char** buf, size_t* remaining, const char* text) {
+    int written = snprintf(*buf, *remaining, "%s", text);
+    if (written > 0 && (size_t)written < *remaining) {
+        *buf += written;
+        *remaining -= written;
+    }
+}
@@ -0,0 +1,341 @@
+/**
+ * @file      lin_decoder.c
+ * @brief     LIN frame decoder fed from the edge stream.
+ */
+
+#include <stdio.h>
+
+#include "lin_decoder.h"
+#include "capture_timebase.h"
+
+#define LIN_BREAK_BITS          11U     // Shortest break a slave must accept
+#define LIN_SYNC_FALLS          5U      // Falling edges of the 0x55 sync field, 8 bits apart end to end
+#define LIN_SYNC_SPAN_BITS      8U
+#define LIN_MAX_RESPONSE        9U      // 8 data bytes and the checksum
+#define LIN_DIAGNOSTIC_ID_FIRST 60U     // Diagnostic frames always use the classic checksum
+#define LIN_FRAME_MAX_BITS      174U    // 1.4 times the nominal length of an 8-byte frame
+
+typedef enum {
+    LIN_STATE_HUNT,         // Waiting for a break
+    LIN_STATE_SYNC,         // Measuring the sync field
+    LIN_STATE_BYTES,        // Protected identifier and response
+} lin_state_t;
+
+typedef enum {
+    LIN_ERROR_SYNC,
+    LIN_ERROR_PARITY,
+    LIN_ERROR_FRAMING,
+    LIN_ERROR_LENGTH,
+} lin_error_t;
+
+static const char* const s_error_names[] = { "sync", "parity", "framing", "length" };
+
+// --- Static Data ---
+static lin_decoder_config_t s_config = {
+    .channel = 0,
+    .bitrate = 0,
+    .id_filter = LIN_DECODER_ALL_IDS,
+};
+static uint32_t s_min_break = 0;        // Shortest low pulse taken as a break before the rate is known
+
+static lin_state_t s_state = LIN_STATE_HUNT;
+static uint8_t s_level = 1;
+static uint32_t s_fall_time = 0;
+
+static uint32_t s_break_time = 0;
+static uint32_t s_break_width = 0;
+static uint32_t s_sync_falls[LIN_SYNC_FALLS];
+static uint8_t s_sync_count = 0;
+static uint32_t s_bit_ticks = 0;        // Measured from the sync field
+
+static bool s_rx_active = false;        // A character is being received
+static uint8_t s_rx_bit = 0;            // 0 = start bit, 1-8 = data, 9 = stop bit
+static uint8_t s_rx_byte = 0;
+static uint32_t s_next_sample = 0;
+
+static bool s_has_pid = false;
+static uint8_t s_pid = 0;
+static uint8_t s_bytes[LIN_MAX_RESPONSE];
+static uint8_t s_byte_count = 0;
+
+static char* s_out = NULL;              // Buffer of the feed call in progress
+static size_t s_out_size = 0;
+static bool s_written = false;
+
+// --- Private Helper Functions ---
+
+static bool is_older(uint32_t time, uint32_t reference) {
+    return (int32_t)(time - reference) < 0;
+}
+
+static void hunt(void) {
+    s_state = LIN_STATE_HUNT;
+    s_rx_active = false;
+}
+
+static void report_error(lin_error_t type) {
+    if (!s_written) {
+        snprintf(s_out, s_out_size, "{\"lin_error\":{\"t\":%lu,\"type\":\"%s\"}}",
+                 (unsigned long)s_break_time, s_error_names[type]);
+        s_written = true;
+    }
+    hunt();
+}
+
+static bool parity_ok(uint8_t pid) {
+    uint8_t id = pid & 0x3FU;
+    uint8_t p0 = ((id >> 0) ^ (id >> 1) ^ (id >> 2) ^ (id >> 4)) & 1U;
+    uint8_t p1 = (~((id >> 1) ^ (id >> 3) ^ (id >> 4) ^ (id >> 5))) & 1U;
+    return pid == (uint8_t)(id | (p0 << 6) | (p1 << 7));
+}
+
+/**
+ * @brief Computes the checksum over the data bytes, and over the PID for the enhanced model.
+ */
+static uint8_t checksum(bool enhanced) {
+    uint16_t sum = enhanced ? s_pid : 0;
+    for (uint8_t i = 0; i + 1U < s_byte_count; ++i) {
+        sum += s_bytes[i];
+        if (sum > 0xFFU) {
+            sum -= 0xFFU;
+        }
+    }
+    return (uint8_t)~sum;
+}
+
+static void finish_frame(void) {
+    uint8_t id = s_pid & 0x3FU;
+    if (!s_has_pid || !((s_config.id_filter >> id) & 1U) || s_written) {
+        return;
+    }
+
+    const char* model = "none";
+    if (s_byte_count > 0) {
+        uint8_t received = s_bytes[s_byte_count - 1U];
+        if (id < LIN_DIAGNOSTIC_ID_FIRST && received == checksum(true)) {
+            model = "enhanced";
+        } else if (received == checksum(false)) {
+            model = "classic";
+        } else {
+            model = "bad";
+        }
+    }
+
+    static const char hex_digits[] = "0123456789ABCDEF";
+    char data[(LIN_MAX_RESPONSE - 1U) * 2U + 1U];
+    uint8_t data_length = s_byte_count > 0 ? s_byte_count - 1U : 0;
+    for (uint8_t i = 0; i < data_length; ++i) {
+        data[i * 2] = hex_digits[s_bytes[i] >> 4];
+        data[i * 2 + 1] = hex_digits[s_bytes[i] & 0x0F];
+    }
+    data[data_length * 2] = '\0';
+
+    snprintf(s_out, s_out_size, "{\"lin\":{\"t\":%lu,\"baud\":%lu,\"id\":%u,\"data\":\"%s\",\"checksum\":\"%s\"}}",
+             (unsigned long)s_break_time, (unsigned long)(CAPTURE_TIMEBASE_HZ / s_bit_ticks), id, data, model);
+    s_written = true;
+}
+
+static void take_byte(uint8_t byte) {
+    if (!s_has_pid) {
+        if (!parity_ok(byte)) {
+            report_error(LIN_ERROR_PARITY);
+            return;
+        }
+        s_pid = byte;
+        s_has_pid = true;
+        return;
+    }
+    if (s_byte_count == LIN_MAX_RESPONSE) {
+        report_error(LIN_ERROR_LENGTH);
+        return;
+    }
+    s_bytes[s_byte_count++] = byte;
+}
+
+/**
+ * @brief Takes every sample point of the character before `until` at the current line level.
+ */
+static void run_samples(uint32_t until) {
+    while (s_rx_active && is_older(s_next_sample, until)) {
+        uint8_t bit = s_level;
+        if (s_rx_bit == 0) {
+            // A glitch rather than a start bit
+            s_rx_active = bit == 0;
+        } else if (s_rx_bit <= 8) {
+            s_rx_byte |= (uint8_t)(bit << (s_rx_bit - 1U));
+        } else {
+            s_rx_active = false;
+            if (bit) {
+                take_byte(s_rx_byte);
+            } else {
+                report_error(LIN_ERROR_FRAMING);
+            }
+        }
+        s_rx_bit++;
+        s_next_sample += s_bit_ticks;
+    }
+}
+
+static bool is_break(uint32_t width) {
+    uint32_t threshold = (s_state == LIN_STATE_BYTES) ? LIN_BREAK_BITS * s_bit_ticks : s_min_break;
+    return width >= threshold;
+}
+
+static void start_sync(uint32_t fall_time, uint32_t rise_time) {
+    s_state = LIN_STATE_SYNC;
+    s_rx_active = false;
+    s_break_time = fall_time;
+    s_break_width = rise_time - fall_time;
+    s_sync_count = 0;
+}
+
+/**
+ * @brief Validates the sync field and takes its bit time.
+ */
+static void check_sync(void) {
+    uint32_t bit = (s_sync_falls[LIN_SYNC_FALLS - 1U] - s_sync_falls[0]) / LIN_SYNC_SPAN_BITS;
+    bool valid = bit >= CAPTURE_TIMEBASE_HZ / LIN_DECODER_MAX_BITRATE &&
+                 bit <= CAPTURE_TIMEBASE_HZ / LIN_DECODER_MIN_BITRATE &&
+                 s_break_width >= LIN_BREAK_BITS * bit;
+
+    // Falling edges every second bit
+    for (uint8_t i = 1; valid && i < LIN_SYNC_FALLS; ++i) {
+        uint32_t interval = s_sync_falls[i] - s_sync_falls[i - 1U];
+        valid = interval >= 2U * bit - bit / 2U && interval <= 2U * bit + bit / 2U;
+    }
+
+    if (valid && s_config.bitrate != 0) {
+        uint32_t nominal = CAPTURE_TIMEBASE_HZ / s_config.bitrate;
+        uint32_t tolerance = nominal * LIN_DECODER_BITRATE_TOLERANCE_PCT / 100U;
+        valid = bit >= nominal - tolerance && bit <= nominal + tolerance;
+    }
+
+    if (!valid) {
+        // Without a fixed rate, any low pulse may have been taken for a break
+        if (s_config.bitrate != 0) {
+            report_error(LIN_ERROR_SYNC);
+        } else {
+            hunt();
+        }
+        return;
+    }
+
+    s_bit_ticks = bit;
+    s_state = LIN_STATE_BYTES;
+    s_has_pid = false;
+    s_byte_count = 0;
+}
+
+// --- Decoder Interface ---
+
+static void lin_reset(void) {
+    hunt();
+    s_level = 1;
+}
+
+static bool lin_feed(const edge_t* edge, char* json_buffer, size_t json_buffer_size) {
+    if (edge->channel != s_config.channel) {
+        return false;
+    }
+
+    s_out = json_buffer;
+    s_out_size = json_buffer_size;
+    s_written = false;
+    uint8_t level = edge->level ? 1U : 0U;
+
+    if (edge->flags & EDGE_FLAG_SYNC) {
+        // Characters were lost: wait for the next break
+        hunt();
+        s_level = level;
+        s_fall_time = edge->time;
+        return false;
+    }
+
+    // A break ends the frame before it; its low time is not a character
+    if (level && !s_level && is_break(edge->time - s_fall_time)) {
+        if (s_state == LIN_STATE_BYTES) {
+            finish_frame();
+        }
+        start_sync(s_fall_time, edge->time);
+        s_level = level;
+        return s_written;
+    }
+
+    if (s_state == LIN_STATE_BYTES) {
+        run_samples(edge->time);
+    }
+    if (level == s_level) {
+        return s_written;
+    }
+    s_level = level;
+    if (level) {
+        return s_written;
+    }
+
+    s_fall_time = edge->time;
+    if (s_state == LIN_STATE_SYNC) {
+        s_sync_falls[s_sync_count++] = edge->time;
+        if (s_sync_count == LIN_SYNC_FALLS) {
+            check_sync();
+        }
+    } else if (s_state == LIN_STATE_BYTES && !s_rx_active) {
+        s_rx_active = true;
+        s_rx_bit = 0;
+        s_rx_byte = 0;
+        s_next_sample = edge->time + s_bit_ticks / 2U;
+    }
+    return s_written;
+}
+
+static bool lin_flush(uint32_t now, bool final, char* json_buffer, size_t json_buffer_size) {
+    if (s_state != LIN_STATE_BYTES) {
+        return false;
+    }
+
+    s_out = json_buffer;
+    s_out_size = json_buffer_size;
+    s_written = false;
+
+    // A low line may be the next break rather than a character, so only sample it once it rises
+    if (s_level) {
+        run_samples(now);
+        if (s_written) {
+            return true;
+        }
+    }
+
+    // Without a next break, the frame ends when no response can still be running
+    if (!final && (!s_level || s_rx_active || now - s_break_time < LIN_FRAME_MAX_BITS * s_bit_ticks)) {
+        return false;
+    }
+    finish_frame();
+    hunt();
+    return s_written;
+}
+
+const edge_decoder_t lin_decoder = {
+    .name = "lin",
+    .reset = lin_reset,
+    .feed = lin_feed,
+    .flush = lin_flush,
+};
+
+// --- Public API Function Implementations ---
+
+int lin_decoder_configure(const lin_decoder_config_t* config) {
+    // Invalid arguments
+    if (config == NULL || (config->bitrate != 0 &&
+        (config->bitrate < LIN_DECODER_MIN_BITRATE || config->bitrate > LIN_DECODER_MAX_BITRATE))) {
+        return -1;
+    }
+
+    s_config = *config;
+    if (config->bitrate != 0) {
+        uint32_t nominal = CAPTURE_TIMEBASE_HZ / config->bitrate;
+        s_min_break = LIN_BREAK_BITS * (nominal - nominal * LIN_DECODER_BITRATE_TOLERANCE_PCT / 100U);
+    } else {
+        s_min_break = LIN_BREAK_BITS * (CAPTURE_TIMEBASE_HZ / LIN_DECODER_MAX_BITRATE);
+    }
+    lin_reset();
+    return 0;
+}
@@ -32,12 +32,47 @@
 #include "queue.h"
 #include "semphr.h"
 
+#include "capture_arena.h"
+#include "dma_bench.h"
+#include "dma_memcpy.h"
+#include "dispatch_bench.h"
+#include "spi_sniffer.h"
+#include "uart_sniffer.h"
+#include "spi_sampler.h"
+#include "timer_capture.h"
+#include "sync_sampler.h"
+#include "freq_counter.h"
+#include "encoder_capture.h"
+#include "analog_capture.h"
+#include "edge_stream.h"
+#include "can_decoder.h"
+#include "onewire_decoder.h"
+#include "lin_decoder.h"
+#include "manchester_decoder.h"
+#include "ws2812_decoder.h"
+#include "swd_decoder.h"
+#include "pwm_stats.h"
+#include "timing_check.h"
+#include "i2s_decoder.h"
+#include "capture_timebase.h"
+#include "system_clock.h"
+#include "exti.h"
+
 // --- Configuration Constants ---
-#define F_CPU 72000000UL
+#define F_CPU SYSTEM_CLOCK_HZ // Set up by clock_setup()
 #define SAMPLING_FREQUENCY_HZ 1000000 // 1 Msps
 #define TIMER_PERIOD (F_CPU / SAMPLING_FREQUENCY_HZ)
-#define DMA_BUFFER_SIZE 1024 // Total size of the circular buffer
-#define DMA_BUFFER_HALF_SIZE (DMA_BUFFER_SIZE / 2)
+
+// TIM2 ticks are counted as CPU cycles by the trigger latency probe
+#if SYSTEM_CLOCK_APB1_TIMER_HZ != SYSTEM_CLOCK_HZ
+#error "TIM2 must run at the CPU clock"
+#endif
+
+// --- External Trigger ---
+#define TRIGGER_PORT 0          // PA0 = TIM2_CH1
+#define TRIGGER_PIN 0
+#define TRIGGER_SYNC_TICKS 2    // TI1 resynchronization before TIM2 starts counting
+#define TRIGGER_WAIT_CYCLES (2 * TIMER_PERIOD) // Longest the probe waits for the first sample
 
 // --- Task Configuration ---
 #define COMM_TASK_STACK_SIZE     (configMINIMAL_STACK_SIZE + 256)
@@ -48,10 +83,17 @@
 // --- Communication Buffers ---
 #define UART_RX_BUFFER_SIZE 128
 #define JSON_OUTPUT_BUFFER_SIZE 2048 // Large buffer to build the JSON response
+#define REPLY_BUFFER_SIZE 256 // Direct replies to commands
+#define GPIO_TRANSITION_MAX_CHARS 15 // ",[<uint32>,<bit>]" in a GPIO waveform
+#define HW_CAPTURE_POLL_MS 5 // How often hardware-assisted modes are drained
+#define OUTPUT_FRAME_COUNT 2 // Records in flight between the ProcessingTask and the CommunicationTask
+#define OUTPUT_STAGING_COUNT 2 // Records being formatted or copied out to a frame
 
 // --- Global State & Data ---
-typedef enum { IDLE, CAPTURING } AnalyzerState;
-typedef enum { PROTO_GPIO, PROTO_SPI, PROTO_I2C, PROTO_UART } ProtocolType;
+typedef enum { IDLE, CAPTURING, STOPPING } AnalyzerState;
+typedef enum { PROTO_GPIO, PROTO_SPI, PROTO_I2C, PROTO_UART, PROTO_SPI_SNIFF, PROTO_UART_SNIFF, PROTO_SPI_SAMPLE, PROTO_TIMER_CAPTURE,
+               PROTO_FREQ_COUNTER, PROTO_ENCODER, PROTO_PARALLEL, PROTO_I2S } ProtocolType;
+typedef enum { DECODER_NONE, DECODER_CAN, DECODER_ONEWIRE, DECODER_LIN, DECODER_MANCHESTER, DECODER_WS2812, DECODER_SWD, DECODER_PWM, DECODER_TIMING } DecoderType;
 
 typedef struct {
     volatile AnalyzerState state;
@@ -60,18 +102,149 @@ typedef struct {
     struct {
         int cpol;
         int cpha;
+        int prescaler; // SPI_SAMPLE: sample clock = SPI_SAMPLER_KERNEL_HZ / 2^(prescaler + 1)
     } spi_params;
+    struct {
+        uint32_t baud;
+        uart_parity_t parity;
+        int stop_bits;
+    } uart_params;
+    struct {
+        int channel_mask;
+        int filter;
+        int gate_ms;    // FREQ_COUNTER: one result per gate period
+        int rate_hz;    // ENCODER: position snapshots per second
+    } capture_params;
+    struct {
+        int channels;               // SPI_SAMPLE/TIMER_CAPTURE: ADC inputs scanned alongside (0 = none)
+        int rate_hz;
+        int bits;                   // 12, 10, 8 or 6
+        int sample_cycles;          // 3, 15, 28, 56, 84, 112, 144 or 480
+        int watchdog_input;         // Input whose analog watchdog triggers the capture (-1 = none)
+        int watchdog_low;           // Window on the 12-bit scale
+        int watchdog_high;
+        int pre_trigger_us;         // History reported from before the watchdog trigger
+    } analog_params;
+    struct {
+        int width;                  // PARALLEL: 8 (PB0-PB7) or 4 (PB0-PB3) data bits
+        int strobe_pin;             // PB8-PB15; write strobe, or the only strobe
+        int read_pin;               // PB8-PB15 read strobe, or -1
+        int cs_pin;                 // PB8-PB15 chip select (active low), or -1
+        int addr_pin;               // PB8-PB15 address/command line (A0, D/C), or -1
+        bool falling_edge;          // Strobe edge that latches the data
+    } parallel_params;
+    struct {
+        i2s_format_t format;
+        int slot_bits;
+        int slots;                  // TDM only; I2S and left-justified have 2
+        int bclk_pin;               // GPIOB pins; BCLK is only read with TIM2 sampling
+        int fs_pin;
+        int sd_pin;
+        bool pcm;                   // Send the samples
+        bool summary;               // Send peak and RMS per slot
+    } i2s_params;
+    struct {
+        bool external;              // Sample on edges of PE7 instead of TIM2
+        bool falling_edge;
+    } clock_params;
+    struct {
+        bool enabled;               // Wait for an edge on PA0 before sampling
+        exti_trigger_t edge;
+    } trigger_params;
+    struct {
+        DecoderType type;           // SPI_SAMPLE/TIMER_CAPTURE: decoder fed from the edge stream
+        int channel;                // Edge-stream channel decoded (the clock for clocked buses)
+        int data_channel;           // SWD: SWDIO
+        uint32_t bitrate;           // 0 = the decoder's default (auto-baud for LIN)
+    } decoder_params;
+    struct {
+        uint32_t id_mask;           // Identifier bits compared with id_match (0 = any)
+        uint32_t id_match;
+        uint32_t id_min;
+        uint32_t id_max;
+    } can_params;
+    struct {
+        uint64_t id_filter;         // Bit n set to report identifier n
+    } lin_params;
+    struct {
+        manchester_code_t code;
+        uint32_t sync_word;         // Last bit received in bit 0
+        int sync_bits;
+        bool lsb_first;
+    } manchester_params;
+    struct {
+        int threshold_ns;           // High times from this on are a 1
+        int reset_us;               // Low time that latches a frame
+        bool diff;                  // Send only changed pixels
+    } ws2812_params;
+    struct {
+        int window_ms;              // One summary per channel and window
+    } pwm_params;
+    struct {
+        int min_pulse_ns;           // Limits in ns, 0 = check off
+        timing_bus_t bus;           // Clock on decoder_channel, data on data_channel
+        bool sample_falling;        // SPI: data sampled on falling clock edges
+        int setup_ns;
+        int hold_ns;
+        int skew_mask;              // Channels that switch together
+        int skew_ns;
+        int skew_window_ns;
+    } timing_params;
 } AnalyzerConfig;
 
-static AnalyzerConfig analyzer_config = { .state = IDLE, .protocol = PROTO_GPIO };
-static uint16_t dma_capture_buffer[DMA_BUFFER_SIZE];
-static char json_output_buffer[JSON_OUTPUT_BUFFER_SIZE];
+static AnalyzerConfig analyzer_config = {
+    .state = IDLE,
+    .protocol = PROTO_GPIO,
+    .uart_params = { .baud = 115200, .parity = UART_PARITY_NONE, .stop_bits = 1 },
+    .capture_params = { .channel_mask = 0x1, .filter = 0, .gate_ms = FREQ_COUNTER_DEFAULT_GATE_MS,
+                        .rate_hz = ENCODER_CAPTURE_DEFAULT_RATE_HZ },
+    .analog_params = { .channels = 0, .rate_hz = ANALOG_CAPTURE_DEFAULT_RATE_HZ, .bits = 12, .sample_cycles = 15,
+                       .watchdog_input = -1, .watchdog_low = 0, .watchdog_high = 4095, .pre_trigger_us = 1000 },
+    .parallel_params = { .width = 8, .strobe_pin = 8, .read_pin = -1, .cs_pin = -1, .addr_pin = -1, .falling_edge = false },
+    .i2s_params = { .format = I2S_FORMAT_I2S, .slot_bits = 16, .slots = 2, .bclk_pin = 2, .fs_pin = 1, .sd_pin = 0,
+                    .pcm = true, .summary = false },
+    .clock_params = { .external = false, .falling_edge = false },
+    .trigger_params = { .enabled = false, .edge = EXTI_TRIGGER_RISING },
+    .decoder_params = { .type = DECODER_NONE, .channel = 0, .data_channel = 1, .bitrate = 0 },
+    .can_params = { .id_mask = 0, .id_match = 0, .id_min = 0, .id_max = CAN_DECODER_MAX_ID },
+    .lin_params = { .id_filter = LIN_DECODER_ALL_IDS },
+    .manchester_params = { .code = MANCHESTER_CODE_IEEE, .sync_word = 0, .sync_bits = 0, .lsb_first = false },
+    .ws2812_params = { .threshold_ns = WS2812_DECODER_DEFAULT_THRESHOLD_NS, .reset_us = WS2812_DECODER_DEFAULT_RESET_US,
+                       .diff = false },
+    .pwm_params = { .window_ms = PWM_STATS_DEFAULT_WINDOW_MS },
+    .timing_params = { .min_pulse_ns = 0, .bus = TIMING_BUS_NONE, .sample_falling = false, .setup_ns = 0, .hold_ns = 0,
+                       .skew_mask = 0, .skew_ns = 0, .skew_window_ns = 0 },
+};
+// The ProcessingTask formats into json_output_buffer, one of the staging buffers
+static char output_staging[OUTPUT_STAGING_COUNT][JSON_OUTPUT_BUFFER_SIZE] __attribute__((aligned(16)));
+static char* json_output_buffer = output_staging[0];
+static uint8_t output_staging_index = 0;
+
+// Records handed to the CommunicationTask, copied out of a staging buffer by DMA
+static char output_frames[OUTPUT_FRAME_COUNT][JSON_OUTPUT_BUFFER_SIZE] __attribute__((aligned(16)));
+
+typedef struct {
+    char* frame;
+    size_t length;
+} output_copy_t;
+static output_copy_t output_copies[OUTPUT_STAGING_COUNT]; // Copy in flight out of each staging buffer
+
+// Index of the arena segment the DMA is currently filling
+static volatile uint8_t dma_active_segment = 0;
+
+// Latency probe on the trigger pin; see trigger_arm()
+static exti_handle_t trigger_exti = NULL;
+static volatile bool trigger_fired = false;
+static volatile uint32_t trigger_isr_ticks = 0; // TIM2 ticks from the hardware start to the EXTI ISR
+static volatile uint32_t trigger_sample_cycles = 0; // DWT cycles from the EXTI ISR to the first DMA sample
+static volatile bool trigger_sample_seen = false;
 
 // --- RTOS Handles ---
 static QueueHandle_t uart_rx_queue = NULL;
 static QueueHandle_t json_output_queue = NULL;
-static SemaphoreHandle_t dma_transfer_complete_sem = NULL;
-volatile bool dma_first_half_done = false;
+static QueueHandle_t free_frame_queue = NULL;   // Output frames not yet holding a record
+static QueueHandle_t free_staging_queue = NULL; // Indices of staging buffers with no copy in flight
+static QueueHandle_t segment_ready_queue = NULL; // Indices of filled arena segments
 
 // --- Function Prototypes ---
 static void clock_setup(void);
@@ -79,24 +252,54 @@ static void gpio_setup(void);
 static void usart_setup(void);
 static void timer_setup(void);
 static void dma_setup(void);
+static void dma_start_segment(uint8_t index);
+static void send_line(const char* line);
+static void publish_json_output(void);
+static void output_copy_callback(int status, void* user_data);
+static bool is_hardware_capture(ProtocolType protocol);
+static int start_hardware_capture(char* reply_buffer, size_t reply_buffer_size);
+static void stop_hardware_capture(void);
+static int configure_decoder(const edge_decoder_t** decoder);
+static int configure_i2s(void);
+static int start_analog_capture(char* reply_buffer, size_t reply_buffer_size);
+static void poll_hardware_capture(void);
+static void finish_hardware_capture(void);
+static void sync_segment_ready(uint8_t segment);
+static void trigger_arm(void);
+static void trigger_disarm(void);
+static void trigger_edge_callback(uint8_t line_num, void* user_data);
 void CommunicationTask(void *pvParameters);
 void ProcessingTask(void *pvParameters);
 static void process_gpio(uint16_t* data_buffer, uint32_t len, char* json_buffer, size_t json_buffer_size);
-// Add prototypes for other protocol processors
-// static void process_spi(...);
+static void process_spi(uint16_t* data_buffer, uint32_t len, char* json_buffer, size_t json_buffer_size);
+static void process_i2c(uint16_t* data_buffer, uint32_t len, char* json_buffer, size_t json_buffer_size);
+static void process_uart(uint16_t* data_buffer, uint32_t len, char* json_buffer, size_t json_buffer_size);
+static void process_parallel(uint16_t* data_buffer, uint32_t len, uint32_t first_sample, bool clocked,
+                             char* json_buffer, size_t json_buffer_size);
 
 // --- Main Application ---
 int main(void) {
+    capture_arena_init();
     clock_setup();
     gpio_setup();
     dma_setup();
     usart_setup();
     timer_setup(); // Timer is started by a command
+    dma_memcpy_init();
 
     // Create RTOS objects
     uart_rx_queue = xQueueCreate(1, UART_RX_BUFFER_SIZE);
-    json_output_queue = xQueueCreate(1, sizeof(char*));
-    dma_transfer_complete_sem = xSemaphoreCreateBinary();
+    json_output_queue = xQueueCreate(OUTPUT_FRAME_COUNT, sizeof(char*));
+    free_frame_queue = xQueueCreate(OUTPUT_FRAME_COUNT, sizeof(char*));
+    for (int i = 0; i < OUTPUT_FRAME_COUNT; i++) {
+        char* frame = output_frames[i];
+        xQueueSend(free_frame_queue, &frame, 0);
+    }
+    free_staging_queue = xQueueCreate(OUTPUT_STAGING_COUNT, sizeof(uint8_t));
+    for (uint8_t i = 1; i < OUTPUT_STAGING_COUNT; i++) {
+        xQueueSend(free_staging_queue, &i, 0); // Staging buffer 0 is json_output_buffer
+    }
+    segment_ready_queue = xQueueCreate(CAPTURE_ARENA_MAX_SEGMENTS, sizeof(uint8_t));
 
     // Create Tasks
     xTaskCreate(CommunicationTask, "CommTask", COMM_TASK_STACK_SIZE, NULL, COMM_TASK_PRIORITY, NULL);
@@ -118,6 +321,7 @@ int main(void) {
 void CommunicationTask(void *pvParameters) {
     (void)pvParameters;
     char rx_buffer[UART_RX_BUFFER_SIZE];
+    char reply_buffer[REPLY_BUFFER_SIZE];
     char* json_to_send;
 
     for (;;) {
@@ -127,88 +331,797 @@ void CommunicationTask(void *pvParameters) {
             char *cmd_ptr = strstr(rx_buffer, "\"command\": \"");
             if (cmd_ptr) {
                 cmd_ptr += strlen("\"command\": \"");
-                if (strncmp(cmd_ptr, "configure", 9) == 0) {
+                if (strncmp(cmd_ptr, "configure", 9) == 0 && analyzer_config.state != IDLE) {
+                    // Stop and poll follow the configuration, so it must not change under a running capture
+                    send_line("{\"log\":\"Stop the capture before configuring\"}");
+                } else if (strncmp(cmd_ptr, "configure", 9) == 0) {
                     char *proto_ptr = strstr(rx_buffer, "\"protocol\": \"");
                     if (proto_ptr) {
                         proto_ptr += strlen("\"protocol\": \"");
                         if (strncmp(proto_ptr, "GPIO", 4) == 0) analyzer_config.protocol = PROTO_GPIO;
+                        else if (strncmp(proto_ptr, "SPI_SNIFF", 9) == 0) analyzer_config.protocol = PROTO_SPI_SNIFF;
+                        else if (strncmp(proto_ptr, "SPI_SAMPLE", 10) == 0) analyzer_config.protocol = PROTO_SPI_SAMPLE;
                         else if (strncmp(proto_ptr, "SPI", 3) == 0) analyzer_config.protocol = PROTO_SPI;
+                        else if (strncmp(proto_ptr, "TIMER_CAPTURE", 13) == 0) analyzer_config.protocol = PROTO_TIMER_CAPTURE;
+                        else if (strncmp(proto_ptr, "FREQ_COUNTER", 12) == 0) analyzer_config.protocol = PROTO_FREQ_COUNTER;
+                        else if (strncmp(proto_ptr, "ENCODER", 7) == 0) analyzer_config.protocol = PROTO_ENCODER;
+                        else if (strncmp(proto_ptr, "I2C", 3) == 0) analyzer_config.protocol = PROTO_I2C;
+                        else if (strncmp(proto_ptr, "UART_SNIFF", 10) == 0) analyzer_config.protocol = PROTO_UART_SNIFF;
+                        else if (strncmp(proto_ptr, "UART", 4) == 0) analyzer_config.protocol = PROTO_UART;
+                        else if (strncmp(proto_ptr, "PARALLEL", 8) == 0) analyzer_config.protocol = PROTO_PARALLEL;
+                        else if (strncmp(proto_ptr, "I2S", 3) == 0) analyzer_config.protocol = PROTO_I2S;
                         // ... Parse other protocols and their parameters here
                     }
+                    char *cpol_ptr = strstr(rx_buffer, "\"cpol\": ");
+                    if (cpol_ptr) analyzer_config.spi_params.cpol = atoi(cpol_ptr + strlen("\"cpol\": "));
+                    char *cpha_ptr = strstr(rx_buffer, "\"cpha\": ");
+                    if (cpha_ptr) analyzer_config.spi_params.cpha = atoi(cpha_ptr + strlen("\"cpha\": "));
+                    char *presc_ptr = strstr(rx_buffer, "\"prescaler\": ");
+                    if (presc_ptr) analyzer_config.spi_params.prescaler = atoi(presc_ptr + strlen("\"prescaler\": "));
+                    char *chan_ptr = strstr(rx_buffer, "\"channels\": ");
+                    if (chan_ptr) analyzer_config.capture_params.channel_mask = atoi(chan_ptr + strlen("\"channels\": "));
+                    char *filter_ptr = strstr(rx_buffer, "\"filter\": ");
+                    if (filter_ptr) analyzer_config.capture_params.filter = atoi(filter_ptr + strlen("\"filter\": "));
+                    char *gate_ptr = strstr(rx_buffer, "\"gate_ms\": ");
+                    if (gate_ptr) analyzer_config.capture_params.gate_ms = atoi(gate_ptr + strlen("\"gate_ms\": "));
+                    char *rate_ptr = strstr(rx_buffer, "\"rate_hz\": ");
+                    if (rate_ptr) analyzer_config.capture_params.rate_hz = atoi(rate_ptr + strlen("\"rate_hz\": "));
+                    char *analog_ptr = strstr(rx_buffer, "\"analog\": ");
+                    if (analog_ptr) analyzer_config.analog_params.channels = atoi(analog_ptr + strlen("\"analog\": "));
+                    char *analog_rate_ptr = strstr(rx_buffer, "\"analog_rate_hz\": ");
+                    if (analog_rate_ptr) analyzer_config.analog_params.rate_hz = atoi(analog_rate_ptr + strlen("\"analog_rate_hz\": "));
+                    char *bits_ptr = strstr(rx_buffer, "\"adc_bits\": ");
+                    if (bits_ptr) analyzer_config.analog_params.bits = atoi(bits_ptr + strlen("\"adc_bits\": "));
+                    char *cycles_ptr = strstr(rx_buffer, "\"adc_sample_cycles\": ");
+                    if (cycles_ptr) analyzer_config.analog_params.sample_cycles = atoi(cycles_ptr + strlen("\"adc_sample_cycles\": "));
+                    char *awd_input_ptr = strstr(rx_buffer, "\"awd_input\": ");
+                    if (awd_input_ptr) analyzer_config.analog_params.watchdog_input = atoi(awd_input_ptr + strlen("\"awd_input\": "));
+                    char *awd_low_ptr = strstr(rx_buffer, "\"awd_low\": ");
+                    if (awd_low_ptr) analyzer_config.analog_params.watchdog_low = atoi(awd_low_ptr + strlen("\"awd_low\": "));
+                    char *awd_high_ptr = strstr(rx_buffer, "\"awd_high\": ");
+                    if (awd_high_ptr) analyzer_config.analog_params.watchdog_high = atoi(awd_high_ptr + strlen("\"awd_high\": "));
+                    char *pre_ptr = strstr(rx_buffer, "\"pre_trigger_us\": ");
+                    if (pre_ptr) analyzer_config.analog_params.pre_trigger_us = atoi(pre_ptr + strlen("\"pre_trigger_us\": "));
+                    char *baud_ptr = strstr(rx_buffer, "\"baud\": ");
+                    if (baud_ptr) analyzer_config.uart_params.baud = (uint32_t)strtoul(baud_ptr + strlen("\"baud\": "), NULL, 10);
+                    char *parity_ptr = strstr(rx_buffer, "\"parity\": \"");
+                    if (parity_ptr) {
+                        parity_ptr += strlen("\"parity\": \"");
+                        if (strncmp(parity_ptr, "even", 4) == 0) analyzer_config.uart_params.parity = UART_PARITY_EVEN;
+                        else if (strncmp(parity_ptr, "odd", 3) == 0) analyzer_config.uart_params.parity = UART_PARITY_ODD;
+                        else analyzer_config.uart_params.parity = UART_PARITY_NONE;
+                    }
+                    char *stop_ptr = strstr(rx_buffer, "\"stop_bits\": ");
+                    if (stop_ptr) analyzer_config.uart_params.stop_bits = atoi(stop_ptr + strlen("\"stop_bits\": "));
+                    char *width_ptr = strstr(rx_buffer, "\"bus_width\": ");
+                    if (width_ptr) analyzer_config.parallel_params.width = (atoi(width_ptr + strlen("\"bus_width\": ")) == 4) ? 4 : 8;
+                    char *strobe_ptr = strstr(rx_buffer, "\"strobe_pin\": ");
+                    if (strobe_ptr) analyzer_config.parallel_params.strobe_pin = atoi(strobe_ptr + strlen("\"strobe_pin\": "));
+                    char *read_pin_ptr = strstr(rx_buffer, "\"read_pin\": ");
+                    if (read_pin_ptr) analyzer_config.parallel_params.read_pin = atoi(read_pin_ptr + strlen("\"read_pin\": "));
+                    char *cs_pin_ptr = strstr(rx_buffer, "\"cs_pin\": ");
+                    if (cs_pin_ptr) analyzer_config.parallel_params.cs_pin = atoi(cs_pin_ptr + strlen("\"cs_pin\": "));
+                    char *addr_pin_ptr = strstr(rx_buffer, "\"addr_pin\": ");
+                    if (addr_pin_ptr) analyzer_config.parallel_params.addr_pin = atoi(addr_pin_ptr + strlen("\"addr_pin\": "));
+                    char *strobe_edge_ptr = strstr(rx_buffer, "\"strobe_edge\": \"");
+                    if (strobe_edge_ptr) {
+                        strobe_edge_ptr += strlen("\"strobe_edge\": \"");
+                        analyzer_config.parallel_params.falling_edge = (strncmp(strobe_edge_ptr, "falling", 7) == 0);
+                    }
+                    char *format_ptr = strstr(rx_buffer, "\"audio_format\": \"");
+                    if (format_ptr) {
+                        format_ptr += strlen("\"audio_format\": \"");
+                        if (strncmp(format_ptr, "lj", 2) == 0) analyzer_config.i2s_params.format = I2S_FORMAT_LEFT_JUSTIFIED;
+                        else if (strncmp(format_ptr, "tdm", 3) == 0) analyzer_config.i2s_params.format = I2S_FORMAT_TDM;
+                        else analyzer_config.i2s_params.format = I2S_FORMAT_I2S;
+                    }
+                    char *slot_bits_ptr = strstr(rx_buffer, "\"slot_bits\": ");
+                    if (slot_bits_ptr) analyzer_config.i2s_params.slot_bits = atoi(slot_bits_ptr + strlen("\"slot_bits\": "));
+                    char *slots_ptr = strstr(rx_buffer, "\"slots\": ");
+                    if (slots_ptr) analyzer_config.i2s_params.slots = atoi(slots_ptr + strlen("\"slots\": "));
+                    char *bclk_ptr = strstr(rx_buffer, "\"bclk_pin\": ");
+                    if (bclk_ptr) analyzer_config.i2s_params.bclk_pin = atoi(bclk_ptr + strlen("\"bclk_pin\": "));
+                    char *fs_ptr = strstr(rx_buffer, "\"fs_pin\": ");
+                    if (fs_ptr) analyzer_config.i2s_params.fs_pin = atoi(fs_ptr + strlen("\"fs_pin\": "));
+                    char *sd_ptr = strstr(rx_buffer, "\"sd_pin\": ");
+                    if (sd_ptr) analyzer_config.i2s_params.sd_pin = atoi(sd_ptr + strlen("\"sd_pin\": "));
+                    char *pcm_ptr = strstr(rx_buffer, "\"pcm\": ");
+                    if (pcm_ptr) analyzer_config.i2s_params.pcm = atoi(pcm_ptr + strlen("\"pcm\": ")) != 0;
+                    char *summary_ptr = strstr(rx_buffer, "\"summary\": ");
+                    if (summary_ptr) analyzer_config.i2s_params.summary = atoi(summary_ptr + strlen("\"summary\": ")) != 0;
+                    char *clock_ptr = strstr(rx_buffer, "\"clock\": \"");
+                    if (clock_ptr) {
+                        clock_ptr += strlen("\"clock\": \"");
+                        analyzer_config.clock_params.external = (strncmp(clock_ptr, "ext_", 4) == 0);
+                        analyzer_config.clock_params.falling_edge = (strncmp(clock_ptr, "ext_falling", 11) == 0);
+                    }
+                    char *trigger_ptr = strstr(rx_buffer, "\"trigger\": \"");
+                    if (trigger_ptr) {
+                        trigger_ptr += strlen("\"trigger\": \"");
+                        analyzer_config.trigger_params.enabled = true;
+                        if (strncmp(trigger_ptr, "rising", 6) == 0) analyzer_config.trigger_params.edge = EXTI_TRIGGER_RISING;
+                        else if (strncmp(trigger_ptr, "falling", 7) == 0) analyzer_config.trigger_params.edge = EXTI_TRIGGER_FALLING;
+                        else if (strncmp(trigger_ptr, "both", 4) == 0) analyzer_config.trigger_params.edge = EXTI_TRIGGER_BOTH;
+                        else analyzer_config.trigger_params.enabled = false;
+                    }
+                    char *decoder_ptr = strstr(rx_buffer, "\"decoder\": \"");
+                    if (decoder_ptr) {
+                        decoder_ptr += strlen("\"decoder\": \"");
+                        if (strncmp(decoder_ptr, "can", 3) == 0) analyzer_config.decoder_params.type = DECODER_CAN;
+                        else if (strncmp(decoder_ptr, "onewire", 7) == 0) analyzer_config.decoder_params.type = DECODER_ONEWIRE;
+                        else if (strncmp(decoder_ptr, "lin", 3) == 0) analyzer_config.decoder_params.type = DECODER_LIN;
+                        else if (strncmp(decoder_ptr, "manchester", 10) == 0) analyzer_config.decoder_params.type = DECODER_MANCHESTER;
+                        else if (strncmp(decoder_ptr, "ws2812", 6) == 0) analyzer_config.decoder_params.type = DECODER_WS2812;
+                        else if (strncmp(decoder_ptr, "swd", 3) == 0) analyzer_config.decoder_params.type = DECODER_SWD;
+                        else if (strncmp(decoder_ptr, "pwm", 3) == 0) analyzer_config.decoder_params.type = DECODER_PWM;
+                        else if (strncmp(decoder_ptr, "timing", 6) == 0) analyzer_config.decoder_params.type = DECODER_TIMING;
+                        else analyzer_config.decoder_params.type = DECODER_NONE;
+                    }
+                    char *dec_chan_ptr = strstr(rx_buffer, "\"decoder_channel\": ");
+                    if (dec_chan_ptr) analyzer_config.decoder_params.channel = atoi(dec_chan_ptr + strlen("\"decoder_channel\": "));
+                    char *data_chan_ptr = strstr(rx_buffer, "\"data_channel\": ");
+                    if (data_chan_ptr) analyzer_config.decoder_params.data_channel = atoi(data_chan_ptr + strlen("\"data_channel\": "));
+                    char *bitrate_ptr = strstr(rx_buffer, "\"bitrate\": ");
+                    if (bitrate_ptr) analyzer_config.decoder_params.bitrate = (uint32_t)strtoul(bitrate_ptr + strlen("\"bitrate\": "), NULL, 10);
+                    char *id_mask_ptr = strstr(rx_buffer, "\"can_id_mask\": ");
+                    if (id_mask_ptr) analyzer_config.can_params.id_mask = (uint32_t)strtoul(id_mask_ptr + strlen("\"can_id_mask\": "), NULL, 0);
+                    char *id_match_ptr = strstr(rx_buffer, "\"can_id_match\": ");
+                    if (id_match_ptr) analyzer_config.can_params.id_match = (uint32_t)strtoul(id_match_ptr + strlen("\"can_id_match\": "), NULL, 0);
+                    char *id_min_ptr = strstr(rx_buffer, "\"can_id_min\": ");
+                    if (id_min_ptr) analyzer_config.can_params.id_min = (uint32_t)strtoul(id_min_ptr + strlen("\"can_id_min\": "), NULL, 0);
+                    char *id_max_ptr = strstr(rx_buffer, "\"can_id_max\": ");
+                    if (id_max_ptr) analyzer_config.can_params.id_max = (uint32_t)strtoul(id_max_ptr + strlen("\"can_id_max\": "), NULL, 0);
+                    char *lin_ids_ptr = strstr(rx_buffer, "\"lin_ids\": ");
+                    if (lin_ids_ptr) analyzer_config.lin_params.id_filter = strtoull(lin_ids_ptr + strlen("\"lin_ids\": "), NULL, 0);
+                    char *code_ptr = strstr(rx_buffer, "\"line_code\": \"");
+                    if (code_ptr) {
+                        code_ptr += strlen("\"line_code\": \"");
+                        if (strncmp(code_ptr, "thomas", 6) == 0) analyzer_config.manchester_params.code = MANCHESTER_CODE_THOMAS;
+                        else if (strncmp(code_ptr, "bmc", 3) == 0) analyzer_config.manchester_params.code = MANCHESTER_CODE_BMC;
+                        else analyzer_config.manchester_params.code = MANCHESTER_CODE_IEEE;
+                    }
+                    char *sync_word_ptr = strstr(rx_buffer, "\"sync_word\": ");
+                    if (sync_word_ptr) analyzer_config.manchester_params.sync_word = (uint32_t)strtoul(sync_word_ptr + strlen("\"sync_word\": "), NULL, 0);
+                    char *sync_bits_ptr = strstr(rx_buffer, "\"sync_bits\": ");
+                    if (sync_bits_ptr) analyzer_config.manchester_params.sync_bits = atoi(sync_bits_ptr + strlen("\"sync_bits\": "));
+                    char *lsb_ptr = strstr(rx_buffer, "\"lsb_first\": ");
+                    if (lsb_ptr) analyzer_config.manchester_params.lsb_first = atoi(lsb_ptr + strlen("\"lsb_first\": ")) != 0;
+                    char *threshold_ptr = strstr(rx_buffer, "\"threshold_ns\": ");
+                    if (threshold_ptr) analyzer_config.ws2812_params.threshold_ns = atoi(threshold_ptr + strlen("\"threshold_ns\": "));
+                    char *reset_ptr = strstr(rx_buffer, "\"reset_us\": ");
+                    if (reset_ptr) analyzer_config.ws2812_params.reset_us = atoi(reset_ptr + strlen("\"reset_us\": "));
+                    char *diff_ptr = strstr(rx_buffer, "\"diff\": ");
+                    if (diff_ptr) analyzer_config.ws2812_params.diff = atoi(diff_ptr + strlen("\"diff\": ")) != 0;
+                    char *window_ptr = strstr(rx_buffer, "\"window_ms\": ");
+                    if (window_ptr) analyzer_config.pwm_params.window_ms = atoi(window_ptr + strlen("\"window_ms\": "));
+                    char *min_pulse_ptr = strstr(rx_buffer, "\"min_pulse_ns\": ");
+                    if (min_pulse_ptr) analyzer_config.timing_params.min_pulse_ns = atoi(min_pulse_ptr + strlen("\"min_pulse_ns\": "));
+                    char *check_bus_ptr = strstr(rx_buffer, "\"check_bus\": \"");
+                    if (check_bus_ptr) {
+                        check_bus_ptr += strlen("\"check_bus\": \"");
+                        if (strncmp(check_bus_ptr, "spi", 3) == 0) analyzer_config.timing_params.bus = TIMING_BUS_SPI;
+                        else if (strncmp(check_bus_ptr, "i2c", 3) == 0) analyzer_config.timing_params.bus = TIMING_BUS_I2C;
+                        else analyzer_config.timing_params.bus = TIMING_BUS_NONE;
+                    }
+                    char *sample_edge_ptr = strstr(rx_buffer, "\"sample_edge\": \"");
+                    if (sample_edge_ptr) {
+                        analyzer_config.timing_params.sample_falling =
+                            (strncmp(sample_edge_ptr + strlen("\"sample_edge\": \""), "falling", 7) == 0);
+                    }
+                    char *setup_ptr = strstr(rx_buffer, "\"setup_ns\": ");
+                    if (setup_ptr) analyzer_config.timing_params.setup_ns = atoi(setup_ptr + strlen("\"setup_ns\": "));
+                    char *hold_ptr = strstr(rx_buffer, "\"hold_ns\": ");
+                    if (hold_ptr) analyzer_config.timing_params.hold_ns = atoi(hold_ptr + strlen("\"hold_ns\": "));
+                    char *skew_mask_ptr = strstr(rx_buffer, "\"skew_mask\": ");
+                    if (skew_mask_ptr) analyzer_config.timing_params.skew_mask = (int)strtol(skew_mask_ptr + strlen("\"skew_mask\": "), NULL, 0);
+                    char *skew_ptr = strstr(rx_buffer, "\"skew_ns\": ");
+                    if (skew_ptr) analyzer_config.timing_params.skew_ns = atoi(skew_ptr + strlen("\"skew_ns\": "));
+                    char *skew_window_ptr = strstr(rx_buffer, "\"skew_window_ns\": ");
+                    if (skew_window_ptr) analyzer_config.timing_params.skew_window_ns = atoi(skew_window_ptr + strlen("\"skew_window_ns\": "));
+
+                    // Capture memory layout: a named profile, or an explicit segment count
+                    bool memory_ok = true;
+                    char *mem_ptr = strstr(rx_buffer, "\"memory\": \"");
+                    if (mem_ptr) {
+                        mem_ptr += strlen("\"memory\": \"");
+                        if (strncmp(mem_ptr, "deep", 4) == 0) memory_ok = capture_arena_configure(CAPTURE_ARENA_DEEP_SEGMENTS);
+                        else if (strncmp(mem_ptr, "stream", 6) == 0) memory_ok = capture_arena_configure(CAPTURE_ARENA_STREAM_SEGMENTS);
+                        else memory_ok = false;
+                    }
+                    char *seg_ptr = strstr(rx_buffer, "\"segments\": ");
+                    if (seg_ptr) {
+                        seg_ptr += strlen("\"segments\": ");
+                        char *seg_end;
+                        long segments = strtol(seg_ptr, &seg_end, 10);
+                        // Range-check before narrowing, so 258 cannot wrap to 2
+                        if (seg_end == seg_ptr || segments < CAPTURE_ARENA_MIN_SEGMENTS ||
+                            segments > CAPTURE_ARENA_MAX_SEGMENTS || !capture_arena_configure((uint8_t)segments)) {
+                            memory_ok = false;
+                        }
+                    }
+                    if (!memory_ok) {
+                        send_line("{\"log\":\"Invalid memory layout, keeping the previous one\"}");
+                    }
+
+                    // Report the resulting capture depth so the UI can size its views
+                    snprintf(reply_buffer, sizeof(reply_buffer),
+                             "{\"capture\":{\"arena_bytes\":%u,\"segments\":%u,\"segment_samples\":%lu,\"depth\":%lu}}",
+                             (unsigned)capture_arena_get_size_bytes(), capture_arena_get_segment_count(),
+                             (unsigned long)capture_arena_get_segment_samples(), (unsigned long)capture_arena_get_depth());
+                    send_line(reply_buffer);
                 } else if (strncmp(cmd_ptr, "start_capture", 13) == 0) {
-                    if (analyzer_config.state == IDLE) {
+                    if (analyzer_config.state == IDLE && is_hardware_capture(analyzer_config.protocol)) {
+                        // Peripheral-assisted modes run until stopped and report their timebase
+                        if (start_hardware_capture(reply_buffer, sizeof(reply_buffer)) == 0) {
+                            analyzer_config.state = CAPTURING;
+                        }
+                        send_line(reply_buffer);
+                    } else if (analyzer_config.state == IDLE && analyzer_config.protocol == PROTO_I2S && configure_i2s() != 0) {
+                        send_line("{\"log\":\"Invalid I2S settings\"}");
+                    } else if (analyzer_config.state == IDLE && analyzer_config.clock_params.external) {
+                        // One sample per edge of the target's clock; segments are handed over as with TIM2
+                        xQueueReset(segment_ready_queue);
+                        int status = sync_sampler_start(analyzer_config.clock_params.falling_edge,
+                                                        (uint8_t)analyzer_config.capture_params.filter, sync_segment_ready);
+                        if (status == 0) {
+                            analyzer_config.state = CAPTURING;
+                        } else {
+                            snprintf(reply_buffer, sizeof(reply_buffer), "{\"log\":\"Sync capture failed to start (%d)\"}", status);
+                            send_line(reply_buffer);
+                        }
+                    } else if (analyzer_config.state == IDLE && analyzer_config.trigger_params.enabled) {
+                        // Arm the first segment and let the trigger edge start TIM2
+                        analyzer_config.state = CAPTURING;
+                        xQueueReset(segment_ready_queue);
+                        dma_start_segment(0);
+                        trigger_arm();
+                        send_line("{\"log\":\"Waiting for trigger on PA0\"}");
+                    } else if (analyzer_config.state == IDLE) {
                         analyzer_config.state = CAPTURING;
-                        // Reset DMA and start the timer to begin capture
-                        dma_set_memory_address(DMA1, DMA_CHANNEL2, (uint32_t)dma_capture_buffer);
-                        dma_set_number_of_data(DMA1, DMA_CHANNEL2, DMA_BUFFER_SIZE);
-                        dma_enable_channel(DMA1, DMA_CHANNEL2);
+                        // Point the DMA at the first arena segment and start the timer
+                        xQueueReset(segment_ready_queue);
+                        trigger_disarm();
+                        dma_start_segment(0);
                         timer_enable_counter(TIM2);
                     }
+                } else if (strncmp(cmd_ptr, "stop_capture", 12) == 0) {
+                    if (analyzer_config.state == CAPTURING && is_hardware_capture(analyzer_config.protocol)) {
+                        // The processing task owns the decoders, so it winds the capture down
+                        analyzer_config.state = STOPPING;
+                    } else if (analyzer_config.state == CAPTURING && analyzer_config.clock_params.external) {
+                        sync_sampler_stop();
+                        analyzer_config.state = IDLE;
+                    } else if (analyzer_config.state == CAPTURING && analyzer_config.trigger_params.enabled) {
+                        // Also abandons a trigger that never came
+                        timer_disable_counter(TIM2);
+                        dma_disable_channel(DMA1, DMA_CHANNEL2);
+                        trigger_disarm();
+                        analyzer_config.state = IDLE;
+                    }
+                } else if (strncmp(cmd_ptr, "dma_bench", 9) == 0) {
+                    // Throughput test borrows the arena, so only run it between captures
+                    if (analyzer_config.state == IDLE) {
+                        dma_bench_run(reply_buffer, sizeof(reply_buffer));
+                        send_line(reply_buffer);
+                    }
+                } else if (strncmp(cmd_ptr, "dispatch_bench", 14) == 0) {
+                    if (analyzer_config.state == IDLE) {
+                        dispatch_bench_run(reply_buffer, sizeof(reply_buffer));
+                        send_line(reply_buffer);
+                    }
                 }
             }
         }
 
+        // Report how far behind the hardware start an interrupt would have been, and
+        // how long after the edge the first sample landed in the arena
+        if (trigger_fired) {
+            trigger_fired = false;
+            exti_deinit(&trigger_exti);
+            uint32_t isr_ticks = trigger_isr_ticks + TRIGGER_SYNC_TICKS;
+            if (trigger_sample_seen) {
+                snprintf(reply_buffer, sizeof(reply_buffer), "{\"trigger\":{\"first_sample_ns\":%lu,\"isr_ns\":%lu}}",
+                         (unsigned long)((isr_ticks + trigger_sample_cycles) * 1000000000ULL / F_CPU),
+                         (unsigned long)(isr_ticks * 1000000000ULL / F_CPU));
+            } else {
+                // The first sample was already taken when the ISR ran
+                snprintf(reply_buffer, sizeof(reply_buffer), "{\"trigger\":{\"first_sample_ns\":null,\"isr_ns\":%lu}}",
+                         (unsigned long)(isr_ticks * 1000000000ULL / F_CPU));
+            }
+            send_line(reply_buffer);
+        }
+
         // Check for a processed JSON buffer ready to be sent to the PC
         if (xQueueReceive(json_output_queue, &json_to_send, pdMS_TO_TICKS(10)) == pdTRUE) {
-            char* ptr = json_to_send;
-            while (*ptr) {
-                usart_send_blocking(USART1, *ptr++);
-            }
-            usart_send_blocking(USART1, '\n'); // Terminator for readline() in Python
+            send_line(json_to_send);
+            xQueueSend(free_frame_queue, &json_to_send, 0);
         }
     }
 }
 
+/**
+ * @brief Sends a string to the PC followed by the line terminator.
+ * @note Only called from the CommunicationTask, which owns USART1 TX.
+ */
+static void send_line(const char* line) {
+    while (*line) {
+        usart_send_blocking(USART1, *line++);
+    }
+    usart_send_blocking(USART1, '\n'); // Terminator for readline() in Python
+}
+
+/**
+ * @brief Hands the record in json_output_buffer to the CommunicationTask.
+ * @details The DMA memcpy service copies the record into a free output frame,
+ *          and its completion interrupt queues the frame for sending. In the
+ *          meantime json_output_buffer moves to the next staging buffer, so
+ *          the ProcessingTask formats the next record while this one is still
+ *          being copied. Waits only for a free frame, or for a staging buffer
+ *          whose copy has not finished yet.
+ */
+static void publish_json_output(void) {
+    char* frame;
+    xQueueReceive(free_frame_queue, &frame, portMAX_DELAY);
+
+    // Whole 16-byte blocks, terminator included, let the copy run as word bursts
+    size_t length = (strlen(json_output_buffer) + 16U) & ~(size_t)15U;
+    if (length > JSON_OUTPUT_BUFFER_SIZE) {
+        length = JSON_OUTPUT_BUFFER_SIZE;
+    }
+
+    output_copy_t* copy = &output_copies[output_staging_index];
+    copy->frame = frame;
+    copy->length = length;
+    if (dma_memcpy_async(frame, json_output_buffer, length, output_copy_callback, copy) != 0) {
+        // Let a copy still in flight queue its record first, then copy this one on the CPU
+        uint8_t other;
+        xQueueReceive(free_staging_queue, &other, portMAX_DELAY);
+        xQueueSend(free_staging_queue, &other, 0);
+        memcpy(frame, json_output_buffer, length);
+        xQueueSend(json_output_queue, &frame, portMAX_DELAY);
+        return;
+    }
+
+    xQueueReceive(free_staging_queue, &output_staging_index, portMAX_DELAY);
+    json_output_buffer = output_staging[output_staging_index];
+}
+
+/**
+ * @brief Queues a copied output frame for sending and frees its staging buffer.
+ * @note Runs in the DMA memcpy interrupt.
+ */
+static void output_copy_callback(int status, void* user_data) {
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    output_copy_t* copy = (output_copy_t*)user_data;
+    uint8_t index = (uint8_t)(copy - output_copies);
+
+    // A transfer error is rare; finish the record on the CPU rather than drop it
+    if (status != 0) {
+        memcpy(copy->frame, output_staging[index], copy->length);
+    }
+    xQueueSendFromISR(json_output_queue, &copy->frame, &higher_priority_task_woken);
+    xQueueSendFromISR(free_staging_queue, &index, &higher_priority_task_woken);
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
 /**
  * @brief Processes the raw data captured by the DMA.
- * - Waits for a signal that a buffer half is ready.
+ * - Waits for the DMA ISR to hand over a filled arena segment.
  * - Calls the appropriate protocol decoder.
  * - Sends the formatted JSON string to the CommunicationTask.
  */
 void ProcessingTask(void *pvParameters) {
     (void)pvParameters;
+    uint8_t segment;
 
     for (;;) {
-        // Wait for the DMA ISR to signal that a buffer half is full
-        if (xSemaphoreTake(dma_transfer_complete_sem, portMAX_DELAY) == pdTRUE) {
-            uint16_t* buffer_to_process;
-
-            // Determine which half of the buffer to process
-            if (dma_first_half_done) {
-                buffer_to_process = &dma_capture_buffer[0];
-            } else {
-                buffer_to_process = &dma_capture_buffer[DMA_BUFFER_HALF_SIZE];
-            }
+        // Wait for the DMA ISR to signal that a segment is full
+        if (xQueueReceive(segment_ready_queue, &segment, pdMS_TO_TICKS(HW_CAPTURE_POLL_MS)) == pdTRUE) {
+            uint16_t* buffer_to_process = capture_arena_get_segment(segment);
+            const uint32_t segment_samples = capture_arena_get_segment_samples();
 
             // Based on current config, call the correct processing function
             switch (analyzer_config.protocol) {
                 case PROTO_GPIO:
-                    process_gpio(buffer_to_process, DMA_BUFFER_HALF_SIZE, json_output_buffer, JSON_OUTPUT_BUFFER_SIZE);
+                    process_gpio(buffer_to_process, segment_samples, json_output_buffer, JSON_OUTPUT_BUFFER_SIZE);
                     break;
                 case PROTO_SPI:
-                    // process_spi(buffer_to_process, DMA_BUFFER_HALF_SIZE, ...);
-                    // For now, just send a placeholder message
-                    snprintf(json_output_buffer, JSON_OUTPUT_BUFFER_SIZE, "{\"log\":\"SPI decoder not implemented\"}");
+                    process_spi(buffer_to_process, segment_samples, json_output_buffer, JSON_OUTPUT_BUFFER_SIZE);
+                    break;
+                case PROTO_I2C:
+                    process_i2c(buffer_to_process, segment_samples, json_output_buffer, JSON_OUTPUT_BUFFER_SIZE);
+                    break;
+                case PROTO_UART:
+                    process_uart(buffer_to_process, segment_samples, json_output_buffer, JSON_OUTPUT_BUFFER_SIZE);
+                    break;
+                case PROTO_I2S:
+                    i2s_decoder_process(buffer_to_process, segment_samples, segment * segment_samples,
+                                        analyzer_config.clock_params.external, json_output_buffer, JSON_OUTPUT_BUFFER_SIZE);
+                    break;
+                case PROTO_PARALLEL:
+                    process_parallel(buffer_to_process, segment_samples, segment * segment_samples,
+                                     analyzer_config.clock_params.external, json_output_buffer, JSON_OUTPUT_BUFFER_SIZE);
                     break;
-                // Add cases for I2C and UART
                 default:
                     snprintf(json_output_buffer, JSON_OUTPUT_BUFFER_SIZE, "{\"log\":\"Unknown protocol selected\"}");
                     break;
             }
 
-            // Send the pointer to the formatted JSON to the comm task
-            char *json_ptr = json_output_buffer;
-            xQueueSend(json_output_queue, &json_ptr, portMAX_DELAY);
+            // Hand the formatted JSON to the comm task
+            publish_json_output();
 
-            // Stop capturing after one buffer is processed.
-            // For continuous capture, this logic would change.
-            timer_disable_counter(TIM2);
-            dma_disable_channel(DMA1, DMA_CHANNEL2);
+            // The ISR stops the hardware once the last segment is filled;
+            // the capture is over once that segment has been processed.
+            if (segment == capture_arena_get_segment_count() - 1) {
+                analyzer_config.state = IDLE;
+            }
+        }
+
+        // Hardware-assisted modes fill no segments; drain their records instead
+        if (analyzer_config.state == CAPTURING && is_hardware_capture(analyzer_config.protocol)) {
+            poll_hardware_capture();
+        } else if (analyzer_config.state == STOPPING) {
+            finish_hardware_capture();
             analyzer_config.state = IDLE;
         }
     }
 }
 
+// --- Hardware-Assisted Capture Modes ---
+
+/**
+ * @brief Reports whether a protocol is captured by peripherals rather than by GPIO sampling.
+ */
+static bool is_hardware_capture(ProtocolType protocol) {
+    return protocol == PROTO_SPI_SNIFF || protocol == PROTO_UART_SNIFF || protocol == PROTO_SPI_SAMPLE ||
+           protocol == PROTO_TIMER_CAPTURE || protocol == PROTO_FREQ_COUNTER ||
+           protocol == PROTO_ENCODER;
+}
+
+/**
+ * @brief Starts the configured hardware-assisted mode and formats the reply.
+ * @return 0 on success, or a negative error code from the mode.
+ */
+static int start_hardware_capture(char* reply_buffer, size_t reply_buffer_size) {
+    int status = -1;
+    const edge_decoder_t* decoder = NULL;
+
+    switch (analyzer_config.protocol) {
+        case PROTO_SPI_SNIFF:
+            status = spi_sniffer_start(analyzer_config.spi_params.cpol ? SPI_CLOCK_POLARITY_HIGH : SPI_CLOCK_POLARITY_LOW,
+                                       analyzer_config.spi_params.cpha ? SPI_CLOCK_PHASE_2_EDGE : SPI_CLOCK_PHASE_1_EDGE,
+                                       SPI_BIT_ORDER_MSB_FIRST);
+            if (status == 0) {
+                snprintf(reply_buffer, reply_buffer_size, "{\"spi_sniff\":{\"tick_hz\":%lu,\"ring_bytes\":%lu}}",
+                         (unsigned long)CAPTURE_TIMEBASE_HZ, (unsigned long)spi_sniffer_get_ring_bytes());
+            }
+            break;
+        case PROTO_UART_SNIFF: {
+            const uart_config_t uart_cfg = {
+                .baud_rate = analyzer_config.uart_params.baud,
+                .word_length = 8,
+                .parity = analyzer_config.uart_params.parity,
+                .stop_bits = (analyzer_config.uart_params.stop_bits == 2) ? UART_STOP_BITS_2 : UART_STOP_BITS_1,
+                .flow_control = UART_FLOW_CONTROL_NONE,
+            };
+            status = uart_sniffer_start(&uart_cfg);
+            if (status == 0) {
+                snprintf(reply_buffer, reply_buffer_size, "{\"uart_sniff\":{\"tick_hz\":%lu,\"ring_bytes\":%lu}}",
+                         (unsigned long)CAPTURE_TIMEBASE_HZ, (unsigned long)uart_sniffer_get_ring_bytes());
+            }
+            break;
+        }
+        case PROTO_SPI_SAMPLE:
+            status = configure_decoder(&decoder);
+            if (status == 0) {
+                status = spi_sampler_start((spi_baud_rate_t)analyzer_config.spi_params.prescaler, decoder);
+            }
+            if (status == 0) {
+                snprintf(reply_buffer, reply_buffer_size,
+                         "{\"spi_sample\":{\"tick_hz\":%lu,\"sample_hz\":%lu,\"ring_bytes\":%lu}}",
+                         (unsigned long)CAPTURE_TIMEBASE_HZ, (unsigned long)spi_sampler_get_sample_rate(),
+                         (unsigned long)spi_sampler_get_ring_bytes());
+            }
+            break;
+        case PROTO_TIMER_CAPTURE:
+            status = configure_decoder(&decoder);
+            if (status == 0) {
+                status = timer_capture_start((uint8_t)analyzer_config.capture_params.channel_mask,
+                                             (uint8_t)analyzer_config.capture_params.filter, decoder);
+            }
+            if (status == 0) {
+                snprintf(reply_buffer, reply_buffer_size, "{\"timer_capture\":{\"tick_hz\":%lu,\"ring_words\":%lu}}",
+                         (unsigned long)CAPTURE_TIMEBASE_HZ, (unsigned long)timer_capture_get_ring_words());
+            }
+            break;
+        case PROTO_FREQ_COUNTER:
+            status = freq_counter_start((uint8_t)analyzer_config.capture_params.channel_mask,
+                                        (uint8_t)analyzer_config.capture_params.filter,
+                                        (uint32_t)analyzer_config.capture_params.gate_ms);
+            if (status == 0) {
+                snprintf(reply_buffer, reply_buffer_size, "{\"freq_counter\":{\"gate_ms\":%d,\"slice_us\":%u}}",
+                         analyzer_config.capture_params.gate_ms, FREQ_COUNTER_SLICE_US);
+            }
+            break;
+        case PROTO_ENCODER:
+            status = encoder_capture_start((uint8_t)analyzer_config.capture_params.filter,
+                                           (uint32_t)analyzer_config.capture_params.rate_hz);
+            if (status == 0) {
+                snprintf(reply_buffer, reply_buffer_size, "{\"encoder\":{\"tick_hz\":%lu,\"rate_hz\":%d}}",
+                         (unsigned long)CAPTURE_TIMEBASE_HZ, analyzer_config.capture_params.rate_hz);
+            }
+            break;
+        default:
+            break;
+    }
+
+    // Analog scans ride on the edge stream of the sampling modes
+    if (status == 0 && (analyzer_config.protocol == PROTO_SPI_SAMPLE || analyzer_config.protocol == PROTO_TIMER_CAPTURE)) {
+        status = start_analog_capture(reply_buffer, reply_buffer_size);
+        if (status != 0) {
+            stop_hardware_capture();
+        }
+    }
+
+    if (status != 0) {
+        snprintf(reply_buffer, reply_buffer_size, "{\"log\":\"Hardware capture failed to start (%d)\"}", status);
+    }
+    return status;
+}
+
+/**
+ * @brief Applies the selected decoder's settings before an edge-stream mode starts.
+ * @param[out] decoder Decoder to pass to the front-end, or NULL for raw edges.
+ * @return 0 on success, -1 if the settings are invalid.
+ */
+static int configure_decoder(const edge_decoder_t** decoder) {
+    *decoder = NULL;
+
+    switch (analyzer_config.decoder_params.type) {
+        case DECODER_CAN: {
+            const can_decoder_config_t can_cfg = {
+                .channel = (uint8_t)analyzer_config.decoder_params.channel,
+                .bitrate = analyzer_config.decoder_params.bitrate ? analyzer_config.decoder_params.bitrate
+                                                                  : CAN_DECODER_DEFAULT_BITRATE,
+                .id_mask = analyzer_config.can_params.id_mask,
+                .id_match = analyzer_config.can_params.id_match,
+                .id_min = analyzer_config.can_params.id_min,
+                .id_max = analyzer_config.can_params.id_max,
+            };
+            *decoder = &can_decoder;
+            return can_decoder_configure(&can_cfg);
+        }
+        case DECODER_ONEWIRE: {
+            const onewire_decoder_config_t onewire_cfg = {
+                .channel = (uint8_t)analyzer_config.decoder_params.channel,
+            };
+            *decoder = &onewire_decoder;
+            return onewire_decoder_configure(&onewire_cfg);
+        }
+        case DECODER_LIN: {
+            const lin_decoder_config_t lin_cfg = {
+                .channel = (uint8_t)analyzer_config.decoder_params.channel,
+                .bitrate = analyzer_config.decoder_params.bitrate,
+                .id_filter = analyzer_config.lin_params.id_filter,
+            };
+            *decoder = &lin_decoder;
+            return lin_decoder_configure(&lin_cfg);
+        }
+        case DECODER_MANCHESTER: {
+            const manchester_decoder_config_t manchester_cfg = {
+                .channel = (uint8_t)analyzer_config.decoder_params.channel,
+                .code = analyzer_config.manchester_params.code,
+                .bitrate = analyzer_config.decoder_params.bitrate ? analyzer_config.decoder_params.bitrate
+                                                                  : MANCHESTER_DECODER_DEFAULT_BITRATE,
+                .sync_word = analyzer_config.manchester_params.sync_word,
+                .sync_bits = (uint8_t)analyzer_config.manchester_params.sync_bits,
+                .lsb_first = analyzer_config.manchester_params.lsb_first,
+            };
+            *decoder = &manchester_decoder;
+            return manchester_decoder_configure(&manchester_cfg);
+        }
+        case DECODER_WS2812: {
+            const ws2812_decoder_config_t ws2812_cfg = {
+                .channel = (uint8_t)analyzer_config.decoder_params.channel,
+                .threshold_ns = (uint32_t)analyzer_config.ws2812_params.threshold_ns,
+                .reset_us = (uint32_t)analyzer_config.ws2812_params.reset_us,
+                .diff = analyzer_config.ws2812_params.diff,
+            };
+            *decoder = &ws2812_decoder;
+            return ws2812_decoder_configure(&ws2812_cfg);
+        }
+        case DECODER_SWD: {
+            const swd_decoder_config_t swd_cfg = {
+                .clock_channel = (uint8_t)analyzer_config.decoder_params.channel,
+                .data_channel = (uint8_t)analyzer_config.decoder_params.data_channel,
+            };
+            *decoder = &swd_decoder;
+            return swd_decoder_configure(&swd_cfg);
+        }
+        case DECODER_PWM: {
+            const pwm_stats_config_t pwm_cfg = {
+                .window_ms = (uint32_t)analyzer_config.pwm_params.window_ms,
+            };
+            *decoder = &pwm_stats_decoder;
+            return pwm_stats_configure(&pwm_cfg);
+        }
+        case DECODER_TIMING: {
+            if (analyzer_config.timing_params.min_pulse_ns < 0 || analyzer_config.timing_params.setup_ns < 0 ||
+                analyzer_config.timing_params.hold_ns < 0 || analyzer_config.timing_params.skew_mask < 0 ||
+                analyzer_config.timing_params.skew_mask > 0xFF || analyzer_config.timing_params.skew_ns < 0 ||
+                analyzer_config.timing_params.skew_window_ns < 0) {
+                return -1;
+            }
+            const timing_check_config_t timing_cfg = {
+                .min_pulse_ns = (uint32_t)analyzer_config.timing_params.min_pulse_ns,
+                .bus = analyzer_config.timing_params.bus,
+                .clock_channel = (uint8_t)analyzer_config.decoder_params.channel,
+                .data_channel = (uint8_t)analyzer_config.decoder_params.data_channel,
+                .sample_falling = analyzer_config.timing_params.sample_falling,
+                .setup_ns = (uint32_t)analyzer_config.timing_params.setup_ns,
+                .hold_ns = (uint32_t)analyzer_config.timing_params.hold_ns,
+                .skew_mask = (uint8_t)analyzer_config.timing_params.skew_mask,
+                .skew_ns = (uint32_t)analyzer_config.timing_params.skew_ns,
+                .skew_window_ns = (uint32_t)analyzer_config.timing_params.skew_window_ns,
+            };
+            *decoder = &timing_check_decoder;
+            return timing_check_configure(&timing_cfg);
+        }
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Applies the I2S settings before a sampled capture starts.
+ * @return 0 on success, -1 if the settings are invalid.
+ */
+static int configure_i2s(void) {
+    const i2s_decoder_config_t i2s_cfg = {
+        .format = analyzer_config.i2s_params.format,
+        .slot_bits = (uint8_t)analyzer_config.i2s_params.slot_bits,
+        .slots = (uint8_t)analyzer_config.i2s_params.slots,
+        .bclk_pin = (uint8_t)analyzer_config.i2s_params.bclk_pin,
+        .fs_pin = (uint8_t)analyzer_config.i2s_params.fs_pin,
+        .sd_pin = (uint8_t)analyzer_config.i2s_params.sd_pin,
+        .pcm = analyzer_config.i2s_params.pcm,
+        .summary = analyzer_config.i2s_params.summary,
+    };
+    return i2s_decoder_configure(&i2s_cfg);
+}
+
+static void stop_hardware_capture(void) {
+    switch (analyzer_config.protocol) {
+        case PROTO_SPI_SNIFF:
+            spi_sniffer_stop();
+            break;
+        case PROTO_UART_SNIFF:
+            uart_sniffer_stop();
+            break;
+        case PROTO_SPI_SAMPLE:
+            analog_capture_stop();
+            spi_sampler_stop();
+            break;
+        case PROTO_TIMER_CAPTURE:
+            analog_capture_stop();
+            timer_capture_stop();
+            break;
+        case PROTO_FREQ_COUNTER:
+            freq_counter_stop();
+            break;
+        case PROTO_ENCODER:
+            encoder_capture_stop();
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Starts the analog scan requested alongside an edge-stream mode and adds it to the reply.
+ * @return 0 on success or if no analog inputs are requested, or a negative error code.
+ */
+static int start_analog_capture(char* reply_buffer, size_t reply_buffer_size) {
+    static const int sample_cycles[] = { 3, 15, 28, 56, 84, 112, 144, 480 };
+
+    if (analyzer_config.analog_params.channels == 0) {
+        return 0;
+    }
+
+    int bits = analyzer_config.analog_params.bits;
+    if (bits < 6 || bits > 12 || (bits & 1)) {
+        return -1;
+    }
+    adc_config_t adc_cfg = { .resolution = (adc_resolution_t)((12 - bits) / 2) };
+    int sample_time = 0;
+    while (sample_time < 8 && sample_cycles[sample_time] != analyzer_config.analog_params.sample_cycles) {
+        sample_time++;
+    }
+    if (sample_time == 8) {
+        return -1;
+    }
+    adc_cfg.default_sample_time = (adc_sample_time_t)sample_time;
+
+    int status = analog_capture_start(&adc_cfg, (uint8_t)analyzer_config.analog_params.channels,
+                                      (uint32_t)analyzer_config.analog_params.rate_hz);
+    if (status != 0) {
+        return status;
+    }
+
+    // Hold the edge stream back until the guarded input leaves its window
+    bool watchdog = analyzer_config.analog_params.watchdog_input >= 0;
+    if (watchdog) {
+        int pre_trigger_us = analyzer_config.analog_params.pre_trigger_us;
+        int low = analyzer_config.analog_params.watchdog_low;
+        int high = analyzer_config.analog_params.watchdog_high;
+        if (pre_trigger_us < 0 || pre_trigger_us > 1000000 || low < 0 || high > 4095) {
+            analog_capture_stop();
+            return -1;
+        }
+        edge_stream_arm((uint32_t)pre_trigger_us * (CAPTURE_TIMEBASE_HZ / 1000000UL));
+        status = analog_capture_arm_watchdog((uint8_t)analyzer_config.analog_params.watchdog_input,
+                                             (uint16_t)low, (uint16_t)high);
+        if (status != 0) {
+            analog_capture_stop();
+            return status;
+        }
+    }
+
+    // Splice the analog settings into the mode's reply object
+    size_t length = strlen(reply_buffer);
+    if (length > 0 && length < reply_buffer_size) {
+        char watchdog_field[96] = "";
+        if (watchdog) {
+            snprintf(watchdog_field, sizeof(watchdog_field),
+                     ",\"watchdog\":{\"input\":%d,\"low\":%d,\"high\":%d,\"pre_trigger_us\":%d}",
+                     analyzer_config.analog_params.watchdog_input, analyzer_config.analog_params.watchdog_low,
+                     analyzer_config.analog_params.watchdog_high, analyzer_config.analog_params.pre_trigger_us);
+        }
+        snprintf(reply_buffer + length - 1, reply_buffer_size - length + 1,
+                 ",\"analog\":{\"channels\":%d,\"rate_hz\":%d,\"ring_samples\":%lu%s}}",
+                 analyzer_config.analog_params.channels, analyzer_config.analog_params.rate_hz,
+                 (unsigned long)analog_capture_get_ring_samples(), watchdog_field);
+    }
+    return 0;
+}
+
+/**
+ * @brief Forwards every record the active hardware-assisted mode has ready.
+ */
+static void poll_hardware_capture(void) {
+    bool (*poll)(char*, size_t) = NULL;
+
+    switch (analyzer_config.protocol) {
+        case PROTO_SPI_SNIFF: poll = spi_sniffer_poll; break;
+        case PROTO_UART_SNIFF: poll = uart_sniffer_poll; break;
+        case PROTO_SPI_SAMPLE: poll = spi_sampler_poll; break;
+        case PROTO_TIMER_CAPTURE: poll = timer_capture_poll; break;
+        case PROTO_FREQ_COUNTER: poll = freq_counter_poll; break;
+        case PROTO_ENCODER: poll = encoder_capture_poll; break;
+        default: return;
+    }
+
+    while (poll(json_output_buffer, JSON_OUTPUT_BUFFER_SIZE)) {
+        publish_json_output();
+    }
+}
+
+/**
+ * @brief Stops the active hardware-assisted mode after forwarding what it captured.
+ * @details Edge-stream decoders are then flushed, so a packet or frame still
+ *          open when the capture stops is reported rather than dropped.
+ */
+static void finish_hardware_capture(void) {
+    poll_hardware_capture();
+    stop_hardware_capture();
+
+    if (analyzer_config.protocol == PROTO_SPI_SAMPLE || analyzer_config.protocol == PROTO_TIMER_CAPTURE) {
+        while (edge_stream_finish(json_output_buffer, JSON_OUTPUT_BUFFER_SIZE)) {
+            publish_json_output();
+        }
+    }
+}
+
 
 
 // --- Helper Function for Safe JSON String Building ---
@@ -227,6 +1140,10 @@ static void safe_snprintf(char** buf, size_t* remaining, const char* format, ...
     int written = vsnprintf(*buf, *remaining, format, args);
     va_end(args);
     if (written > 0) {
+        // Truncated output still ends at the buffer's last byte
+        if ((size_t)written >= *remaining) {
+            written = (int)(*remaining - 1);
+        }
         *buf += written;
         *remaining -= written;
     }
@@ -245,6 +1162,10 @@ static void safe_snprintf(char** buf, size_t* remaining, const char* format, ...
 
 #define UART_RX_PIN     0
 
+#define PARALLEL_FIRST_CONTROL_PIN  8   // Strobe, read, chip select and address lines: PB8-PB15
+#define PARALLEL_LAST_CONTROL_PIN   15
+#define PARALLEL_RECORD_RESERVE     64  // Room kept for one more cycle and the closing fields
+
 
 // --- SPI DECODER ---
 
@@ -252,7 +1173,7 @@ static void safe_snprintf(char** buf, size_t* remaining, const char* format, ...
  * @brief Decodes SPI data (Mode 0: CPOL=0, CPHA=0) from raw samples.
  * Assumes pin mapping: SCK=PB0, MOSI=PB1, MISO=PB2, CS=PB3
  */
-void process_spi(uint16_t* data_buffer, uint32_t len, char* json_buffer, size_t json_buffer_size) {
+static void process_spi(uint16_t* data_buffer, uint32_t len, char* json_buffer, size_t json_buffer_size) {
     char *ptr = json_buffer;
     size_t remaining = json_buffer_size;
 
@@ -316,33 +1237,6 @@ void process_spi(uint16_t* data_buffer, uint32_t len, char* json_buffer, size_t
     safe_snprintf(&ptr, &remaining, "],\"waveform\":{}}");
 }
 
-static void process_spi(uint16_t* data_buffer, uint32_t len, char* json_buffer, size_t json_buffer_size);
-static void process_i2c(uint16_t* data_buffer, uint32_t len, char* json_buffer, size_t json_buffer_size);
-static void process_uart(uint16_t* data_buffer, uint32_t len, char* json_buffer, size_t json_buffer_size);
-
-// This is the updated switch block for your ProcessingTask
-// ... inside ProcessingTask, after xSemaphoreTake ...
-
-switch (analyzer_config.protocol) {
-    case PROTO_GPIO:
-        process_gpio(buffer_to_process, DMA_BUFFER_HALF_SIZE, json_output_buffer, JSON_OUTPUT_BUFFER_SIZE);
-        break;
-    case PROTO_SPI:
-        process_spi(buffer_to_process, DMA_BUFFER_HALF_SIZE, json_output_buffer, JSON_OUTPUT_BUFFER_SIZE);
-        break;
-    case PROTO_I2C:
-        process_i2c(buffer_to_process, DMA_BUFFER_HALF_SIZE, json_output_buffer, JSON_OUTPUT_BUFFER_SIZE);
-        break;
-    case PROTO_UART:
-        process_uart(buffer_to_process, DMA_BUFFER_HALF_SIZE, json_output_buffer, JSON_OUTPUT_BUFFER_SIZE);
-        break;
-    default:
-        snprintf(json_output_buffer, JSON_OUTPUT_BUFFER_SIZE, "{\"log\":\"Unknown protocol selected\"}");
-        break;
-}
-
-// ... the rest of the task remains the same (xQueueSend, etc.) ...
-
 
 // --- I2C DECODER ---
 
@@ -350,7 +1244,7 @@ switch (analyzer_config.protocol) {
  * @brief Decodes I2C data from raw samples.
  * Assumes pin mapping: SCL=PB0, SDA=PB1
  */
-void process_i2c(uint16_t* data_buffer, uint32_t len, char* json_buffer, size_t json_buffer_size) {
+static void process_i2c(uint16_t* data_buffer, uint32_t len, char* json_buffer, size_t json_buffer_size) {
     char *ptr = json_buffer;
     size_t remaining = json_buffer_size;
 
@@ -420,7 +1314,7 @@ void process_i2c(uint16_t* data_buffer, uint32_t len, char* json_buffer, size_t
  * @brief Decodes UART data from raw samples.
  * Assumes pin mapping: RX=PB0. Assumes 9600 baud, 8-N-1 format.
  */
-void process_uart(uint16_t* data_buffer, uint32_t len, char* json_buffer, size_t json_buffer_size) {
+static void process_uart(uint16_t* data_buffer, uint32_t len, char* json_buffer, size_t json_buffer_size) {
     char *ptr = json_buffer;
     size_t remaining = json_buffer_size;
 
@@ -479,6 +1373,101 @@ void process_uart(uint16_t* data_buffer, uint32_t len, char* json_buffer, size_t
 }
 
 
+// --- PARALLEL BUS DECODER ---
+
+/**
+ * @brief Reports whether a control pin is configured.
+ */
+static bool parallel_pin_valid(int pin) {
+    return pin >= PARALLEL_FIRST_CONTROL_PIN && pin <= PARALLEL_LAST_CONTROL_PIN;
+}
+
+/**
+ * @brief Reports whether a strobe pin made its latching edge between two samples.
+ */
+static bool parallel_strobe_edge(uint16_t prev_sample, uint16_t curr_sample, int pin) {
+    if (!parallel_pin_valid(pin)) {
+        return false;
+    }
+    bool prev = (prev_sample >> pin) & 0x01;
+    bool curr = (curr_sample >> pin) & 0x01;
+    return analyzer_config.parallel_params.falling_edge ? (prev && !curr) : (!prev && curr);
+}
+
+/**
+ * @brief Decodes parallel bus cycles from raw samples, one record per cycle.
+ * Data on PB0-PB7 (PB0-PB3 for a 4-bit bus); strobe, read strobe, chip select
+ * and address line on the PB8-PB15 pins set in parallel_params.
+ *
+ * With TIM2 sampling, a cycle is a strobe edge between two samples, and the
+ * word is taken from the sample before the edge, inside the setup window.
+ * With the external clock, the strobe is wired to PE7 instead: every sample is
+ * then a cycle, and a low read pin marks it as a read.
+ * A high chip select drops the cycle. "ts" counts samples from the start of
+ * the capture, so with the external clock it counts strobes.
+ */
+static void process_parallel(uint16_t* data_buffer, uint32_t len, uint32_t first_sample, bool clocked,
+                             char* json_buffer, size_t json_buffer_size) {
+    static uint16_t last_sample = 0; // Carries the strobe state across segments
+    char *ptr = json_buffer;
+    size_t remaining = json_buffer_size;
+    const uint16_t data_mask = (analyzer_config.parallel_params.width == 4) ? 0x000F : 0x00FF;
+    const int read_pin = analyzer_config.parallel_params.read_pin;
+    const int cs_pin = analyzer_config.parallel_params.cs_pin;
+    const int addr_pin = analyzer_config.parallel_params.addr_pin;
+    uint32_t dropped = 0;
+
+    safe_snprintf(&ptr, &remaining, "{\"protocol\":\"PARALLEL\",\"decoded\":[");
+    bool first_decoded = true;
+
+    uint16_t prev_sample = (first_sample == 0) ? data_buffer[0] : last_sample;
+    for (uint32_t i = (first_sample == 0 && !clocked) ? 1 : 0; i < len; i++) {
+        uint16_t curr_sample = data_buffer[i];
+        uint16_t latched;
+        bool read;
+
+        if (clocked) {
+            latched = curr_sample;
+            read = parallel_pin_valid(read_pin) && !((curr_sample >> read_pin) & 0x01);
+        } else {
+            bool write_edge = parallel_strobe_edge(prev_sample, curr_sample, analyzer_config.parallel_params.strobe_pin);
+            bool read_edge = parallel_strobe_edge(prev_sample, curr_sample, read_pin);
+            prev_sample = curr_sample;
+            if (!write_edge && !read_edge) {
+                continue;
+            }
+            latched = (i > 0) ? data_buffer[i - 1] : last_sample;
+            read = read_edge && !write_edge;
+        }
+
+        // Cycles addressed to another device
+        if (parallel_pin_valid(cs_pin) && ((latched >> cs_pin) & 0x01)) {
+            continue;
+        }
+
+        if (remaining < PARALLEL_RECORD_RESERVE) {
+            dropped++;
+            continue;
+        }
+        if (!first_decoded) safe_snprintf(&ptr, &remaining, ",");
+        safe_snprintf(&ptr, &remaining, "{\"ts\":%lu,\"data\":%u,\"cycle\":\"%s\"",
+                      (unsigned long)(first_sample + i), latched & data_mask, read ? "rd" : "wr");
+        if (parallel_pin_valid(addr_pin)) {
+            safe_snprintf(&ptr, &remaining, ",\"a0\":%u", (latched >> addr_pin) & 0x01);
+        }
+        safe_snprintf(&ptr, &remaining, "}");
+        first_decoded = false;
+    }
+    last_sample = data_buffer[len - 1];
+
+    if (dropped > 0) {
+        safe_snprintf(&ptr, &remaining, "],\"dropped\":%lu,\"waveform\":{}}", (unsigned long)dropped);
+    } else {
+        safe_snprintf(&ptr, &remaining, "],\"waveform\":{}}");
+    }
+}
+
+
 // --- Protocol Processing Functions ---
 
 /**
@@ -488,11 +1477,9 @@ void process_uart(uint16_t* data_buffer, uint32_t len, char* json_buffer, size_t
 static void process_gpio(uint16_t* data_buffer, uint32_t len, char* json_buffer, size_t json_buffer_size) {
     char *ptr = json_buffer;
     size_t remaining = json_buffer_size;
-    int written;
 
     // Start JSON object
-    written = snprintf(ptr, remaining, "{\"protocol\":\"GPIO\",\"decoded\":[],\"waveform\":{");
-    ptr += written; remaining -= written;
+    safe_snprintf(&ptr, &remaining, "{\"protocol\":\"GPIO\",\"decoded\":[],\"waveform\":{");
 
     uint16_t last_states[8] = {0xFFFF}; // Initialize to invalid state
     bool first_channel = true;
@@ -502,62 +1489,156 @@ static void process_gpio(uint16_t* data_buffer, uint32_t len, char* json_buffer,
         bool channel_has_data = false;
         char temp_waveform_buffer[512] = {0}; // Buffer for this channel's waveform
         char* wf_ptr = temp_waveform_buffer;
+        size_t wf_remaining = sizeof(temp_waveform_buffer);
 
         uint16_t last_state = (data_buffer[0] >> ch) & 0x01;
         last_states[ch] = last_state;
 
         // Add the initial state
-        int wf_written = snprintf(wf_ptr, sizeof(temp_waveform_buffer), "[[0,%d]", last_state);
-        wf_ptr += wf_written;
+        safe_snprintf(&wf_ptr, &wf_remaining, "[[0,%d]", last_state);
 
-        // Find all transitions for this channel in the buffer
-        for (uint32_t i = 1; i < len; i++) {
+        // Find all transitions for this channel in the buffer, while a whole one and the "]" still fit
+        for (uint32_t i = 1; i < len && wf_remaining > GPIO_TRANSITION_MAX_CHARS + 1; i++) {
             uint16_t current_state = (data_buffer[i] >> ch) & 0x01;
             if (current_state != last_state) {
                 channel_has_data = true;
-                wf_written = snprintf(wf_ptr, sizeof(temp_waveform_buffer) - (wf_ptr - temp_waveform_buffer), ",[%d,%d]", i, current_state);
-                wf_ptr += wf_written;
+                safe_snprintf(&wf_ptr, &wf_remaining, ",[%lu,%d]", (unsigned long)i, current_state);
                 last_state = current_state;
             }
         }
-        strcat(wf_ptr, "]"); // Close the waveform array
+        safe_snprintf(&wf_ptr, &wf_remaining, "]"); // Close the waveform array
 
         // If there was any data, add this channel to the JSON
         if(channel_has_data) {
             if (!first_channel) {
-                written = snprintf(ptr, remaining, ",");
-                ptr += written; remaining -= written;
+                safe_snprintf(&ptr, &remaining, ",");
             }
-            written = snprintf(ptr, remaining, "\"ch%d\":%s", ch, temp_waveform_buffer);
-            ptr += written; remaining -= written;
+            safe_snprintf(&ptr, &remaining, "\"ch%d\":%s", ch, temp_waveform_buffer);
             first_channel = false;
         }
     }
 
     // Close JSON object
-    snprintf(ptr, remaining, "}}");
+    safe_snprintf(&ptr, &remaining, "}}");
 }
 
 
+// --- External Trigger ---
+
+/**
+ * @brief Hands the start of TIM2 to the trigger pin.
+ * @details TIM2 runs in slave trigger mode, so the selected edge on TI1 sets
+ *          CEN in hardware. The first DMA sample follows exactly one sample
+ *          period (plus input resynchronization) later, with no software in
+ *          the path. EXTI on the same pin measures how late an
+ *          interrupt-driven start would have been, and times the first sample
+ *          against the DWT cycle counter.
+ */
+static void trigger_arm(void) {
+    capture_timebase_init();
+    timer_set_counter(TIM2, 0);
+    timer_ic_set_input(TIM2, TIM_IC1, TIM_IC_IN_TI1);
+    if (analyzer_config.trigger_params.edge == EXTI_TRIGGER_BOTH) {
+        timer_slave_set_trigger(TIM2, TIM_SMCR_TS_TI1F_ED);
+    } else {
+        timer_ic_set_polarity(TIM2, TIM_IC1,
+                              (analyzer_config.trigger_params.edge == EXTI_TRIGGER_FALLING) ? TIM_IC_FALLING : TIM_IC_RISING);
+        timer_slave_set_trigger(TIM2, TIM_SMCR_TS_TI1FP1);
+    }
+    timer_slave_set_mode(TIM2, TIM_SMCR_SMS_TM);
+
+    // Left at the default (highest) NVIC priority, so the probe sees the
+    // best case an interrupt-driven start could achieve
+    const exti_config_t probe_cfg = {
+        .trigger = analyzer_config.trigger_params.edge,
+        .callback = trigger_edge_callback,
+        .user_data = NULL,
+    };
+    trigger_fired = false;
+    trigger_exti = exti_init(TRIGGER_PORT, TRIGGER_PIN, &probe_cfg);
+}
+
+/**
+ * @brief Returns TIM2 to software start and drops the latency probe.
+ */
+static void trigger_disarm(void) {
+    timer_slave_set_mode(TIM2, TIM_SMCR_SMS_OFF);
+    exti_deinit(&trigger_exti);
+    trigger_fired = false;
+}
+
+/**
+ * @brief Measures how long after the hardware start the trigger interrupt ran,
+ *        and how long after that the DMA wrote the first sample.
+ * @details The edge itself is only visible through TIM2, which has counted
+ *          since the hardware start. The first sample is timed directly: the
+ *          ISR latches the DWT cycle counter on entry and again when the DMA
+ *          count first drops. TIM2 and the DWT both run at the CPU clock.
+ * @note Runs in the EXTI ISR, which spins for at most TRIGGER_WAIT_CYCLES.
+ *       Only the first edge counts.
+ */
+static void trigger_edge_callback(uint8_t line_num, void* user_data) {
+    (void)line_num;
+    (void)user_data;
+    if (trigger_fired || trigger_exti == NULL) {
+        return;
+    }
+
+    uint32_t isr_cycles = capture_timebase_now();
+
+    // Whole sample periods already taken, plus the current count
+    uint32_t segment_samples = capture_arena_get_segment_samples();
+    uint32_t remaining = dma_get_number_of_data(DMA1, DMA_CHANNEL2);
+    uint32_t samples = dma_active_segment * segment_samples + (segment_samples - remaining);
+    trigger_isr_ticks = samples * TIMER_PERIOD + timer_get_counter(TIM2);
+
+    // Wait for the first transfer, unless it already happened
+    trigger_sample_seen = false;
+    if (samples == 0) {
+        uint32_t waited;
+        do {
+            waited = capture_timebase_now() - isr_cycles;
+            if (dma_get_number_of_data(DMA1, DMA_CHANNEL2) != remaining) {
+                trigger_sample_cycles = waited;
+                trigger_sample_seen = true;
+                break;
+            }
+        } while (waited < TRIGGER_WAIT_CYCLES);
+    }
+    trigger_fired = true;
+}
+
 // --- ISRs ---
 
 void dma1_channel2_isr(void) {
     BaseType_t higher_priority_task_woken = pdFALSE;
 
-    if (dma_get_interrupt_flag(DMA1, DMA_CHANNEL2, DMA_HTIF)) {
-        dma_clear_interrupt_flags(DMA1, DMA_CHANNEL2, DMA_HTIF);
-        dma_first_half_done = true;
-        xSemaphoreGiveFromISR(dma_transfer_complete_sem, &higher_priority_task_woken);
-    }
-
     if (dma_get_interrupt_flag(DMA1, DMA_CHANNEL2, DMA_TCIF)) {
         dma_clear_interrupt_flags(DMA1, DMA_CHANNEL2, DMA_TCIF);
-        dma_first_half_done = false;
-        xSemaphoreGiveFromISR(dma_transfer_complete_sem, &higher_priority_task_woken);
+        uint8_t completed = dma_active_segment;
+
+        // Rotate to the next segment, or stop once the whole arena is full
+        if (completed + 1 < capture_arena_get_segment_count()) {
+            dma_start_segment(completed + 1);
+        } else {
+            timer_disable_counter(TIM2);
+            dma_disable_channel(DMA1, DMA_CHANNEL2);
+        }
+        xQueueSendFromISR(segment_ready_queue, &completed, &higher_priority_task_woken);
     }
     portYIELD_FROM_ISR(higher_priority_task_woken);
 }
 
+/**
+ * @brief Hands a segment filled by the sync sampler to the ProcessingTask.
+ * @note Runs in the sampler's DMA interrupt.
+ */
+static void sync_segment_ready(uint8_t segment) {
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    xQueueSendFromISR(segment_ready_queue, &segment, &higher_priority_task_woken);
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
 void usart1_isr(void) {
     static char rx_buffer[UART_RX_BUFFER_SIZE];
     static uint8_t rx_index = 0;
@@ -582,6 +1663,7 @@ void usart1_isr(void) {
 // --- Hardware Setup Functions ---
 
 static void clock_setup(void) {
+    // Keep system_clock.h in step with this setup
     rcc_clock_setup_in_hse_8mhz_out_72mhz();
     rcc_periph_clock_enable(RCC_GPIOA);
     rcc_periph_clock_enable(RCC_GPIOB);
@@ -598,6 +1680,12 @@ static void gpio_setup(void) {
 
     // Logic Analyzer Input Pins (PB0-PB7)
     gpio_set_mode(GPIOB, GPIO_MODE_INPUT, GPIO_CNF_INPUT_FLOAT, GPIO0 | GPIO1 | GPIO2 | GPIO3 | GPIO4 | GPIO5 | GPIO6 | GPIO7);
+
+    // Parallel bus control inputs (PB8-PB15), sampled with the data pins
+    gpio_set_mode(GPIOB, GPIO_MODE_INPUT, GPIO_CNF_INPUT_FLOAT, GPIO8 | GPIO9 | GPIO10 | GPIO11 | GPIO12 | GPIO13 | GPIO14 | GPIO15);
+
+    // External trigger input (PA0 = TIM2_CH1)
+    gpio_set_mode(GPIOA, GPIO_MODE_INPUT, GPIO_CNF_INPUT_FLOAT, GPIO0);
 }
 
 static void usart_setup(void) {
@@ -625,16 +1713,25 @@ static void dma_setup(void) {
     nvic_enable_irq(NVIC_DMA1_CHANNEL2_IRQ);
     dma_channel_reset(DMA1, DMA_CHANNEL2);
     dma_set_peripheral_address(DMA1, DMA_CHANNEL2, (uint32_t)&GPIOB_IDR);
-    dma_set_memory_address(DMA1, DMA_CHANNEL2, (uint32_t)dma_capture_buffer);
-    dma_set_number_of_data(DMA1, DMA_CHANNEL2, DMA_BUFFER_SIZE);
     dma_set_read_from_peripheral(DMA1, DMA_CHANNEL2);
     dma_enable_memory_increment_mode(DMA1, DMA_CHANNEL2);
     dma_set_peripheral_size(DMA1, DMA_CHANNEL2, DMA_CCR_PSIZE_16BIT);
     dma_set_memory_size(DMA1, DMA_CHANNEL2, DMA_CCR_MSIZE_16BIT);
-    dma_enable_circular_mode(DMA1, DMA_CHANNEL2);
+    // One transfer per arena segment; the TC ISR retargets the next segment
     dma_set_priority(DMA1, DMA_CHANNEL2, DMA_CCR_PL_VERY_HIGH);
-    dma_enable_half_transfer_interrupt(DMA1, DMA_CHANNEL2);
     dma_enable_transfer_complete_interrupt(DMA1, DMA_CHANNEL2);
     // Do not enable the channel here; it will be enabled by a command
 }
 
+/**
+ * @brief Points the capture DMA channel at an arena segment and enables it.
+ * @param index Arena segment to fill next.
+ */
+static void dma_start_segment(uint8_t index) {
+    dma_disable_channel(DMA1, DMA_CHANNEL2);
+    dma_set_memory_address(DMA1, DMA_CHANNEL2, (uint32_t)capture_arena_get_segment(index));
+    dma_set_number_of_data(DMA1, DMA_CHANNEL2, (uint16_t)capture_arena_get_segment_samples());
+    dma_active_segment = index;
+    dma_enable_channel(DMA1, DMA_CHANNEL2);
+}
+
@@ -0,0 +1,251 @@
+/**
+ * @file      manchester_decoder.c
+ * @brief     Manchester and biphase-mark decoder fed from the edge stream.
+ */
+
+#include <stdio.h>
+
+#include "manchester_decoder.h"
+#include "capture_timebase.h"
+
+#define HALF_BIT_FRACTION_BITS  4U      // Fixed-point fraction of the half-bit estimate
+#define TRACKING_SHIFT          3U      // Each interval moves the estimate 1/8 of its error
+
+static const char* const s_code_names[] = { "ieee", "thomas", "bmc" };
+
+typedef enum {
+    PHASE_UNKNOWN,          // Not yet locked on to the bit phase
+    PHASE_MID,              // The last edge was mid-bit (Manchester), or a bit ended (BMC)
+    PHASE_BOUNDARY,         // The last edge was a bit boundary (Manchester), or mid-bit of a 1 (BMC)
+} bit_phase_t;
+
+// --- Static Data ---
+static manchester_decoder_config_t s_config = {
+    .channel = 0,
+    .code = MANCHESTER_CODE_IEEE,
+    .bitrate = MANCHESTER_DECODER_DEFAULT_BITRATE,
+    .sync_word = 0,
+    .sync_bits = 0,
+    .lsb_first = false,
+};
+static uint32_t s_nominal_half = 0;     // Nominal half-bit, fixed point
+
+static uint8_t s_level = 0;
+static uint32_t s_last_edge = 0;
+static bool s_in_packet = false;
+static bool s_done = false;             // Packet reported; ignore it until the line goes quiet
+static uint32_t s_packet_time = 0;
+static uint32_t s_half = 0;             // Tracked half-bit, fixed point
+static bit_phase_t s_phase = PHASE_UNKNOWN;
+
+static bool s_synced = false;
+static uint32_t s_sync_shift = 0;
+static uint8_t s_sync_count = 0;        // Bits shifted in, up to sync_bits
+
+static uint8_t s_payload[MANCHESTER_DECODER_MAX_BYTES];
+static uint32_t s_payload_bits = 0;
+
+static char* s_out = NULL;              // Buffer of the feed call in progress
+static size_t s_out_size = 0;
+static bool s_written = false;
+
+// --- Private Helper Functions ---
+
+static void report_packet(bool timing_error) {
+    s_done = true;
+    if (!s_synced || s_payload_bits == 0 || s_written) {
+        return;
+    }
+
+    static const char hex_digits[] = "0123456789ABCDEF";
+    char data[MANCHESTER_DECODER_MAX_BYTES * 2 + 1];
+    uint32_t bytes = (s_payload_bits + 7U) / 8U;
+    for (uint32_t i = 0; i < bytes; ++i) {
+        data[i * 2] = hex_digits[s_payload[i] >> 4];
+        data[i * 2 + 1] = hex_digits[s_payload[i] & 0x0F];
+    }
+    data[bytes * 2] = '\0';
+
+    uint32_t rate = (uint32_t)(((uint64_t)CAPTURE_TIMEBASE_HZ << HALF_BIT_FRACTION_BITS) / (2U * s_half));
+    snprintf(s_out, s_out_size, "{\"manchester\":{\"t\":%lu,\"code\":\"%s\",\"rate\":%lu,\"bits\":%lu,\"data\":\"%s\"%s}}",
+             (unsigned long)s_packet_time, s_code_names[s_config.code], (unsigned long)rate,
+             (unsigned long)s_payload_bits, data, timing_error ? ",\"error\":\"timing\"" : "");
+    s_written = true;
+}
+
+static void start_packet(uint32_t time) {
+    s_in_packet = true;
+    s_done = false;
+    s_packet_time = time;
+    s_half = s_nominal_half;
+    s_phase = PHASE_UNKNOWN;
+    s_synced = s_config.sync_bits == 0;
+    s_sync_shift = 0;
+    s_sync_count = 0;
+    s_payload_bits = 0;
+}
+
+static void take_bit(uint8_t bit) {
+    if (!s_synced) {
+        s_sync_shift = (s_sync_shift << 1) | bit;
+        if (s_sync_count < s_config.sync_bits) {
+            s_sync_count++;
+        }
+        uint32_t mask = (s_config.sync_bits >= 32U) ? 0xFFFFFFFFUL : ((1UL << s_config.sync_bits) - 1U);
+        s_synced = s_sync_count == s_config.sync_bits && (s_sync_shift & mask) == (s_config.sync_word & mask);
+        return;
+    }
+
+    uint32_t index = s_payload_bits / 8U;
+    uint8_t shift = (uint8_t)(s_payload_bits % 8U);
+    if (shift == 0) {
+        s_payload[index] = 0;
+    }
+    s_payload[index] |= (uint8_t)(bit << (s_config.lsb_first ? shift : 7U - shift));
+    if (++s_payload_bits == MANCHESTER_DECODER_MAX_BYTES * 8U) {
+        report_packet(false);
+    }
+}
+
+/**
+ * @brief Handles one Manchester interval of `units` half-bits ending in an edge to `level`.
+ */
+static void manchester_interval(uint8_t units, uint8_t level) {
+    // Two half-bits always run from one mid-bit edge to the next
+    if (units == 2) {
+        if (s_phase == PHASE_BOUNDARY) {
+            report_packet(true);
+            return;
+        }
+        s_phase = PHASE_MID;
+    } else if (s_phase == PHASE_MID) {
+        s_phase = PHASE_BOUNDARY;
+        return;
+    } else if (s_phase == PHASE_BOUNDARY) {
+        s_phase = PHASE_MID;
+    } else {
+        return;
+    }
+
+    uint8_t rising = level;
+    take_bit(s_config.code == MANCHESTER_CODE_IEEE ? rising : (uint8_t)!rising);
+}
+
+/**
+ * @brief Handles one biphase-mark interval of `units` half-bits.
+ */
+static void bmc_interval(uint8_t units) {
+    if (units == 2) {
+        // A whole bit without a mid-bit edge
+        if (s_phase == PHASE_BOUNDARY) {
+            report_packet(true);
+            return;
+        }
+        s_phase = PHASE_MID;
+        take_bit(0);
+    } else if (s_phase == PHASE_MID) {
+        s_phase = PHASE_BOUNDARY;
+    } else if (s_phase == PHASE_BOUNDARY) {
+        s_phase = PHASE_MID;
+        take_bit(1);
+    }
+}
+
+// --- Decoder Interface ---
+
+static void manchester_reset(void) {
+    s_in_packet = false;
+    s_level = 0;
+}
+
+static bool manchester_feed(const edge_t* edge, char* json_buffer, size_t json_buffer_size) {
+    if (edge->channel != s_config.channel) {
+        return false;
+    }
+
+    uint8_t level = edge->level ? 1U : 0U;
+    if (edge->flags & EDGE_FLAG_SYNC) {
+        // Edges were lost: drop the packet and wait for the line to go quiet
+        s_in_packet = false;
+        s_level = level;
+        s_last_edge = edge->time;
+        return false;
+    }
+    if (level == s_level) {
+        return false;
+    }
+
+    s_out = json_buffer;
+    s_out_size = json_buffer_size;
+    s_written = false;
+    s_level = level;
+    uint32_t interval = edge->time - s_last_edge;
+    s_last_edge = edge->time;
+
+    uint32_t half = s_half >> HALF_BIT_FRACTION_BITS;
+    if (!s_in_packet || interval > 2U * half + half / 2U) {
+        if (s_in_packet && !s_done) {
+            report_packet(false);
+        }
+        start_packet(edge->time);
+        return s_written;
+    }
+    if (s_done) {
+        return false;
+    }
+    if (interval < half / 2U) {
+        report_packet(true);
+        return s_written;
+    }
+
+    // Pull the estimate towards the measured half-bit
+    uint8_t units = (interval < half + half / 2U) ? 1U : 2U;
+    int32_t error = (int32_t)((interval << HALF_BIT_FRACTION_BITS) / units) - (int32_t)s_half;
+    s_half = (uint32_t)((int32_t)s_half + error / (1 << TRACKING_SHIFT));
+
+    if (s_config.code == MANCHESTER_CODE_BMC) {
+        bmc_interval(units);
+    } else {
+        manchester_interval(units, level);
+    }
+    return s_written;
+}
+
+static bool manchester_flush(uint32_t now, bool final, char* json_buffer, size_t json_buffer_size) {
+    if (!s_in_packet || s_done) {
+        return false;
+    }
+
+    // The packet ends once the line has been quiet longer than any interval within it
+    uint32_t half = s_half >> HALF_BIT_FRACTION_BITS;
+    if (!final && now - s_last_edge <= 2U * half + half / 2U) {
+        return false;
+    }
+    s_out = json_buffer;
+    s_out_size = json_buffer_size;
+    s_written = false;
+    report_packet(false);
+    return s_written;
+}
+
+const edge_decoder_t manchester_decoder = {
+    .name = "manchester",
+    .reset = manchester_reset,
+    .feed = manchester_feed,
+    .flush = manchester_flush,
+};
+
+// --- Public API Function Implementations ---
+
+int manchester_decoder_configure(const manchester_decoder_config_t* config) {
+    // Invalid arguments
+    if (config == NULL || config->code > MANCHESTER_CODE_BMC || config->sync_bits > 32U ||
+        config->bitrate < MANCHESTER_DECODER_MIN_BITRATE || config->bitrate > MANCHESTER_DECODER_MAX_BITRATE) {
+        return -1;
+    }
+
+    s_config = *config;
+    s_nominal_half = (uint32_t)(((uint64_t)CAPTURE_TIMEBASE_HZ << HALF_BIT_FRACTION_BITS) / (2U * config->bitrate));
+    manchester_reset();
+    return 0;
+}
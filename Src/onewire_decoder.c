@@ -0,0 +1,378 @@
+/**
+ * @file      onewire_decoder.c
+ * @brief     1-Wire transaction decoder fed from the edge stream.
+ */
+
+#include <stdio.h>
+
+#include "onewire_decoder.h"
+#include "capture_timebase.h"
+#include "json_text.h"
+
+#define TICKS_PER_US            (CAPTURE_TIMEBASE_HZ / 1000000UL)
+
+// Low-pulse widths in microseconds, with margin around the nominal timings
+#define STD_RESET_MIN_US        410U    // Nominal 480
+#define STD_SAMPLE_US           15U     // Master samples read slots here
+#define STD_SLOT_MAX_US         240U    // Write-0 low time is at most 120
+#define STD_PRESENCE_WAIT_US    75U     // Slave waits 15-60 after the reset
+#define OD_RESET_MIN_US         40U     // Nominal 48-80
+#define OD_SAMPLE_US            2U
+#define OD_SLOT_MAX_US          24U     // Write-0 low time is at most 16
+#define OD_PRESENCE_WAIT_US     10U     // Slave waits 2-6 after the reset
+#define IDLE_END_US             1000U   // Line high this long ends the transaction
+
+// ROM commands
+#define ROM_READ                0x33U
+#define ROM_MATCH               0x55U
+#define ROM_SKIP                0xCCU
+#define ROM_SEARCH              0xF0U
+#define ROM_ALARM_SEARCH        0xECU
+#define ROM_RESUME              0xA5U
+#define ROM_OD_SKIP             0x3CU
+#define ROM_OD_MATCH            0x69U
+
+// Function commands whose reply ends with a CRC-8
+#define FUNC_READ_SCRATCHPAD    0xBEU
+#define SCRATCHPAD_BYTES        9U      // Eight data bytes and their CRC-8
+
+#define ROM_BYTES               8U
+#define SEARCH_SLOTS            (ROM_BYTES * 8U * 3U)   // Bit, complement and direction per ROM bit
+
+typedef enum {
+    PHASE_ROM_COMMAND,
+    PHASE_ROM,              // Read/Match ROM: the 64-bit ROM
+    PHASE_SEARCH,           // Search ROM: 64 bit triplets
+    PHASE_DATA,             // Function command and payload
+} onewire_phase_t;
+
+// --- Static Data ---
+static onewire_decoder_config_t s_config = { .channel = 0 };
+
+static uint8_t s_level = 1;
+static uint32_t s_fall_time = 0;
+static uint32_t s_rise_time = 0;
+static bool s_overdrive = false;
+
+static bool s_active = false;           // A transaction has started with a reset
+static uint32_t s_start_time = 0;
+static uint32_t s_release_time = 0;     // End of the reset pulse
+static bool s_expect_presence = false;
+static bool s_in_presence = false;
+static bool s_presence = false;
+static bool s_transaction_od = false;   // Reset taken at overdrive speed
+
+static onewire_phase_t s_phase = PHASE_ROM_COMMAND;
+static uint8_t s_byte = 0;
+static uint8_t s_bit_count = 0;
+static bool s_has_rom_command = false;
+static uint8_t s_rom_command = 0;
+static uint8_t s_rom[ROM_BYTES];
+static uint8_t s_rom_length = 0;
+static uint8_t s_search_slot = 0;       // Slot within the current triplet
+static uint8_t s_search_bits = 0;
+static uint8_t s_data[ONEWIRE_DECODER_MAX_DATA_BYTES];
+static uint32_t s_data_length = 0;      // May exceed what is kept
+static uint32_t s_bad_slots = 0;
+
+// --- Private Helper Functions ---
+
+static void append_hex(char** buf, size_t* remaining, const uint8_t* bytes, uint32_t count) {
+    static const char hex_digits[] = "0123456789ABCDEF";
+    char digits[3] = { 0 };
+    for (uint32_t i = 0; i < count; ++i) {
+        digits[0] = hex_digits[bytes[i] >> 4];
+        digits[1] = hex_digits[bytes[i] & 0x0F];
+        json_text_append(buf, remaining, digits);
+    }
+}
+
+/**
+ * @brief Dallas/Maxim CRC-8 (x^8 + x^5 + x^4 + 1, LSB first).
+ * @return 0 over a block that ends with its own CRC.
+ */
+static uint8_t crc8(const uint8_t* bytes, uint32_t count) {
+    uint8_t crc = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        crc ^= bytes[i];
+        for (uint8_t bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1U) ? (uint8_t)((crc >> 1) ^ 0x8CU) : (uint8_t)(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+static void start_transaction(uint32_t start_time, uint32_t release_time) {
+    s_active = true;
+    s_start_time = start_time;
+    s_release_time = release_time;
+    s_expect_presence = true;
+    s_in_presence = false;
+    s_presence = false;
+    s_transaction_od = s_overdrive;
+    s_phase = PHASE_ROM_COMMAND;
+    s_byte = 0;
+    s_bit_count = 0;
+    s_has_rom_command = false;
+    s_rom_length = 0;
+    s_search_slot = 0;
+    s_search_bits = 0;
+    s_data_length = 0;
+    s_bad_slots = 0;
+}
+
+static void format_transaction(char* json_buffer, size_t json_buffer_size) {
+    char* ptr = json_buffer;
+    size_t remaining = json_buffer_size;
+    char field[48];
+
+    snprintf(field, sizeof(field), "{\"onewire\":{\"t\":%lu,\"od\":%u,\"presence\":%u",
+             (unsigned long)s_start_time, s_transaction_od, s_presence);
+    json_text_append(&ptr, &remaining, field);
+
+    if (s_has_rom_command) {
+        snprintf(field, sizeof(field), ",\"rom_cmd\":%u", s_rom_command);
+        json_text_append(&ptr, &remaining, field);
+    }
+    if (s_rom_length > 0) {
+        json_text_append(&ptr, &remaining, ",\"rom\":\"");
+        append_hex(&ptr, &remaining, s_rom, s_rom_length);
+        snprintf(field, sizeof(field), "\",\"rom_crc\":%u",
+                 (s_rom_length == ROM_BYTES && crc8(s_rom, ROM_BYTES) == 0) ? 1U : 0U);
+        json_text_append(&ptr, &remaining, field);
+    }
+    if (s_data_length > 0) {
+        uint32_t kept = s_data_length < ONEWIRE_DECODER_MAX_DATA_BYTES ? s_data_length : ONEWIRE_DECODER_MAX_DATA_BYTES;
+        json_text_append(&ptr, &remaining, ",\"data\":\"");
+        append_hex(&ptr, &remaining, s_data, kept);
+        json_text_append(&ptr, &remaining, "\"");
+
+        // The scratchpad follows the function command byte; a master may stop reading early
+        if (s_data[0] == FUNC_READ_SCRATCHPAD) {
+            if (s_data_length >= 1U + SCRATCHPAD_BYTES) {
+                snprintf(field, sizeof(field), ",\"data_crc\":%u",
+                         crc8(&s_data[1], SCRATCHPAD_BYTES) == 0 ? 1U : 0U);
+                json_text_append(&ptr, &remaining, field);
+            } else {
+                json_text_append(&ptr, &remaining, ",\"data_crc\":null");
+            }
+        }
+        if (kept < s_data_length) {
+            snprintf(field, sizeof(field), ",\"data_bytes\":%lu", (unsigned long)s_data_length);
+            json_text_append(&ptr, &remaining, field);
+        }
+    }
+    if (s_bit_count > 0) {
+        snprintf(field, sizeof(field), ",\"bits\":%u", s_bit_count);
+        json_text_append(&ptr, &remaining, field);
+    }
+    if (s_bad_slots > 0) {
+        snprintf(field, sizeof(field), ",\"bad_slots\":%lu", (unsigned long)s_bad_slots);
+        json_text_append(&ptr, &remaining, field);
+    }
+    json_text_append(&ptr, &remaining, "}}");
+}
+
+/**
+ * @brief Shifts a bit into the current byte, LSB first.
+ * @return true once the byte is complete.
+ */
+static bool shift_bit(uint8_t bit) {
+    s_byte |= (uint8_t)(bit << s_bit_count);
+    if (++s_bit_count < 8) {
+        return false;
+    }
+    s_bit_count = 0;
+    return true;
+}
+
+static void take_rom_command(uint8_t command) {
+    s_has_rom_command = true;
+    s_rom_command = command;
+
+    switch (command) {
+        case ROM_OD_MATCH:
+            s_overdrive = true;
+            s_phase = PHASE_ROM;
+            break;
+        case ROM_READ:
+        case ROM_MATCH:
+            s_phase = PHASE_ROM;
+            break;
+        case ROM_SEARCH:
+        case ROM_ALARM_SEARCH:
+            s_phase = PHASE_SEARCH;
+            break;
+        case ROM_OD_SKIP:
+            s_overdrive = true;
+            s_phase = PHASE_DATA;
+            break;
+        default:
+            // Skip ROM, Resume, or a function command sent without one
+            s_phase = PHASE_DATA;
+            break;
+    }
+}
+
+static void take_bit(uint8_t bit) {
+    if (s_phase == PHASE_SEARCH) {
+        // The direction bit written after each bit/complement pair selects the ROM bit
+        if (++s_search_slot < 3) {
+            return;
+        }
+        s_search_slot = 0;
+        if (shift_bit(bit)) {
+            s_rom[s_rom_length++] = s_byte;
+            s_byte = 0;
+        }
+        if (++s_search_bits == ROM_BYTES * 8U) {
+            s_phase = PHASE_DATA;
+        }
+        return;
+    }
+
+    if (!shift_bit(bit)) {
+        return;
+    }
+    uint8_t byte = s_byte;
+    s_byte = 0;
+
+    switch (s_phase) {
+        case PHASE_ROM_COMMAND:
+            take_rom_command(byte);
+            break;
+        case PHASE_ROM:
+            s_rom[s_rom_length++] = byte;
+            if (s_rom_length == ROM_BYTES) {
+                s_phase = PHASE_DATA;
+            }
+            break;
+        default:
+            if (s_data_length < ONEWIRE_DECODER_MAX_DATA_BYTES) {
+                s_data[s_data_length] = byte;
+            }
+            s_data_length++;
+            break;
+    }
+}
+
+/**
+ * @brief Classifies a complete low pulse.
+ * @return true if it ended a transaction that was written to the buffer.
+ */
+static bool take_pulse(uint32_t fall_time, uint32_t rise_time, char* json_buffer, size_t json_buffer_size) {
+    uint32_t width = rise_time - fall_time;
+
+    // A standard reset works at either speed and drops out of overdrive
+    bool reset = width >= STD_RESET_MIN_US * TICKS_PER_US;
+    if (reset) {
+        s_overdrive = false;
+    } else {
+        reset = s_overdrive && width >= OD_RESET_MIN_US * TICKS_PER_US;
+    }
+
+    if (reset) {
+        bool written = false;
+        if (s_active) {
+            format_transaction(json_buffer, json_buffer_size);
+            written = true;
+        }
+        start_transaction(fall_time, rise_time);
+        return written;
+    }
+
+    if (s_in_presence) {
+        s_in_presence = false;
+        s_presence = true;
+        return false;
+    }
+    if (!s_active) {
+        return false;
+    }
+
+    uint32_t sample = (s_overdrive ? OD_SAMPLE_US : STD_SAMPLE_US) * TICKS_PER_US;
+    uint32_t slot_max = (s_overdrive ? OD_SLOT_MAX_US : STD_SLOT_MAX_US) * TICKS_PER_US;
+    if (width > slot_max) {
+        s_bad_slots++;
+    }
+    take_bit(width < sample ? 1U : 0U);
+    return false;
+}
+
+// --- Decoder Interface ---
+
+static void onewire_reset(void) {
+    s_level = 1;
+    s_overdrive = false;
+    s_active = false;
+    s_expect_presence = false;
+    s_in_presence = false;
+}
+
+static bool onewire_feed(const edge_t* edge, char* json_buffer, size_t json_buffer_size) {
+    if (edge->channel != s_config.channel) {
+        return false;
+    }
+
+    uint8_t level = edge->level ? 1U : 0U;
+    if (edge->flags & EDGE_FLAG_SYNC) {
+        // Slots were lost: drop the transaction and wait for the next reset
+        onewire_reset();
+        s_level = level;
+        s_fall_time = edge->time;
+        s_rise_time = edge->time;
+        return false;
+    }
+    if (level == s_level) {
+        return false;
+    }
+    s_level = level;
+
+    if (!level) {
+        if (s_expect_presence) {
+            uint32_t wait = (s_overdrive ? OD_PRESENCE_WAIT_US : STD_PRESENCE_WAIT_US) * TICKS_PER_US;
+            s_in_presence = edge->time - s_release_time <= wait;
+            s_expect_presence = false;
+        }
+        s_fall_time = edge->time;
+        return false;
+    }
+    s_rise_time = edge->time;
+    return take_pulse(s_fall_time, edge->time, json_buffer, json_buffer_size);
+}
+
+static bool onewire_flush(uint32_t now, bool final, char* json_buffer, size_t json_buffer_size) {
+    if (!s_active) {
+        return false;
+    }
+
+    // Slots follow each other closely; a long idle high means the master is done
+    if (!final && (!s_level || now - s_rise_time < IDLE_END_US * TICKS_PER_US)) {
+        return false;
+    }
+    format_transaction(json_buffer, json_buffer_size);
+    s_active = false;
+    s_expect_presence = false;
+    s_in_presence = false;
+    return true;
+}
+
+const edge_decoder_t onewire_decoder = {
+    .name = "onewire",
+    .reset = onewire_reset,
+    .feed = onewire_feed,
+    .flush = onewire_flush,
+};
+
+// --- Public API Function Implementations ---
+
+int onewire_decoder_configure(const onewire_decoder_config_t* config) {
+    // Invalid arguments
+    if (config == NULL) {
+        return -1;
+    }
+
+    s_config = *config;
+    onewire_reset();
+    return 0;
+}
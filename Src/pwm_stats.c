@@ -0,0 +1,268 @@
+/**
+ * @file      pwm_stats.c
+ * @brief     Per-channel pulse-width statistics over the edge stream.
+ */
+
+#include <stdio.h>
+
+#include "pwm_stats.h"
+#include "capture_timebase.h"
+#include "json_text.h"
+
+#define HISTOGRAM_BINS          32U     // One per octave of a 32-bit width
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint64_t sum_squares;
+    uint32_t histogram[HISTOGRAM_BINS];
+} width_stats_t;
+
+typedef struct {
+    bool started;           // A window is open
+    bool has_edge;          // last_edge is a real transition, so the next width is valid
+    uint8_t level;
+    uint32_t last_edge;
+    uint32_t window_start;
+    uint32_t level_since;   // Time up to which the level has been accounted
+    uint32_t level_ticks;   // Time of the window with a known level
+    uint32_t high_ticks;    // Part of it spent high
+    uint32_t rise_count;
+    uint32_t first_rise;
+    uint32_t last_rise;
+    width_stats_t high;
+    width_stats_t low;
+} channel_stats_t;
+
+// --- Static Data ---
+static pwm_stats_config_t s_config = { .window_ms = PWM_STATS_DEFAULT_WINDOW_MS };
+static uint32_t s_window_ticks = (uint32_t)(CAPTURE_TIMEBASE_HZ / 1000U * PWM_STATS_DEFAULT_WINDOW_MS);
+static channel_stats_t s_channels[PWM_STATS_MAX_CHANNELS];
+
+// --- Private Helper Functions ---
+
+static uint32_t isqrt64(uint64_t value) {
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
+
+static void clear_widths(width_stats_t* stats) {
+    stats->count = 0;
+    stats->min = UINT32_MAX;
+    stats->max = 0;
+    stats->sum = 0;
+    stats->sum_squares = 0;
+    for (uint8_t i = 0; i < HISTOGRAM_BINS; ++i) {
+        stats->histogram[i] = 0;
+    }
+}
+
+static void add_width(width_stats_t* stats, uint32_t width) {
+    stats->count++;
+    if (width < stats->min) {
+        stats->min = width;
+    }
+    if (width > stats->max) {
+        stats->max = width;
+    }
+    stats->sum += width;
+    stats->sum_squares += (uint64_t)width * width;
+    stats->histogram[width ? 31U - (uint32_t)__builtin_clz(width) : 0]++;
+}
+
+static void start_window(channel_stats_t* channel, uint32_t time) {
+    channel->started = true;
+    channel->window_start = time;
+    channel->level_since = time;
+    channel->level_ticks = 0;
+    channel->high_ticks = 0;
+    channel->rise_count = 0;
+    clear_widths(&channel->high);
+    clear_widths(&channel->low);
+}
+
+static void account_level(channel_stats_t* channel, uint32_t time) {
+    uint32_t ticks = time - channel->level_since;
+    channel->level_ticks += ticks;
+    if (channel->level) {
+        channel->high_ticks += ticks;
+    }
+    channel->level_since = time;
+}
+
+static void append_widths(char** buf, size_t* remaining, const char* name, const width_stats_t* stats) {
+    char field[112];
+
+    if (stats->count == 0) {
+        snprintf(field, sizeof(field), ",\"%s\":{\"n\":0}", name);
+        json_text_append(buf, remaining, field);
+        return;
+    }
+
+    uint32_t mean = (uint32_t)(stats->sum / stats->count);
+    uint64_t mean_square = stats->sum_squares / stats->count;
+    uint64_t variance = mean_square > (uint64_t)mean * mean ? mean_square - (uint64_t)mean * mean : 0;
+    snprintf(field, sizeof(field), ",\"%s\":{\"n\":%lu,\"min\":%lu,\"max\":%lu,\"mean\":%lu,\"sd\":%lu,\"hist\":[",
+             name, (unsigned long)stats->count, (unsigned long)stats->min, (unsigned long)stats->max,
+             (unsigned long)mean, (unsigned long)isqrt64(variance));
+    json_text_append(buf, remaining, field);
+
+    uint8_t first = 0;
+    uint8_t last = HISTOGRAM_BINS - 1U;
+    while (stats->histogram[first] == 0) {
+        first++;
+    }
+    while (stats->histogram[last] == 0) {
+        last--;
+    }
+    snprintf(field, sizeof(field), "%u,[", first);
+    json_text_append(buf, remaining, field);
+    for (uint8_t i = first; i <= last; ++i) {
+        snprintf(field, sizeof(field), "%s%lu", (i == first) ? "" : ",", (unsigned long)stats->histogram[i]);
+        json_text_append(buf, remaining, field);
+    }
+    json_text_append(buf, remaining, "]]}");
+}
+
+static void report_window(uint8_t index, uint32_t end_time, char* json_buffer, size_t json_buffer_size) {
+    const channel_stats_t* channel = &s_channels[index];
+    char* ptr = json_buffer;
+    size_t remaining = json_buffer_size;
+    char field[128];
+
+    // Mean period from the first to the last rising edge of the window
+    uint32_t period = 0;
+    uint32_t freq_millihz = 0;
+    if (channel->rise_count >= 2) {
+        period = (channel->last_rise - channel->first_rise) / (channel->rise_count - 1U);
+        freq_millihz = period ? (uint32_t)((uint64_t)CAPTURE_TIMEBASE_HZ * 1000U / period) : 0;
+    }
+    uint32_t duty = channel->level_ticks ? (uint32_t)((uint64_t)channel->high_ticks * 10000U / channel->level_ticks) : 0;
+
+    snprintf(field, sizeof(field), "{\"pwm\":{\"ch\":%u,\"t\":%lu,\"span\":%lu,\"period\":%lu,\"freq_millihz\":%lu,\"duty\":%lu",
+             index, (unsigned long)channel->window_start, (unsigned long)(end_time - channel->window_start),
+             (unsigned long)period, (unsigned long)freq_millihz, (unsigned long)duty);
+    json_text_append(&ptr, &remaining, field);
+    append_widths(&ptr, &remaining, "high", &channel->high);
+    append_widths(&ptr, &remaining, "low", &channel->low);
+    json_text_append(&ptr, &remaining, "}}");
+}
+
+// --- Decoder Interface ---
+
+static void pwm_stats_reset(void) {
+    for (uint8_t i = 0; i < PWM_STATS_MAX_CHANNELS; ++i) {
+        s_channels[i].started = false;
+        s_channels[i].has_edge = false;
+    }
+}
+
+static bool pwm_stats_feed(const edge_t* edge, char* json_buffer, size_t json_buffer_size) {
+    if (edge->channel >= PWM_STATS_MAX_CHANNELS) {
+        return false;
+    }
+
+    channel_stats_t* channel = &s_channels[edge->channel];
+    uint8_t level = edge->level ? 1U : 0U;
+
+    if (edge->flags & EDGE_FLAG_SYNC) {
+        // Edges were lost: the pulse in progress has no known start, and
+        // neither has the level since the last edge
+        channel->has_edge = false;
+        channel->level = level;
+        if (!channel->started) {
+            start_window(channel, edge->time);
+        }
+        channel->level_since = edge->time;
+        return false;
+    }
+    if (channel->has_edge && level == channel->level) {
+        return false;
+    }
+
+    if (!channel->started) {
+        start_window(channel, edge->time);
+    }
+    account_level(channel, edge->time);
+    if (channel->has_edge) {
+        add_width(level ? &channel->low : &channel->high, edge->time - channel->last_edge);
+    }
+    if (level) {
+        if (channel->rise_count++ == 0) {
+            channel->first_rise = edge->time;
+        }
+        channel->last_rise = edge->time;
+    }
+    channel->level = level;
+    channel->last_edge = edge->time;
+    channel->has_edge = true;
+
+    // The pulse that ends here closes the window it belongs to
+    if (edge->time - channel->window_start < s_window_ticks) {
+        return false;
+    }
+    report_window(edge->channel, edge->time, json_buffer, json_buffer_size);
+    start_window(channel, edge->time);
+    if (level) {
+        channel->rise_count = 1;
+        channel->first_rise = edge->time;
+        channel->last_rise = edge->time;
+    }
+    return true;
+}
+
+static bool pwm_stats_flush(uint32_t now, bool final, char* json_buffer, size_t json_buffer_size) {
+    // A channel holding its level still closes its windows on time
+    for (uint8_t i = 0; i < PWM_STATS_MAX_CHANNELS; ++i) {
+        channel_stats_t* channel = &s_channels[i];
+        if (!channel->started || (!final && now - channel->window_start < s_window_ticks)) {
+            continue;
+        }
+
+        account_level(channel, now);
+        report_window(i, now, json_buffer, json_buffer_size);
+        if (final) {
+            channel->started = false;
+        } else {
+            start_window(channel, now);
+        }
+        return true;
+    }
+    return false;
+}
+
+const edge_decoder_t pwm_stats_decoder = {
+    .name = "pwm",
+    .reset = pwm_stats_reset,
+    .feed = pwm_stats_feed,
+    .flush = pwm_stats_flush,
+};
+
+// --- Public API Function Implementations ---
+
+int pwm_stats_configure(const pwm_stats_config_t* config) {
+    // Invalid arguments
+    if (config == NULL || config->window_ms == 0 || config->window_ms > PWM_STATS_MAX_WINDOW_MS) {
+        return -1;
+    }
+
+    s_config = *config;
+    s_window_ticks = (uint32_t)((uint64_t)CAPTURE_TIMEBASE_HZ * config->window_ms / 1000U);
+    pwm_stats_reset();
+    return 0;
+}
@@ -0,0 +1,242 @@
+/**
+ * @file      spi_sampler.c
+ * @brief     High-rate single-line sampling using SPI1 as a receive-only deserializer.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "spi_sampler.h"
+#include "analog_capture.h"
+#include "capture_arena.h"
+#include "capture_timebase.h"
+#include "dma_ring.h"
+#include "nvic.h"
+#include "dma.h"
+#include "gpio.h"
+
+#define GPIO_PORT_A             0
+#define GPIO_AF_SPI1            5
+#define SAMPLER_PIN             6       // PA6 = SPI1_MISO
+
+// SPI1_RX on DMA2 Stream0 Ch3
+#define SAMPLER_SPI_NUM         1
+#define SAMPLER_DMA_NUM         2
+#define SAMPLER_STREAM_NUM      0
+#define SAMPLER_CHANNEL         3
+#define SAMPLER_IRQN            56      // DMA2_Stream0_IRQn
+
+// --- Static Data ---
+static spi_handle_t s_spi = NULL;
+static gpio_handle_t s_pin = NULL;
+static dma_ring_t s_ring;
+static bool s_running = false;
+
+static uint32_t s_ticks_per_bit = 0;
+static uint32_t s_start_time = 0;   // Timestamp of the first sample
+static uint32_t s_read_pos = 0;     // Next ring byte to scan
+static uint8_t s_level = 0;         // Level of the last scanned sample
+static bool s_synced = false;       // false until a level marker has been queued
+
+// --- Private Helper Functions ---
+
+static void ring_callback(dma_handle_t dma, void* user_data) {
+    (void)dma;
+    (void)user_data;
+    dma_ring_handle_wrap(&s_ring);
+}
+
+static uint32_t time_of_byte(uint32_t position) {
+    return s_start_time + position * 8U * s_ticks_per_bit;
+}
+
+static bool is_older(uint32_t time, uint32_t reference) {
+    return (int32_t)(time - reference) < 0;
+}
+
+/**
+ * @brief Scans the next stretch of the ring into the edge stream.
+ * @return true if any progress was made.
+ */
+static bool extract_pending(void) {
+    taskENTER_CRITICAL();
+    uint32_t now = dma_ring_position(&s_ring);
+    taskEXIT_CRITICAL();
+
+    // Fell a whole ring behind: skip to the newest data and mark the gap
+    if (now - s_read_pos > s_ring.length) {
+        s_read_pos = now;
+        s_synced = false;
+        return true;
+    }
+
+    // Analog scans taken before this stretch go first, keeping records in time order
+    bool progress = false;
+    uint32_t analog_time;
+    while (analog_capture_next_time(&analog_time) && is_older(analog_time, time_of_byte(s_read_pos))) {
+        if (!analog_capture_push_next()) {
+            return progress;
+        }
+        progress = true;
+    }
+
+    uint32_t pending = now - s_read_pos;
+    if (pending == 0 || edge_stream_free() < 1U + 8U) {
+        return progress;
+    }
+
+    if (!s_synced) {
+        s_level = dma_ring_byte_at(&s_ring, s_read_pos) >> 7;
+        edge_stream_push(time_of_byte(s_read_pos), SPI_SAMPLER_CHANNEL, s_level, EDGE_FLAG_SYNC);
+        s_synced = true;
+    }
+
+    // Every byte may hold up to 8 edges; never scan more than the queue can take
+    uint32_t budget = edge_stream_free() / 8U;
+    uint32_t count = pending;
+    if (count > budget) {
+        count = budget;
+    }
+    if (count > SPI_SAMPLER_EXTRACT_BYTES) {
+        count = SPI_SAMPLER_EXTRACT_BYTES;
+    }
+    // End the stretch at the byte holding the next analog scan
+    if (analog_capture_next_time(&analog_time)) {
+        uint32_t limit = (analog_time - time_of_byte(s_read_pos)) / (8U * s_ticks_per_bit) + 1U;
+        if (count > limit) {
+            count = limit;
+        }
+    }
+
+    uint32_t start = s_read_pos;
+    uint32_t done = 0;
+    while (done < count) {
+        uint32_t offset = (start + done) & (s_ring.length - 1U);
+        uint32_t span = s_ring.length - offset;
+        if (span > count - done) {
+            span = count - done;
+        }
+        edge_stream_extract_packed(SPI_SAMPLER_CHANNEL, &s_ring.buffer[offset], span,
+                                   time_of_byte(start + done), s_ticks_per_bit, &s_level);
+        done += span;
+    }
+    s_read_pos = start + count;
+
+    // The DMA kept writing during the scan; if it lapped the scanned bytes
+    // the edges are unreliable, so restart with a fresh level marker
+    if (dma_ring_is_overwritten(&s_ring, start)) {
+        s_synced = false;
+    }
+    return true;
+}
+
+// --- Public API Function Implementations ---
+
+int spi_sampler_start(spi_baud_rate_t prescaler, const edge_decoder_t* decoder) {
+    if (s_running || prescaler > SPI_BAUD_RATE_DIV_256 || capture_arena_get_segment_count() < 1) {
+        return -1;
+    }
+
+    uint32_t segment_bytes = capture_arena_get_segment_samples() * sizeof(capture_sample_t);
+    uint32_t ring_bytes = dma_ring_fit_length(segment_bytes, SPI_SAMPLER_MAX_RING_BYTES);
+    if (ring_bytes < SPI_SAMPLER_MIN_RING_BYTES) {
+        return -1;
+    }
+
+    // One SPI bit clock is 2^(prescaler + 1) APB2 cycles
+    s_ticks_per_bit = (uint32_t)(CAPTURE_TIMEBASE_HZ / SPI_SAMPLER_KERNEL_HZ) << ((uint32_t)prescaler + 1U);
+    s_read_pos = 0;
+    s_synced = false;
+    edge_stream_reset(decoder);
+    capture_timebase_init();
+
+    const gpio_config_t pin_cfg = {
+        .mode = GPIO_MODE_ALTERNATE_FUNCTION,
+        .pull = GPIO_PULL_NONE,
+        .output_type = GPIO_OUTPUT_TYPE_PUSH_PULL,
+        .speed = GPIO_SPEED_VERY_HIGH,
+        .alternate_function = GPIO_AF_SPI1,
+    };
+    const spi_config_t spi_cfg = {
+        .baud_rate_prescaler = prescaler,
+        .clock_polarity = SPI_CLOCK_POLARITY_LOW,
+        .clock_phase = SPI_CLOCK_PHASE_1_EDGE,
+        .bit_order = SPI_BIT_ORDER_MSB_FIRST,
+        .mode = SPI_MODE_MASTER_RX_ONLY,
+    };
+    const dma_config_t dma_cfg = {
+        .channel = SAMPLER_CHANNEL,
+        .direction = DMA_DIRECTION_PERIPHERAL_TO_MEMORY,
+        .priority = DMA_PRIORITY_VERY_HIGH,
+        .peripheral_data_size = DMA_DATA_SIZE_8_BIT,
+        .memory_data_size = DMA_DATA_SIZE_8_BIT,
+        .peripheral_increment = false,
+        .memory_increment = true,
+        .circular_mode = true,
+        .fifo_mode = false,
+        .fifo_threshold = DMA_FIFO_THRESHOLD_1_4,
+        .memory_burst = DMA_BURST_SINGLE,
+        .peripheral_burst = DMA_BURST_SINGLE,
+    };
+
+    s_running = true;
+    s_pin = gpio_init(GPIO_PORT_A, (1 << SAMPLER_PIN), &pin_cfg);
+    s_spi = spi_init(SAMPLER_SPI_NUM, &spi_cfg);
+    dma_handle_t dma = dma_init(SAMPLER_DMA_NUM, SAMPLER_STREAM_NUM, &dma_cfg);
+    s_ring.dma = dma;
+    if (s_pin == NULL || s_spi == NULL || dma == NULL) {
+        spi_sampler_stop();
+        return -2;
+    }
+
+    dma_set_callback(dma, ring_callback, NULL);
+    nvic_set_priority(SAMPLER_IRQN, SPI_SAMPLER_IRQ_PRIORITY);
+    nvic_enable_irq(SAMPLER_IRQN);
+
+    // The bit clock runs from the moment SPI1 is enabled, so arm the ring first
+    dma_ring_start(&s_ring, dma, spi_get_data_register(s_spi), (uint8_t*)capture_arena_get_segment(0), ring_bytes);
+    spi_set_rx_dma(s_spi, true);
+    s_start_time = capture_timebase_now();
+    spi_set_enabled(s_spi, true);
+    return 0;
+}
+
+void spi_sampler_stop(void) {
+    if (!s_running) {
+        return;
+    }
+
+    nvic_disable_irq(SAMPLER_IRQN);
+    if (s_spi) {
+        spi_set_enabled(s_spi, false);
+        spi_set_rx_dma(s_spi, false);
+    }
+    dma_deinit(&s_ring.dma);
+    spi_deinit(&s_spi);
+    gpio_deinit(&s_pin);
+
+    s_ring.length = 0;
+    s_running = false;
+}
+
+bool spi_sampler_poll(char* json_buffer, size_t json_buffer_size) {
+    if (!s_running) {
+        return false;
+    }
+
+    while (!edge_stream_poll(json_buffer, json_buffer_size)) {
+        if (!extract_pending()) {
+            // Every sample before the read position has been turned into edges
+            return s_synced && edge_stream_flush(time_of_byte(s_read_pos), json_buffer, json_buffer_size);
+        }
+    }
+    return true;
+}
+
+uint32_t spi_sampler_get_sample_rate(void) {
+    return s_running ? (uint32_t)(CAPTURE_TIMEBASE_HZ / s_ticks_per_bit) : 0;
+}
+
+uint32_t spi_sampler_get_ring_bytes(void) {
+    return s_running ? s_ring.length : 0;
+}
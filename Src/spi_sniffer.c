@@ -0,0 +1,302 @@
+/**
+ * @file      spi_sniffer.c
+ * @brief     Wire-speed SPI capture using two SPI peripherals as receive-only slaves.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "spi_sniffer.h"
+#include "capture_arena.h"
+#include "capture_timebase.h"
+#include "dma_ring.h"
+#include "json_text.h"
+#include "nvic.h"
+#include "dma.h"
+#include "gpio.h"
+#include "exti.h"
+
+#define GPIO_PORT_A             0
+#define GPIO_PORT_B             1
+#define GPIO_AF_SPI1_SPI2       5
+
+#define SNIFF_CS_PORT           GPIO_PORT_A
+#define SNIFF_CS_PIN            4
+
+// RX request mapping: SPI1_RX on DMA2 Stream0 Ch3, SPI2_RX on DMA1 Stream3 Ch0
+#define SNIFF_MOSI_SPI_NUM      1
+#define SNIFF_MOSI_DMA_NUM      2
+#define SNIFF_MOSI_STREAM_NUM   0
+#define SNIFF_MOSI_CHANNEL      3
+#define SNIFF_MOSI_IRQN         56      // DMA2_Stream0_IRQn
+
+#define SNIFF_MISO_SPI_NUM      2
+#define SNIFF_MISO_DMA_NUM      1
+#define SNIFF_MISO_STREAM_NUM   3
+#define SNIFF_MISO_CHANNEL      0
+#define SNIFF_MISO_IRQN         14      // DMA1_Stream3_IRQn
+
+#define SNIFF_CS_IRQN           10      // EXTI4_IRQn
+
+/** @brief Index of each sniffed line in the ring table. */
+enum { SNIFF_MOSI = 0, SNIFF_MISO, SNIFF_LINE_COUNT };
+
+/** @brief One sniffed line: its receive-only slave and DMA ring. */
+typedef struct {
+    spi_handle_t spi;
+    dma_ring_t ring;
+} sniff_line_t;
+
+/** @brief A timestamped CS edge and the ring positions at that moment. */
+typedef struct {
+    uint32_t timestamp;
+    uint32_t position[SNIFF_LINE_COUNT];
+    bool released;  // true for CS going high (end of frame)
+} cs_event_t;
+
+// --- Static Data ---
+static sniff_line_t s_lines[SNIFF_LINE_COUNT];
+static uint32_t s_ring_bytes = 0;
+static bool s_running = false;
+
+static gpio_handle_t s_cs_pin = NULL;
+static gpio_handle_t s_bus_pins[SNIFF_LINE_COUNT] = {NULL};
+static exti_handle_t s_cs_exti = NULL;
+
+static cs_event_t s_events[SPI_SNIFFER_EVENT_QUEUE_LENGTH];
+static volatile uint8_t s_event_head = 0;   // Written by the EXTI ISR
+static volatile uint8_t s_event_tail = 0;   // Written by the poller
+static volatile uint32_t s_events_dropped = 0;
+
+static cs_event_t s_frame_start;
+static bool s_in_frame = false;
+
+// --- Private Helper Functions ---
+
+static void cs_edge_callback(uint8_t line_num, void* user_data) {
+    (void)line_num;
+    (void)user_data;
+    uint32_t timestamp = capture_timebase_now();
+
+    uint8_t next = (s_event_head + 1) % SPI_SNIFFER_EVENT_QUEUE_LENGTH;
+    if (next == s_event_tail) {
+        s_events_dropped++;
+        return;
+    }
+
+    cs_event_t* event = &s_events[s_event_head];
+    event->timestamp = timestamp;
+    event->released = gpio_read(s_cs_pin);
+    event->position[SNIFF_MOSI] = dma_ring_position(&s_lines[SNIFF_MOSI].ring);
+    event->position[SNIFF_MISO] = dma_ring_position(&s_lines[SNIFF_MISO].ring);
+    s_event_head = next;
+}
+
+static void ring_callback(dma_handle_t dma, void* user_data) {
+    (void)dma;
+    dma_ring_handle_wrap((dma_ring_t*)user_data);
+}
+
+static int start_line(sniff_line_t* line, uint8_t* buffer, uint8_t spi_num, uint8_t dma_num,
+                      uint8_t stream_num, uint8_t channel, uint8_t irqn, const spi_config_t* spi_cfg) {
+    const dma_config_t dma_cfg = {
+        .channel = channel,
+        .direction = DMA_DIRECTION_PERIPHERAL_TO_MEMORY,
+        .priority = DMA_PRIORITY_VERY_HIGH,
+        .peripheral_data_size = DMA_DATA_SIZE_8_BIT,
+        .memory_data_size = DMA_DATA_SIZE_8_BIT,
+        .peripheral_increment = false,
+        .memory_increment = true,
+        .circular_mode = true,
+        .fifo_mode = false,
+        .fifo_threshold = DMA_FIFO_THRESHOLD_1_4,
+        .memory_burst = DMA_BURST_SINGLE,
+        .peripheral_burst = DMA_BURST_SINGLE,
+    };
+
+    line->spi = spi_init(spi_num, spi_cfg);
+    dma_handle_t dma = dma_init(dma_num, stream_num, &dma_cfg);
+    line->ring.dma = dma;
+    if (line->spi == NULL || dma == NULL) {
+        return -2;
+    }
+
+    dma_set_callback(dma, ring_callback, &line->ring);
+    nvic_set_priority(irqn, SPI_SNIFFER_IRQ_PRIORITY);
+    nvic_enable_irq(irqn);
+
+    // Arm the ring before the SPI starts raising requests
+    dma_ring_start(&line->ring, dma, spi_get_data_register(line->spi), buffer, s_ring_bytes);
+    spi_set_rx_dma(line->spi, true);
+    return 0;
+}
+
+static void stop_line(sniff_line_t* line, uint8_t irqn) {
+    nvic_disable_irq(irqn);
+    if (line->spi) {
+        spi_set_rx_dma(line->spi, false);
+    }
+    dma_deinit(&line->ring.dma);
+    spi_deinit(&line->spi);
+}
+
+static void format_frame(const cs_event_t* start, const cs_event_t* end, char* json_buffer, size_t json_buffer_size) {
+    char* ptr = json_buffer;
+    size_t remaining = json_buffer_size;
+    char field[96];
+
+    uint32_t len = end->position[SNIFF_MOSI] - start->position[SNIFF_MOSI];
+    uint32_t miso_len = end->position[SNIFF_MISO] - start->position[SNIFF_MISO];
+    uint32_t shown = (len > SPI_SNIFFER_MAX_FRAME_BYTES) ? SPI_SNIFFER_MAX_FRAME_BYTES : len;
+    uint32_t miso_shown = (miso_len > SPI_SNIFFER_MAX_FRAME_BYTES) ? SPI_SNIFFER_MAX_FRAME_BYTES : miso_len;
+
+    snprintf(field, sizeof(field), "{\"spi_sniff\":{\"t_start\":%lu,\"t_end\":%lu,\"len\":%lu",
+             (unsigned long)start->timestamp, (unsigned long)end->timestamp, (unsigned long)len);
+    json_text_append(&ptr, &remaining, field);
+
+    char* data_start = ptr;
+    size_t data_remaining = remaining;
+    json_text_append(&ptr, &remaining, ",\"mosi\":\"");
+    dma_ring_append_hex(&s_lines[SNIFF_MOSI].ring, start->position[SNIFF_MOSI], shown, &ptr, &remaining);
+    json_text_append(&ptr, &remaining, "\",\"miso\":\"");
+    dma_ring_append_hex(&s_lines[SNIFF_MISO].ring, start->position[SNIFF_MISO], miso_shown, &ptr, &remaining);
+    json_text_append(&ptr, &remaining, "\"");
+
+    // The DMA keeps writing while the bytes are formatted; if either ring
+    // has since lapped the frame start, the copied data cannot be trusted
+    if (dma_ring_is_overwritten(&s_lines[SNIFF_MOSI].ring, start->position[SNIFF_MOSI]) ||
+        dma_ring_is_overwritten(&s_lines[SNIFF_MISO].ring, start->position[SNIFF_MISO])) {
+        ptr = data_start;
+        remaining = data_remaining;
+        json_text_append(&ptr, &remaining, ",\"overrun\":true");
+    } else if (shown < len || miso_shown < miso_len) {
+        json_text_append(&ptr, &remaining, ",\"truncated\":true");
+    }
+
+    if (s_events_dropped > 0) {
+        taskENTER_CRITICAL();
+        uint32_t dropped = s_events_dropped;
+        s_events_dropped = 0;
+        taskEXIT_CRITICAL();
+        snprintf(field, sizeof(field), ",\"dropped_edges\":%lu", (unsigned long)dropped);
+        json_text_append(&ptr, &remaining, field);
+    }
+
+    json_text_append(&ptr, &remaining, "}}");
+}
+
+// --- Public API Function Implementations ---
+
+int spi_sniffer_start(spi_clock_polarity_t cpol, spi_clock_phase_t cpha, spi_bit_order_t bit_order) {
+    if (s_running || capture_arena_get_segment_count() < SNIFF_LINE_COUNT) {
+        return -1;
+    }
+
+    uint32_t segment_bytes = capture_arena_get_segment_samples() * sizeof(capture_sample_t);
+    uint32_t ring_bytes = dma_ring_fit_length(segment_bytes, SPI_SNIFFER_MAX_RING_BYTES);
+    if (ring_bytes < SPI_SNIFFER_MIN_RING_BYTES) {
+        return -1;
+    }
+    s_ring_bytes = ring_bytes;
+
+    s_event_head = 0;
+    s_event_tail = 0;
+    s_events_dropped = 0;
+    s_in_frame = false;
+    capture_timebase_init();
+
+    const gpio_config_t pin_cfg = {
+        .mode = GPIO_MODE_ALTERNATE_FUNCTION,
+        .pull = GPIO_PULL_NONE,
+        .output_type = GPIO_OUTPUT_TYPE_PUSH_PULL,
+        .speed = GPIO_SPEED_VERY_HIGH,
+        .alternate_function = GPIO_AF_SPI1_SPI2,
+    };
+    s_cs_pin = gpio_init(SNIFF_CS_PORT, (1 << SNIFF_CS_PIN), &pin_cfg);
+    s_bus_pins[SNIFF_MOSI] = gpio_init(GPIO_PORT_A, (1 << 5) | (1 << 7), &pin_cfg);
+    s_bus_pins[SNIFF_MISO] = gpio_init(GPIO_PORT_B, (1 << 12) | (1 << 13) | (1 << 15), &pin_cfg);
+
+    const spi_config_t spi_cfg = {
+        .baud_rate_prescaler = SPI_BAUD_RATE_DIV_2,
+        .clock_polarity = cpol,
+        .clock_phase = cpha,
+        .bit_order = bit_order,
+        .mode = SPI_MODE_SLAVE_RX_ONLY,
+    };
+
+    int status = start_line(&s_lines[SNIFF_MOSI], (uint8_t*)capture_arena_get_segment(0), SNIFF_MOSI_SPI_NUM,
+                            SNIFF_MOSI_DMA_NUM, SNIFF_MOSI_STREAM_NUM, SNIFF_MOSI_CHANNEL, SNIFF_MOSI_IRQN, &spi_cfg);
+    if (status == 0) {
+        status = start_line(&s_lines[SNIFF_MISO], (uint8_t*)capture_arena_get_segment(1), SNIFF_MISO_SPI_NUM,
+                            SNIFF_MISO_DMA_NUM, SNIFF_MISO_STREAM_NUM, SNIFF_MISO_CHANNEL, SNIFF_MISO_IRQN, &spi_cfg);
+    }
+
+    // CS stays on its SPI alternate function; EXTI still sees the pin level
+    const exti_config_t cs_cfg = {
+        .trigger = EXTI_TRIGGER_BOTH,
+        .callback = cs_edge_callback,
+        .user_data = NULL,
+    };
+    if (status == 0) {
+        // Same priority as the ring ISRs, so neither preempts the other
+        nvic_set_priority(SNIFF_CS_IRQN, SPI_SNIFFER_IRQ_PRIORITY);
+        s_cs_exti = exti_init(SNIFF_CS_PORT, SNIFF_CS_PIN, &cs_cfg);
+        if (s_cs_exti == NULL) {
+            status = -2;
+        }
+    }
+
+    s_running = true;
+    if (status != 0) {
+        spi_sniffer_stop();
+    }
+    return status;
+}
+
+void spi_sniffer_stop(void) {
+    if (!s_running) {
+        return;
+    }
+
+    exti_deinit(&s_cs_exti);
+    stop_line(&s_lines[SNIFF_MOSI], SNIFF_MOSI_IRQN);
+    stop_line(&s_lines[SNIFF_MISO], SNIFF_MISO_IRQN);
+
+    gpio_deinit(&s_cs_pin);
+    gpio_deinit(&s_bus_pins[SNIFF_MOSI]);
+    gpio_deinit(&s_bus_pins[SNIFF_MISO]);
+
+    s_ring_bytes = 0;
+    s_running = false;
+}
+
+bool spi_sniffer_poll(char* json_buffer, size_t json_buffer_size) {
+    if (!s_running) {
+        return false;
+    }
+
+    while (s_event_tail != s_event_head) {
+        cs_event_t event = s_events[s_event_tail];
+        s_event_tail = (s_event_tail + 1) % SPI_SNIFFER_EVENT_QUEUE_LENGTH;
+
+        if (!event.released) {
+            s_frame_start = event;
+            s_in_frame = true;
+            continue;
+        }
+
+        // A release without a start means the capture began mid-frame
+        if (s_in_frame) {
+            s_in_frame = false;
+            format_frame(&s_frame_start, &event, json_buffer, json_buffer_size);
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t spi_sniffer_get_ring_bytes(void) {
+    return s_ring_bytes;
+}
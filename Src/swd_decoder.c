@@ -0,0 +1,330 @@
+/**
+ * @file      swd_decoder.c
+ * @brief     Serial Wire Debug transaction decoder fed from the edge stream.
+ */
+
+#include <stdio.h>
+
+#include "swd_decoder.h"
+#include "capture_timebase.h"
+
+#define LINE_RESET_BITS         50U
+#define REQUEST_BITS            8U
+#define IDLE_END_MS             100U    // SWCLK stopped this long ends the folded run
+
+// Request bits, LSB first on the wire
+#define REQUEST_START           (1U << 0)
+#define REQUEST_APNDP           (1U << 1)
+#define REQUEST_RNW             (1U << 2)
+#define REQUEST_ADDR_SHIFT      3U      // A[3:2]
+#define REQUEST_PARITY          (1U << 5)
+#define REQUEST_STOP            (1U << 6)
+#define REQUEST_PARK            (1U << 7)
+
+#define ACK_OK                  0x1U
+#define ACK_WAIT                0x2U
+#define ACK_FAULT               0x4U
+
+// Bit positions after the request
+#define PHASE_ACK_LAST          3U      // Turnaround, then ACK bits 1-3
+#define PHASE_READ_PARITY       36U     // Read data 4-35, parity
+#define PHASE_WRITE_PARITY      37U     // Turnaround 4, write data 5-36, parity
+
+#define KIND_RESET              0xFFFFU // Transaction kind of a line reset; requests use their request byte
+
+typedef enum {
+    SWD_STATE_HUNT,         // Looking for a request
+    SWD_STATE_TRANSFER,     // Turnaround, ACK and data after a request
+} swd_state_t;
+
+typedef struct {
+    uint16_t kind;
+    uint8_t ack;
+    bool parity_ok;
+    uint32_t data;
+    uint32_t time;
+    uint32_t last_time;
+    uint32_t count;
+} swd_transaction_t;
+
+// --- Static Data ---
+static swd_decoder_config_t s_config = { .clock_channel = 0, .data_channel = 1 };
+
+static uint8_t s_clock_level = 0;
+static uint8_t s_data_level = 0;
+static uint32_t s_last_clock = 0;
+
+static swd_state_t s_state = SWD_STATE_HUNT;
+static uint8_t s_window = 0;            // Last 8 bits while hunting, oldest in bit 0
+static uint8_t s_window_bits = 0;
+static uint32_t s_window_times[REQUEST_BITS];
+static uint32_t s_high_run = 0;         // Consecutive bits with SWDIO high
+static uint32_t s_high_start = 0;
+
+static uint8_t s_phase_bit = 0;
+static uint8_t s_ack = 0;
+static uint32_t s_data = 0;
+static uint8_t s_data_parity = 0;
+static swd_transaction_t s_current;
+static swd_transaction_t s_pending;     // Folded repeats awaiting a different transaction
+static bool s_has_pending = false;
+
+static char* s_out = NULL;              // Buffer of the feed call in progress
+static size_t s_out_size = 0;
+static bool s_written = false;
+
+// --- Private Helper Functions ---
+
+static uint8_t parity_of(uint32_t value) {
+    value ^= value >> 16;
+    value ^= value >> 8;
+    value ^= value >> 4;
+    value ^= value >> 2;
+    value ^= value >> 1;
+    return (uint8_t)(value & 1U);
+}
+
+static bool is_request(uint8_t bits) {
+    return (bits & REQUEST_START) && !(bits & REQUEST_STOP) && (bits & REQUEST_PARK) &&
+           parity_of(bits & 0x1EU) == ((bits & REQUEST_PARITY) ? 1U : 0U);
+}
+
+static const char* ack_name(uint8_t ack) {
+    switch (ack) {
+        case ACK_OK:
+            return "ok";
+        case ACK_WAIT:
+            return "wait";
+        case ACK_FAULT:
+            return "fault";
+        default:
+            return "none";
+    }
+}
+
+static void report_pending(void) {
+    if (s_written) {
+        return;
+    }
+
+    char* ptr = s_out;
+    size_t remaining = s_out_size;
+    int written;
+    if (s_pending.kind == KIND_RESET) {
+        written = snprintf(ptr, remaining, "{\"swd\":{\"t\":%lu,\"n\":%lu,\"op\":\"reset\"",
+                           (unsigned long)s_pending.time, (unsigned long)s_pending.count);
+    } else {
+        uint8_t request = (uint8_t)s_pending.kind;
+        written = snprintf(ptr, remaining, "{\"swd\":{\"t\":%lu,\"n\":%lu,\"op\":\"%s\",\"port\":\"%s\",\"addr\":%u,\"ack\":\"%s\"",
+                           (unsigned long)s_pending.time, (unsigned long)s_pending.count,
+                           (request & REQUEST_RNW) ? "rd" : "wr", (request & REQUEST_APNDP) ? "ap" : "dp",
+                           ((request >> REQUEST_ADDR_SHIFT) & 0x3U) << 2, ack_name(s_pending.ack));
+        if (written > 0 && (size_t)written < remaining && s_pending.ack == ACK_OK) {
+            ptr += written;
+            remaining -= written;
+            written = snprintf(ptr, remaining, ",\"data\":%lu,\"parity\":%u",
+                               (unsigned long)s_pending.data, s_pending.parity_ok);
+        }
+    }
+    if (written > 0 && (size_t)written < remaining && s_pending.count > 1) {
+        ptr += written;
+        remaining -= written;
+        written = snprintf(ptr, remaining, ",\"t_last\":%lu", (unsigned long)s_pending.last_time);
+    }
+    if (written > 0 && (size_t)written < remaining) {
+        snprintf(ptr + written, remaining - written, "}}");
+    }
+    s_written = true;
+}
+
+/**
+ * @brief Folds a finished transaction into the pending one, or reports that and replaces it.
+ */
+static void finish_transaction(const swd_transaction_t* transaction) {
+    if (s_has_pending && s_pending.kind == transaction->kind && s_pending.ack == transaction->ack &&
+        s_pending.data == transaction->data && s_pending.parity_ok == transaction->parity_ok) {
+        s_pending.count++;
+        s_pending.last_time = transaction->time;
+        return;
+    }
+
+    if (s_has_pending) {
+        report_pending();
+    }
+    s_pending = *transaction;
+    s_pending.last_time = transaction->time;
+    s_pending.count = 1;
+    s_has_pending = true;
+}
+
+static void hunt(void) {
+    s_state = SWD_STATE_HUNT;
+    s_window = 0;
+    s_window_bits = 0;
+}
+
+static void start_transfer(uint8_t request, uint32_t time) {
+    s_state = SWD_STATE_TRANSFER;
+    s_phase_bit = 0;
+    s_ack = 0;
+    s_data = 0;
+    s_current.kind = request;
+    s_current.time = time;
+    s_current.ack = 0;
+    s_current.data = 0;
+    s_current.parity_ok = true;
+}
+
+static void end_transfer(void) {
+    s_current.ack = s_ack;
+    finish_transaction(&s_current);
+    hunt();
+}
+
+static void transfer_bit(uint8_t bit) {
+    uint8_t index = s_phase_bit++;
+    bool read = (s_current.kind & REQUEST_RNW) != 0;
+
+    if (index >= 1 && index <= PHASE_ACK_LAST) {
+        s_ack |= (uint8_t)(bit << (index - 1U));
+        if (index == PHASE_ACK_LAST && s_ack != ACK_OK) {
+            end_transfer();
+        }
+        return;
+    }
+
+    uint8_t first = read ? PHASE_ACK_LAST + 1U : PHASE_ACK_LAST + 2U;
+    uint8_t parity = read ? PHASE_READ_PARITY : PHASE_WRITE_PARITY;
+    if (index >= first && index < parity) {
+        s_data |= (uint32_t)bit << (index - first);
+    } else if (index == parity) {
+        s_current.data = s_data;
+        s_current.parity_ok = parity_of(s_data) == bit;
+        end_transfer();
+    }
+}
+
+static void take_bit(uint8_t bit, uint32_t time) {
+    // 50 clocks with SWDIO high reset the line from any state
+    if (bit) {
+        if (s_high_run++ == 0) {
+            s_high_start = time;
+        }
+        if (s_high_run == LINE_RESET_BITS) {
+            hunt();
+        }
+        if (s_high_run >= LINE_RESET_BITS) {
+            return;
+        }
+    } else {
+        if (s_high_run >= LINE_RESET_BITS) {
+            const swd_transaction_t reset = { .kind = KIND_RESET, .time = s_high_start };
+            finish_transaction(&reset);
+        }
+        s_high_run = 0;
+    }
+
+    if (s_state == SWD_STATE_TRANSFER) {
+        transfer_bit(bit);
+        return;
+    }
+
+    s_window = (uint8_t)((s_window >> 1) | (bit << 7));
+    s_window_times[s_window_bits % REQUEST_BITS] = time;
+    s_window_bits++;
+    if (s_window_bits >= REQUEST_BITS && is_request(s_window)) {
+        // The start bit is the oldest of the last eight
+        start_transfer(s_window, s_window_times[s_window_bits % REQUEST_BITS]);
+    }
+}
+
+// --- Decoder Interface ---
+
+static void swd_reset(void) {
+    hunt();
+    s_high_run = 0;
+    s_has_pending = false;
+}
+
+static bool swd_feed(const edge_t* edge, char* json_buffer, size_t json_buffer_size) {
+    uint8_t level = edge->level ? 1U : 0U;
+
+    if (edge->channel == s_config.data_channel) {
+        if (edge->flags & EDGE_FLAG_SYNC) {
+            hunt();
+        }
+        s_data_level = level;
+        return false;
+    }
+    if (edge->channel != s_config.clock_channel) {
+        return false;
+    }
+
+    if (edge->flags & EDGE_FLAG_SYNC) {
+        // Clocks were lost: find the next request afresh
+        hunt();
+        s_high_run = 0;
+        s_clock_level = level;
+        s_last_clock = edge->time;
+        return false;
+    }
+    if (level == s_clock_level) {
+        return false;
+    }
+    s_clock_level = level;
+    if (!level) {
+        return false;
+    }
+
+    s_out = json_buffer;
+    s_out_size = json_buffer_size;
+    s_written = false;
+    s_last_clock = edge->time;
+    take_bit(s_data_level, edge->time);
+    return s_written;
+}
+
+static bool swd_flush(uint32_t now, bool final, char* json_buffer, size_t json_buffer_size) {
+    // A run is only folded while the debugger keeps clocking
+    if (!final && now - s_last_clock < (CAPTURE_TIMEBASE_HZ / 1000U) * IDLE_END_MS) {
+        return false;
+    }
+
+    s_out = json_buffer;
+    s_out_size = json_buffer_size;
+    s_written = false;
+    if (s_high_run >= LINE_RESET_BITS) {
+        // A line reset is otherwise only closed by the next low bit
+        const swd_transaction_t reset = { .kind = KIND_RESET, .time = s_high_start };
+        s_high_run = 0;
+        finish_transaction(&reset);
+        if (s_written) {
+            return true;
+        }
+    }
+    if (s_has_pending) {
+        report_pending();
+        s_has_pending = false;
+    }
+    return s_written;
+}
+
+const edge_decoder_t swd_decoder = {
+    .name = "swd",
+    .reset = swd_reset,
+    .feed = swd_feed,
+    .flush = swd_flush,
+};
+
+// --- Public API Function Implementations ---
+
+int swd_decoder_configure(const swd_decoder_config_t* config) {
+    // Invalid arguments
+    if (config == NULL || config->clock_channel == config->data_channel) {
+        return -1;
+    }
+
+    s_config = *config;
+    swd_reset();
+    return 0;
+}
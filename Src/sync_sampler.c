@@ -0,0 +1,163 @@
+/**
+ * @file      sync_sampler.c
+ * @brief     Synchronous (state) sampling of GPIOB on the edges of an external clock.
+ */
+
+#include "sync_sampler.h"
+#include "capture_arena.h"
+#include "nvic.h"
+#include "dma.h"
+#include "gpio.h"
+#include "timer.h"
+
+#define GPIO_PORT_B             1
+#define GPIO_PORT_E             4
+#define GPIO_AF_TIM1            1
+#define CLOCK_PIN               7       // PE7 = TIM1_ETR
+#define DATA_PIN_MASK           0x00FFU // PB0..PB7
+#define SYNC_TIMER_NUM          1
+
+// TIM1_TRIG on DMA2 Stream4 Ch6
+#define SYNC_DMA_NUM            2
+#define SYNC_STREAM_NUM         4
+#define SYNC_CHANNEL            6
+#define SYNC_IRQN               60      // DMA2_Stream4_IRQn
+
+// --- Static Data ---
+static timer_handle_t s_timer = NULL;
+static gpio_handle_t s_clock_pin = NULL;
+static gpio_handle_t s_data_pins = NULL;
+static dma_handle_t s_dma = NULL;
+static sync_sampler_segment_callback_t s_on_segment = NULL;
+static volatile uint8_t s_filling = 0;  // Arena segment the DMA is currently writing
+static bool s_running = false;
+
+// --- Private Helper Functions ---
+
+/**
+ * @brief Stops the sample requests without releasing anything.
+ */
+static void halt_sampling(void) {
+    timer_set_trigger_dma_request(s_timer, false);
+    timer_stop(s_timer);
+    dma_stop_transfer(s_dma);
+}
+
+static void segment_callback(dma_handle_t dma, void* user_data) {
+    (void)user_data;
+
+    if (!dma_is_interrupt_flag_set(dma, DMA_INTERRUPT_TRANSFER_COMPLETE)) {
+        return;
+    }
+    dma_clear_interrupt_flag(dma, DMA_INTERRUPT_TRANSFER_COMPLETE);
+
+    uint8_t completed = s_filling;
+    uint8_t count = capture_arena_get_segment_count();
+
+    if (completed + 1U >= count) {
+        halt_sampling();
+    } else {
+        // The stream has already switched to segment completed + 1; refill
+        // the target it just left. Past the end, park it on segment 0, which
+        // only catches the few samples taken before the final stop.
+        uint8_t next = completed + 2U;
+        dma_set_next_buffer(dma, capture_arena_get_segment(next < count ? next : 0));
+        s_filling = completed + 1U;
+    }
+    s_on_segment(completed);
+}
+
+// --- Public API Function Implementations ---
+
+int sync_sampler_start(bool falling_edge, uint8_t filter, sync_sampler_segment_callback_t on_segment) {
+    // A run that filled the arena still holds its peripherals
+    sync_sampler_stop();
+
+    if (filter > 15 || on_segment == NULL ||
+        capture_arena_get_segment_count() < CAPTURE_ARENA_MIN_SEGMENTS) {
+        return -1;
+    }
+
+    // The counter itself is unused; it only needs a non-zero period to run
+    const timer_config_t tim_cfg = {
+        .prescaler = 0,
+        .period = 0xFFFFU,
+    };
+    const timer_clock_config_t clock_cfg = {
+        .source = TIMER_CLOCK_ETR,
+        .polarity = falling_edge ? TIMER_IC_POLARITY_FALLING : TIMER_IC_POLARITY_RISING,
+        .filter = filter,
+    };
+    const gpio_config_t clock_pin_cfg = {
+        .mode = GPIO_MODE_ALTERNATE_FUNCTION,
+        .pull = GPIO_PULL_NONE,
+        .output_type = GPIO_OUTPUT_TYPE_PUSH_PULL,
+        .speed = GPIO_SPEED_VERY_HIGH,
+        .alternate_function = GPIO_AF_TIM1,
+    };
+    const gpio_config_t data_pin_cfg = {
+        .mode = GPIO_MODE_INPUT,
+        .pull = GPIO_PULL_NONE,
+        .output_type = GPIO_OUTPUT_TYPE_PUSH_PULL,
+        .speed = GPIO_SPEED_VERY_HIGH,
+        .alternate_function = 0,
+    };
+    const dma_config_t dma_cfg = {
+        .channel = SYNC_CHANNEL,
+        .direction = DMA_DIRECTION_PERIPHERAL_TO_MEMORY,
+        .priority = DMA_PRIORITY_VERY_HIGH,
+        .peripheral_data_size = DMA_DATA_SIZE_16_BIT,
+        .memory_data_size = DMA_DATA_SIZE_16_BIT,
+        .peripheral_increment = false,
+        .memory_increment = true,
+        .circular_mode = true,
+        .fifo_mode = false,
+        .fifo_threshold = DMA_FIFO_THRESHOLD_1_4,
+        .memory_burst = DMA_BURST_SINGLE,
+        .peripheral_burst = DMA_BURST_SINGLE,
+    };
+
+    s_running = true;
+    s_on_segment = on_segment;
+    s_filling = 0;
+    s_clock_pin = gpio_init(GPIO_PORT_E, (1 << CLOCK_PIN), &clock_pin_cfg);
+    s_data_pins = gpio_init(GPIO_PORT_B, DATA_PIN_MASK, &data_pin_cfg);
+    s_timer = timer_init(SYNC_TIMER_NUM, &tim_cfg);
+    s_dma = dma_init(SYNC_DMA_NUM, SYNC_STREAM_NUM, &dma_cfg);
+    if (s_clock_pin == NULL || s_data_pins == NULL || s_timer == NULL || s_dma == NULL) {
+        sync_sampler_stop();
+        return -2;
+    }
+
+    dma_set_callback(s_dma, segment_callback, NULL);
+    dma_enable_interrupt(s_dma, DMA_INTERRUPT_TRANSFER_COMPLETE);
+    nvic_set_priority(SYNC_IRQN, SYNC_SAMPLER_IRQ_PRIORITY);
+    nvic_enable_irq(SYNC_IRQN);
+
+    // Arm the stream before the first clock edge can raise a request
+    dma_start_double_buffer(s_dma, gpio_get_input_register(s_data_pins),
+                            capture_arena_get_segment(0), capture_arena_get_segment(1),
+                            (uint16_t)capture_arena_get_segment_samples());
+    timer_set_clock_source(s_timer, &clock_cfg);
+    timer_set_trigger_dma_request(s_timer, true);
+    timer_start(s_timer);
+    return 0;
+}
+
+void sync_sampler_stop(void) {
+    if (!s_running) {
+        return;
+    }
+
+    nvic_disable_irq(SYNC_IRQN);
+    if (s_timer && s_dma) {
+        halt_sampling();
+    }
+    dma_deinit(&s_dma);
+    timer_deinit(&s_timer);
+    gpio_deinit(&s_data_pins);
+    gpio_deinit(&s_clock_pin);
+
+    s_on_segment = NULL;
+    s_running = false;
+}
@@ -35,15 +35,17 @@ static uint8_t *__sbrk_heap_end = NULL;
  *
  * @verbatim
  * ############################################################################
- * #  .data  #  .bss  #       newlib heap       #          MSP stack          #
- * #         #        #                         # Reserved by _Min_Stack_Size #
+ * #  .data  #  .bss  # newlib heap #    capture arena    #      MSP stack      #
+ * #         #        #             #                     # _Min_Stack_Size     #
  * ############################################################################
- * ^-- RAM start      ^-- _end                             _estack, RAM end --^
+ * ^-- RAM start      ^-- _end      ^-- _eheap            _estack, RAM end --^
+ *                                     = _scapture_arena
  * @endverbatim
  *
  * This implementation starts allocating at the '_end' linker symbol
- * The '_Min_Stack_Size' linker symbol reserves a memory for the MSP stack
- * The implementation considers '_estack' linker symbol to be RAM end
+ * The heap is the '_Min_Heap_Size' bytes reserved up to the '_eheap' linker
+ * symbol; everything above it up to the MSP stack is handed to the capture
+ * arena (see capture_arena.c)
  * NOTE: If the MSP stack, at any point during execution, grows larger than the
  * reserved size, please increase the '_Min_Stack_Size'.
  *
@@ -53,10 +55,8 @@ static uint8_t *__sbrk_heap_end = NULL;
 void *_sbrk(ptrdiff_t incr)
 {
   extern uint8_t _end; /* Symbol defined in the linker script */
-  extern uint8_t _estack; /* Symbol defined in the linker script */
-  extern uint32_t _Min_Stack_Size; /* Symbol defined in the linker script */
-  const uint32_t stack_limit = (uint32_t)&_estack - (uint32_t)&_Min_Stack_Size;
-  const uint8_t *max_heap = (uint8_t *)stack_limit;
+  extern uint8_t _eheap; /* Symbol defined in the linker script */
+  const uint8_t *max_heap = &_eheap;
   uint8_t *prev_heap_end;
 
   /* Initialize heap end at first call */
@@ -65,7 +65,7 @@ void *_sbrk(ptrdiff_t incr)
     __sbrk_heap_end = &_end;
   }
 
-  /* Protect heap from growing into the reserved MSP stack */
+  /* Protect heap from growing into the capture arena */
   if (__sbrk_heap_end + incr > max_heap)
   {
     errno = ENOMEM;
@@ -0,0 +1,341 @@
+/**
+ * @file      timer_capture.c
+ * @brief     Edge timestamping on up to four pins using timer input capture and DMA.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "timer_capture.h"
+#include "analog_capture.h"
+#include "capture_arena.h"
+#include "capture_timebase.h"
+#include "dma_ring.h"
+#include "nvic.h"
+#include "dma.h"
+#include "gpio.h"
+#include "timer.h"
+
+#define GPIO_PORT_A             0
+#define GPIO_AF_TIM5            2
+#define CAPTURE_TIMER_NUM       5
+
+// Capture timebase ticks per timer count (core clock / APB1 timer clock)
+#define TICKS_PER_COUNT         (CAPTURE_TIMEBASE_HZ / TIMER_CAPTURE_TIMER_HZ)
+
+/** @brief Fixed hardware resources of one capture channel. */
+typedef struct {
+    uint8_t pin;
+    uint8_t stream_num;
+    uint8_t irqn;
+} channel_hw_t;
+
+// TIM5_CHx requests are all on DMA1 channel 6
+#define CAPTURE_DMA_NUM         1
+#define CAPTURE_DMA_CHANNEL     6
+
+static const channel_hw_t s_channel_hw[TIMER_CAPTURE_CHANNELS] = {
+    { .pin = 0, .stream_num = 2, .irqn = 13 },  // TIM5_CH1, DMA1_Stream2_IRQn
+    { .pin = 1, .stream_num = 4, .irqn = 15 },  // TIM5_CH2, DMA1_Stream4_IRQn
+    { .pin = 2, .stream_num = 0, .irqn = 11 },  // TIM5_CH3, DMA1_Stream0_IRQn
+    { .pin = 3, .stream_num = 1, .irqn = 12 },  // TIM5_CH4, DMA1_Stream1_IRQn
+};
+
+typedef struct {
+    gpio_handle_t pin;
+    dma_ring_t ring;
+    uint32_t read_pos;      // Next capture to merge
+    uint8_t level;          // Level after the last merged edge
+    bool sync_pending;      // A level marker is due at sync_time
+    uint32_t sync_time;
+    uint8_t sync_level;
+} capture_channel_t;
+
+// --- Static Data ---
+static capture_channel_t s_channels[TIMER_CAPTURE_CHANNELS];
+static uint8_t s_channel_mask = 0;
+static timer_handle_t s_timer = NULL;
+static uint32_t s_ring_words = 0;
+static uint32_t s_time_offset = 0;  // Capture timebase ticks at timer count 0
+static bool s_running = false;
+static uint32_t s_horizon = 0;      // Time before which every edge has been merged
+
+// --- Private Helper Functions ---
+
+static void ring_callback(dma_handle_t dma, void* user_data) {
+    (void)dma;
+    dma_ring_handle_wrap((dma_ring_t*)user_data);
+}
+
+static uint32_t count_to_time(uint32_t count) {
+    return s_time_offset + count * TICKS_PER_COUNT;
+}
+
+static bool is_older(uint32_t time, uint32_t reference) {
+    return (int32_t)(time - reference) < 0;
+}
+
+/**
+ * @brief Gets the oldest unmerged record of a channel, if any is before the horizon.
+ * @details Edges a pending level marker makes obsolete are skipped here.
+ */
+static bool next_record_time(capture_channel_t* ch, uint32_t available, uint32_t horizon, uint32_t* time) {
+    if (ch->sync_pending) {
+        while (ch->read_pos != available &&
+               is_older(count_to_time(dma_ring_word_at(&ch->ring, ch->read_pos)), ch->sync_time)) {
+            ch->read_pos++;
+        }
+        *time = ch->sync_time;
+    } else if (ch->read_pos != available) {
+        *time = count_to_time(dma_ring_word_at(&ch->ring, ch->read_pos));
+    } else {
+        return false;
+    }
+    return is_older(*time, horizon);
+}
+
+/**
+ * @brief Merges every edge older than the guard horizon onto the edge stream.
+ * @return true if any record was queued.
+ */
+static bool merge_pending(void) {
+    uint32_t available[TIMER_CAPTURE_CHANNELS] = {0};
+    uint32_t start_pos[TIMER_CAPTURE_CHANNELS] = {0};
+
+    taskENTER_CRITICAL();
+    uint32_t now = count_to_time(timer_get_counter(s_timer));
+    uint32_t lost = timer_get_and_clear_overcapture(s_timer);
+    for (uint8_t i = 0; i < TIMER_CAPTURE_CHANNELS; ++i) {
+        capture_channel_t* ch = &s_channels[i];
+        if (!(s_channel_mask & (1U << i))) {
+            continue;
+        }
+        available[i] = dma_ring_position(&ch->ring);
+
+        // A lost capture or a lapped ring breaks the level tracking: restart
+        // the channel from its current pin level
+        if ((lost & (1U << i)) || (available[i] - ch->read_pos) > ch->ring.length) {
+            if ((available[i] - ch->read_pos) > ch->ring.length) {
+                ch->read_pos = available[i] - ch->ring.length / 2U;
+            }
+            ch->sync_pending = true;
+            ch->sync_time = now;
+            ch->sync_level = gpio_read(ch->pin) ? 1U : 0U;
+        }
+        start_pos[i] = ch->read_pos;
+    }
+    taskEXIT_CRITICAL();
+
+    uint32_t horizon = now - TIMER_CAPTURE_GUARD_TICKS;
+    bool progress = false;
+    s_horizon = horizon;
+
+    while (edge_stream_free() > 0) {
+        int8_t oldest = -1;
+        uint32_t oldest_time = 0;
+        for (uint8_t i = 0; i < TIMER_CAPTURE_CHANNELS; ++i) {
+            uint32_t time;
+            if ((s_channel_mask & (1U << i)) &&
+                next_record_time(&s_channels[i], available[i], horizon, &time) &&
+                (oldest < 0 || is_older(time, oldest_time))) {
+                oldest = (int8_t)i;
+                oldest_time = time;
+            }
+        }
+
+        // An analog scan is one more candidate; wait for it if it is still converting
+        uint32_t analog_time;
+        if (analog_capture_next_time(&analog_time) && is_older(analog_time, horizon) &&
+            (oldest < 0 || is_older(analog_time, oldest_time))) {
+            if (!analog_capture_push_next()) {
+                break;
+            }
+            progress = true;
+            continue;
+        }
+        if (oldest < 0) {
+            break;
+        }
+
+        capture_channel_t* ch = &s_channels[oldest];
+        if (ch->sync_pending) {
+            ch->sync_pending = false;
+            ch->level = ch->sync_level;
+            edge_stream_push(oldest_time, (uint8_t)oldest, ch->level, EDGE_FLAG_SYNC);
+        } else {
+            ch->read_pos++;
+            ch->level ^= 1U;
+            edge_stream_push(oldest_time, (uint8_t)oldest, ch->level, 0);
+        }
+        progress = true;
+    }
+
+    // Captures read while the DMA lapped the ring cannot be trusted
+    for (uint8_t i = 0; i < TIMER_CAPTURE_CHANNELS; ++i) {
+        capture_channel_t* ch = &s_channels[i];
+        if ((s_channel_mask & (1U << i)) && !ch->sync_pending &&
+            dma_ring_is_overwritten(&ch->ring, start_pos[i])) {
+            taskENTER_CRITICAL();
+            ch->read_pos = dma_ring_position(&ch->ring);
+            ch->sync_time = count_to_time(timer_get_counter(s_timer));
+            ch->sync_level = gpio_read(ch->pin) ? 1U : 0U;
+            taskEXIT_CRITICAL();
+            ch->sync_pending = true;
+        }
+    }
+    return progress;
+}
+
+static int start_channel(uint8_t index, uint32_t* buffer, const timer_ic_config_t* ic_cfg) {
+    const channel_hw_t* hw = &s_channel_hw[index];
+    capture_channel_t* ch = &s_channels[index];
+
+    const gpio_config_t pin_cfg = {
+        .mode = GPIO_MODE_ALTERNATE_FUNCTION,
+        .pull = GPIO_PULL_NONE,
+        .output_type = GPIO_OUTPUT_TYPE_PUSH_PULL,
+        .speed = GPIO_SPEED_HIGH,
+        .alternate_function = GPIO_AF_TIM5,
+    };
+    const dma_config_t dma_cfg = {
+        .channel = CAPTURE_DMA_CHANNEL,
+        .direction = DMA_DIRECTION_PERIPHERAL_TO_MEMORY,
+        .priority = DMA_PRIORITY_HIGH,
+        .peripheral_data_size = DMA_DATA_SIZE_32_BIT,
+        .memory_data_size = DMA_DATA_SIZE_32_BIT,
+        .peripheral_increment = false,
+        .memory_increment = true,
+        .circular_mode = true,
+        .fifo_mode = false,
+        .fifo_threshold = DMA_FIFO_THRESHOLD_1_4,
+        .memory_burst = DMA_BURST_SINGLE,
+        .peripheral_burst = DMA_BURST_SINGLE,
+    };
+
+    ch->read_pos = 0;
+    ch->sync_pending = false;
+    ch->pin = gpio_init(GPIO_PORT_A, (1 << hw->pin), &pin_cfg);
+    dma_handle_t dma = dma_init(CAPTURE_DMA_NUM, hw->stream_num, &dma_cfg);
+    ch->ring.dma = dma;
+    if (ch->pin == NULL || dma == NULL) {
+        return -2;
+    }
+
+    dma_set_callback(dma, ring_callback, &ch->ring);
+    nvic_set_priority(hw->irqn, TIMER_CAPTURE_IRQ_PRIORITY);
+    nvic_enable_irq(hw->irqn);
+
+    dma_ring_start(&ch->ring, dma, timer_get_capture_register(s_timer, index + 1U), (uint8_t*)buffer, s_ring_words);
+    timer_configure_input_capture(s_timer, index + 1U, ic_cfg);
+    timer_set_capture_dma_request(s_timer, index + 1U, true);
+    return 0;
+}
+
+static void stop_channel(uint8_t index) {
+    capture_channel_t* ch = &s_channels[index];
+
+    nvic_disable_irq(s_channel_hw[index].irqn);
+    if (s_timer) {
+        timer_set_capture_dma_request(s_timer, index + 1U, false);
+        timer_disable_input_capture(s_timer, index + 1U);
+    }
+    dma_deinit(&ch->ring.dma);
+    gpio_deinit(&ch->pin);
+}
+
+// --- Public API Function Implementations ---
+
+int timer_capture_start(uint8_t channel_mask, uint8_t filter, const edge_decoder_t* decoder) {
+    if (s_running || channel_mask == 0 || channel_mask >= (1U << TIMER_CAPTURE_CHANNELS) || filter > 15 ||
+        capture_arena_get_segment_count() < 1) {
+        return -1;
+    }
+
+    uint32_t segment_words = capture_arena_get_segment_samples() * sizeof(capture_sample_t) / sizeof(uint32_t);
+    uint32_t ring_words = dma_ring_fit_length(segment_words / TIMER_CAPTURE_CHANNELS, TIMER_CAPTURE_MAX_RING_WORDS);
+    if (ring_words < TIMER_CAPTURE_MIN_RING_WORDS) {
+        return -1;
+    }
+    s_ring_words = ring_words;
+
+    edge_stream_reset(decoder);
+    capture_timebase_init();
+
+    // Free-running 32-bit counter at the full timer clock
+    const timer_config_t tim_cfg = {
+        .prescaler = 0,
+        .period = 0xFFFFFFFFUL,
+    };
+    const timer_ic_config_t ic_cfg = {
+        .polarity = TIMER_IC_POLARITY_BOTH,
+        .filter = filter,
+    };
+
+    s_running = true;
+    s_channel_mask = channel_mask;
+    s_timer = timer_init(CAPTURE_TIMER_NUM, &tim_cfg);
+    int status = (s_timer == NULL) ? -2 : 0;
+
+    uint32_t* rings = (uint32_t*)capture_arena_get_segment(0);
+    for (uint8_t i = 0; i < TIMER_CAPTURE_CHANNELS && status == 0; ++i) {
+        if (channel_mask & (1U << i)) {
+            status = start_channel(i, &rings[i * ring_words], &ic_cfg);
+        }
+    }
+    if (status != 0) {
+        timer_capture_stop();
+        return status;
+    }
+
+    // Pair a timer count with a timestamp, and take each line's starting level
+    taskENTER_CRITICAL();
+    timer_start(s_timer);
+    uint32_t now = capture_timebase_now();
+    s_time_offset = now - timer_get_counter(s_timer) * TICKS_PER_COUNT;
+    for (uint8_t i = 0; i < TIMER_CAPTURE_CHANNELS; ++i) {
+        capture_channel_t* ch = &s_channels[i];
+        if (channel_mask & (1U << i)) {
+            ch->sync_pending = true;
+            ch->sync_time = now;
+            ch->sync_level = gpio_read(ch->pin) ? 1U : 0U;
+        }
+    }
+    taskEXIT_CRITICAL();
+    return 0;
+}
+
+void timer_capture_stop(void) {
+    if (!s_running) {
+        return;
+    }
+
+    timer_stop(s_timer);
+    for (uint8_t i = 0; i < TIMER_CAPTURE_CHANNELS; ++i) {
+        if (s_channel_mask & (1U << i)) {
+            stop_channel(i);
+        }
+    }
+    timer_deinit(&s_timer);
+
+    s_channel_mask = 0;
+    s_ring_words = 0;
+    s_running = false;
+}
+
+bool timer_capture_poll(char* json_buffer, size_t json_buffer_size) {
+    if (!s_running) {
+        return false;
+    }
+
+    while (!edge_stream_poll(json_buffer, json_buffer_size)) {
+        if (!merge_pending()) {
+            // Every edge before the guard horizon has been merged
+            return edge_stream_flush(s_horizon, json_buffer, json_buffer_size);
+        }
+    }
+    return true;
+}
+
+uint32_t timer_capture_get_ring_words(void) {
+    return s_ring_words;
+}
@@ -0,0 +1,325 @@
+/**
+ * @file      timing_check.c
+ * @brief     Glitch and timing-violation detector over the edge stream.
+ */
+
+#include <stdio.h>
+
+#include "timing_check.h"
+#include "capture_timebase.h"
+#include "json_text.h"
+
+#define IDLE_REPORT_MS          10U     // An open window is reported after this long without edges
+
+typedef struct {
+    const char* type;
+    uint32_t time;
+    uint8_t channel;
+    uint32_t ticks;
+    uint32_t limit;
+} timing_flag_t;
+
+// --- Static Data ---
+static timing_check_config_t s_config = { .bus = TIMING_BUS_NONE, .clock_channel = 0, .data_channel = 1 };
+static uint32_t s_min_pulse_ticks = 0;
+static uint32_t s_setup_ticks = 0;
+static uint32_t s_hold_ticks = 0;
+static uint32_t s_skew_ticks = 0;
+static uint32_t s_skew_window_ticks = 0;
+
+// Per-channel tracking
+static bool s_started[TIMING_CHECK_MAX_CHANNELS];
+static bool s_has_edge[TIMING_CHECK_MAX_CHANNELS];
+static uint8_t s_levels[TIMING_CHECK_MAX_CHANNELS];
+static uint32_t s_last_edge[TIMING_CHECK_MAX_CHANNELS];
+
+// Setup and hold references
+static bool s_has_data_edge = false;
+static uint32_t s_data_edge = 0;
+static bool s_has_hold_ref = false;
+static uint32_t s_hold_ref = 0;
+
+// Transition of the skew channels in progress
+static bool s_group_open = false;
+static bool s_group_flagged = false;
+static uint8_t s_group_channels = 0;
+static uint32_t s_group_first = 0;
+static uint32_t s_group_last = 0;
+
+// Recent edges, kept as the context before a flag
+static edge_t s_history[TIMING_CHECK_CONTEXT_EDGES];
+static uint32_t s_history_count = 0;
+
+// Window being collected
+static bool s_window_open = false;
+static edge_t s_window_edges[TIMING_CHECK_MAX_WINDOW_EDGES];
+static uint8_t s_window_edge_count = 0;
+static uint8_t s_edges_after = 0;       // Edges since the window's last flag
+static timing_flag_t s_flags[TIMING_CHECK_MAX_FLAGS];
+static uint8_t s_flag_count = 0;
+static uint32_t s_more_flags = 0;
+static bool s_flagged = false;          // A flag was raised by the edge in progress
+
+// --- Private Helper Functions ---
+
+static uint32_t ns_to_ticks(uint32_t ns) {
+    return (uint32_t)((uint64_t)ns * CAPTURE_TIMEBASE_HZ / 1000000000ULL);
+}
+
+static void raise_flag(const char* type, const edge_t* edge, uint32_t ticks, uint32_t limit) {
+    s_flagged = true;
+    if (s_flag_count >= TIMING_CHECK_MAX_FLAGS) {
+        s_more_flags++;
+        return;
+    }
+
+    timing_flag_t* flag = &s_flags[s_flag_count++];
+    flag->type = type;
+    flag->time = edge->time;
+    flag->channel = edge->channel;
+    flag->ticks = ticks;
+    flag->limit = limit;
+}
+
+static void check_pulse(const edge_t* edge) {
+    uint8_t channel = edge->channel;
+
+    if (s_min_pulse_ticks && s_has_edge[channel]) {
+        uint32_t width = edge->time - s_last_edge[channel];
+        if (width < s_min_pulse_ticks) {
+            raise_flag("glitch", edge, width, s_min_pulse_ticks);
+        }
+    }
+}
+
+static void check_clocked_bus(const edge_t* edge, uint8_t level) {
+    if (s_config.bus == TIMING_BUS_NONE) {
+        return;
+    }
+
+    if (edge->channel == s_config.data_channel) {
+        // SDA edges with SCL high are START and STOP conditions
+        if (s_config.bus == TIMING_BUS_I2C && s_levels[s_config.clock_channel]) {
+            s_has_data_edge = false;
+            return;
+        }
+        if (s_hold_ticks && s_has_hold_ref && edge->time - s_hold_ref < s_hold_ticks) {
+            raise_flag("hold", edge, edge->time - s_hold_ref, s_hold_ticks);
+        }
+        s_data_edge = edge->time;
+        s_has_data_edge = true;
+        return;
+    }
+
+    if (edge->channel != s_config.clock_channel) {
+        return;
+    }
+    bool sampling = (s_config.bus == TIMING_BUS_SPI && s_config.sample_falling) ? !level : level;
+    if (sampling) {
+        if (s_setup_ticks && s_has_data_edge && edge->time - s_data_edge < s_setup_ticks) {
+            raise_flag("setup", edge, edge->time - s_data_edge, s_setup_ticks);
+        }
+        if (s_config.bus == TIMING_BUS_SPI) {
+            s_hold_ref = edge->time;
+            s_has_hold_ref = true;
+        }
+    } else if (s_config.bus == TIMING_BUS_I2C) {
+        s_hold_ref = edge->time;
+        s_has_hold_ref = true;
+    }
+}
+
+static void check_skew(const edge_t* edge) {
+    uint8_t bit = (uint8_t)(1U << edge->channel);
+    if (!s_skew_ticks || !(s_config.skew_mask & bit)) {
+        return;
+    }
+
+    // An edge joins the transition in progress unless it is too late or its channel already switched
+    if (!s_group_open || edge->time - s_group_last > s_skew_window_ticks || (s_group_channels & bit)) {
+        s_group_open = true;
+        s_group_flagged = false;
+        s_group_channels = bit;
+        s_group_first = edge->time;
+        s_group_last = edge->time;
+        return;
+    }
+
+    s_group_channels |= bit;
+    s_group_last = edge->time;
+    uint32_t spread = edge->time - s_group_first;
+    if (!s_group_flagged && spread > s_skew_ticks) {
+        s_group_flagged = true;
+        raise_flag("skew", edge, spread, s_skew_ticks);
+    }
+}
+
+static void remember_edge(const edge_t* edge) {
+    s_history[s_history_count % TIMING_CHECK_CONTEXT_EDGES] = *edge;
+    s_history_count++;
+}
+
+static void open_window(void) {
+    uint32_t kept = (s_history_count < TIMING_CHECK_CONTEXT_EDGES) ? s_history_count : TIMING_CHECK_CONTEXT_EDGES;
+
+    s_window_open = true;
+    s_window_edge_count = 0;
+    for (uint32_t i = s_history_count - kept; i < s_history_count; ++i) {
+        s_window_edges[s_window_edge_count++] = s_history[i % TIMING_CHECK_CONTEXT_EDGES];
+    }
+}
+
+static void close_window(void) {
+    s_window_open = false;
+    s_flag_count = 0;
+    s_more_flags = 0;
+}
+
+static void report_window(char* json_buffer, size_t json_buffer_size) {
+    char* ptr = json_buffer;
+    size_t remaining = json_buffer_size;
+    char field[96];
+
+    json_text_append(&ptr, &remaining, "{\"timing\":{\"flags\":[");
+    for (uint8_t i = 0; i < s_flag_count; ++i) {
+        const timing_flag_t* flag = &s_flags[i];
+        snprintf(field, sizeof(field), "%s{\"type\":\"%s\",\"t\":%lu,\"ch\":%u,\"ticks\":%lu,\"limit\":%lu}",
+                 (i == 0) ? "" : ",", flag->type, (unsigned long)flag->time, flag->channel,
+                 (unsigned long)flag->ticks, (unsigned long)flag->limit);
+        json_text_append(&ptr, &remaining, field);
+    }
+    snprintf(field, sizeof(field), "],\"more\":%lu,\"edges\":[", (unsigned long)s_more_flags);
+    json_text_append(&ptr, &remaining, field);
+    for (uint8_t i = 0; i < s_window_edge_count; ++i) {
+        const edge_t* edge = &s_window_edges[i];
+        if (edge->flags & EDGE_FLAG_SYNC) {
+            snprintf(field, sizeof(field), "%s[%lu,%u,%u,1]", (i == 0) ? "" : ",",
+                     (unsigned long)edge->time, edge->channel, edge->level);
+        } else {
+            snprintf(field, sizeof(field), "%s[%lu,%u,%u]", (i == 0) ? "" : ",",
+                     (unsigned long)edge->time, edge->channel, edge->level);
+        }
+        json_text_append(&ptr, &remaining, field);
+    }
+    json_text_append(&ptr, &remaining, "]}}");
+}
+
+// --- Decoder Interface ---
+
+static void timing_check_reset(void) {
+    for (uint8_t i = 0; i < TIMING_CHECK_MAX_CHANNELS; ++i) {
+        s_started[i] = false;
+        s_has_edge[i] = false;
+        s_levels[i] = 0;
+    }
+    s_has_data_edge = false;
+    s_has_hold_ref = false;
+    s_group_open = false;
+    s_history_count = 0;
+    close_window();
+}
+
+static bool timing_check_feed(const edge_t* edge, char* json_buffer, size_t json_buffer_size) {
+    if (edge->channel >= TIMING_CHECK_MAX_CHANNELS) {
+        return false;
+    }
+
+    uint8_t channel = edge->channel;
+    uint8_t level = edge->level ? 1U : 0U;
+    s_flagged = false;
+
+    if (edge->flags & EDGE_FLAG_SYNC) {
+        // The first marker gives the starting level; later ones mean edges were lost
+        if (s_started[channel]) {
+            raise_flag("lost", edge, 0, 0);
+        }
+        s_started[channel] = true;
+        s_has_edge[channel] = false;
+        s_levels[channel] = level;
+        if (channel == s_config.clock_channel || channel == s_config.data_channel) {
+            s_has_data_edge = false;
+            s_has_hold_ref = false;
+        }
+        if (s_config.skew_mask & (1U << channel)) {
+            s_group_open = false;
+        }
+    } else {
+        if (s_has_edge[channel] && level == s_levels[channel]) {
+            return false;
+        }
+        s_started[channel] = true;
+        s_levels[channel] = level;
+        check_pulse(edge);
+        check_clocked_bus(edge, level);
+        check_skew(edge);
+        s_last_edge[channel] = edge->time;
+        s_has_edge[channel] = true;
+    }
+
+    remember_edge(edge);
+    if (s_window_open) {
+        s_window_edges[s_window_edge_count++] = *edge;
+    } else if (s_flagged) {
+        open_window();
+    } else {
+        return false;
+    }
+
+    // Each flag restarts the context after it, as far as the window has room
+    if (s_flagged) {
+        s_edges_after = 0;
+    } else {
+        s_edges_after++;
+    }
+    if (s_edges_after < TIMING_CHECK_CONTEXT_EDGES && s_window_edge_count < TIMING_CHECK_MAX_WINDOW_EDGES) {
+        return false;
+    }
+    report_window(json_buffer, json_buffer_size);
+    close_window();
+    return true;
+}
+
+static bool timing_check_flush(uint32_t now, bool final, char* json_buffer, size_t json_buffer_size) {
+    if (!s_window_open) {
+        return false;
+    }
+
+    // The context after the last flag may never come on a line that went quiet
+    uint32_t last = s_window_edges[s_window_edge_count - 1U].time;
+    if (!final && now - last < (CAPTURE_TIMEBASE_HZ / 1000U) * IDLE_REPORT_MS) {
+        return false;
+    }
+    report_window(json_buffer, json_buffer_size);
+    close_window();
+    return true;
+}
+
+const edge_decoder_t timing_check_decoder = {
+    .name = "timing",
+    .reset = timing_check_reset,
+    .feed = timing_check_feed,
+    .flush = timing_check_flush,
+};
+
+// --- Public API Function Implementations ---
+
+int timing_check_configure(const timing_check_config_t* config) {
+    // Invalid arguments
+    if (config == NULL || config->bus > TIMING_BUS_I2C ||
+        (config->bus != TIMING_BUS_NONE &&
+         (config->clock_channel >= TIMING_CHECK_MAX_CHANNELS || config->data_channel >= TIMING_CHECK_MAX_CHANNELS ||
+          config->clock_channel == config->data_channel)) ||
+        (config->skew_mask >> TIMING_CHECK_MAX_CHANNELS) != 0 ||
+        (config->skew_ns != 0 && config->skew_window_ns <= config->skew_ns)) {
+        return -1;
+    }
+
+    s_config = *config;
+    s_min_pulse_ticks = ns_to_ticks(config->min_pulse_ns);
+    s_setup_ticks = ns_to_ticks(config->setup_ns);
+    s_hold_ticks = ns_to_ticks(config->hold_ns);
+    s_skew_ticks = ns_to_ticks(config->skew_ns);
+    s_skew_window_ticks = ns_to_ticks(config->skew_window_ns);
+    timing_check_reset();
+    return 0;
+}
@@ -0,0 +1,383 @@
+/**
+ * @file      uart_sniffer.c
+ * @brief     Multi-Mbaud UART capture using spare USART receivers and circular DMA.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "uart_sniffer.h"
+#include "capture_arena.h"
+#include "capture_timebase.h"
+#include "dma_ring.h"
+#include "json_text.h"
+#include "nvic.h"
+#include "dma.h"
+#include "gpio.h"
+
+#define GPIO_PORT_A             0
+#define GPIO_PORT_C             2
+
+#define UART_RX_ERRORS          (UART_RX_EVENT_PARITY_ERROR | UART_RX_EVENT_FRAMING_ERROR | \
+                                 UART_RX_EVENT_NOISE | UART_RX_EVENT_OVERRUN)
+
+/** @brief Fixed hardware resources of one sniffer channel. */
+typedef struct {
+    uint8_t uart_num;
+    uint8_t uart_irqn;
+    uint8_t gpio_port;
+    uint8_t gpio_pin;
+    uint8_t gpio_af;
+    uint8_t dma_num;
+    uint8_t stream_num;
+    uint8_t channel;
+    uint8_t dma_irqn;
+} channel_hw_t;
+
+// USART6_RX on DMA2 Stream2 Ch5, USART2_RX on DMA1 Stream5 Ch4
+static const channel_hw_t s_channel_hw[UART_SNIFFER_CHANNELS] = {
+    { .uart_num = 6, .uart_irqn = 71, .gpio_port = GPIO_PORT_C, .gpio_pin = 7, .gpio_af = 8,
+      .dma_num = 2, .stream_num = 2, .channel = 5, .dma_irqn = 58 },
+    { .uart_num = 2, .uart_irqn = 38, .gpio_port = GPIO_PORT_A, .gpio_pin = 3, .gpio_af = 7,
+      .dma_num = 1, .stream_num = 5, .channel = 4, .dma_irqn = 16 },
+};
+
+typedef struct {
+    uart_handle_t uart;
+    gpio_handle_t rx_pin;
+    dma_ring_t ring;
+    uint32_t chunk_start;   // Position of the first byte not yet reported
+} channel_t;
+
+typedef enum {
+    RX_EVENT_CHUNK = 0,     // Bytes up to `position` are complete
+    RX_EVENT_ERROR,         // The byte before `position` was received with errors
+} rx_event_kind_t;
+
+typedef struct {
+    uint32_t timestamp;
+    uint32_t position;
+    uint8_t channel;
+    uint8_t kind;           // rx_event_kind_t
+    uint8_t flags;          // uart_rx_event_t bits
+} rx_event_t;
+
+// --- Static Data ---
+static channel_t s_channels[UART_SNIFFER_CHANNELS];
+static uint32_t s_ring_bytes = 0;
+static uint32_t s_baud_rate = 0;
+static uint32_t s_frame_bits = 0;
+static bool s_running = false;
+
+static rx_event_t s_events[UART_SNIFFER_EVENT_QUEUE_LENGTH];
+static volatile uint8_t s_event_head = 0;   // Written by the ISRs (all at one priority)
+static volatile uint8_t s_event_tail = 0;   // Written by the poller
+static volatile uint32_t s_events_dropped = 0;
+
+// --- Private Helper Functions ---
+
+static void push_event(uint8_t channel, rx_event_kind_t kind, uint8_t flags) {
+    uint32_t timestamp = capture_timebase_now();
+
+    uint8_t next = (s_event_head + 1) % UART_SNIFFER_EVENT_QUEUE_LENGTH;
+    if (next == s_event_tail) {
+        s_events_dropped++;
+        return;
+    }
+
+    rx_event_t* event = &s_events[s_event_head];
+    event->timestamp = timestamp;
+    event->position = dma_ring_position(&s_channels[channel].ring);
+    event->channel = channel;
+    event->kind = (uint8_t)kind;
+    event->flags = flags;
+    s_event_head = next;
+}
+
+static void uart_isr(uint8_t channel) {
+    uint32_t events = uart_get_and_clear_rx_events(s_channels[channel].uart);
+
+    if (events & UART_RX_ERRORS) {
+        push_event(channel, RX_EVENT_ERROR, (uint8_t)(events & UART_RX_ERRORS));
+    }
+    if (events & UART_RX_EVENT_IDLE) {
+        push_event(channel, RX_EVENT_CHUNK, UART_RX_EVENT_IDLE);
+    }
+}
+
+/**
+ * @brief Closes a chunk at each half of the ring so no chunk outgrows it.
+ */
+static void ring_callback(dma_handle_t dma, void* user_data) {
+    (void)dma;
+    uint8_t channel = (uint8_t)(uintptr_t)user_data;
+    dma_ring_t* ring = &s_channels[channel].ring;
+
+    if (dma_is_interrupt_flag_set(ring->dma, DMA_INTERRUPT_HALF_TRANSFER)) {
+        dma_clear_interrupt_flag(ring->dma, DMA_INTERRUPT_HALF_TRANSFER);
+        push_event(channel, RX_EVENT_CHUNK, 0);
+    }
+    if (dma_ring_handle_wrap(ring)) {
+        push_event(channel, RX_EVENT_CHUNK, 0);
+    }
+}
+
+/**
+ * @brief Converts a byte count into capture timebase ticks at the line rate.
+ */
+static uint32_t bytes_to_ticks(uint32_t bytes) {
+    return (uint32_t)(((uint64_t)bytes * s_frame_bits * CAPTURE_TIMEBASE_HZ) / s_baud_rate);
+}
+
+static void append_dropped(char** buf, size_t* remaining) {
+    if (s_events_dropped > 0) {
+        char field[32];
+        taskENTER_CRITICAL();
+        uint32_t dropped = s_events_dropped;
+        s_events_dropped = 0;
+        taskEXIT_CRITICAL();
+        snprintf(field, sizeof(field), ",\"dropped_events\":%lu", (unsigned long)dropped);
+        json_text_append(buf, remaining, field);
+    }
+}
+
+/**
+ * @brief Formats up to UART_SNIFFER_MAX_RECORD_BYTES of a chunk.
+ * @return true once the whole chunk up to the event has been reported.
+ */
+static bool format_chunk(const rx_event_t* event, char* json_buffer, size_t json_buffer_size) {
+    channel_t* ch = &s_channels[event->channel];
+    char* ptr = json_buffer;
+    size_t remaining = json_buffer_size;
+    char field[128];
+
+    uint32_t pending = event->position - ch->chunk_start;
+    uint32_t len = (pending > UART_SNIFFER_MAX_RECORD_BYTES) ? UART_SNIFFER_MAX_RECORD_BYTES : pending;
+
+    // The event fired after the last byte (plus one idle frame for an idle
+    // event); place this record's bytes back from there at the line rate
+    uint32_t frames_after_end = (pending - len) + ((event->flags & UART_RX_EVENT_IDLE) ? 1U : 0U);
+    uint32_t t_end = event->timestamp - bytes_to_ticks(frames_after_end);
+    uint32_t t_start = t_end - bytes_to_ticks(len);
+
+    snprintf(field, sizeof(field), "{\"uart_sniff\":{\"ch\":%u,\"pos\":%lu,\"t_start\":%lu,\"t_end\":%lu,\"len\":%lu",
+             event->channel, (unsigned long)ch->chunk_start, (unsigned long)t_start,
+             (unsigned long)t_end, (unsigned long)len);
+    json_text_append(&ptr, &remaining, field);
+
+    char* data_start = ptr;
+    size_t data_remaining = remaining;
+    json_text_append(&ptr, &remaining, ",\"data\":\"");
+    dma_ring_append_hex(&ch->ring, ch->chunk_start, len, &ptr, &remaining);
+    json_text_append(&ptr, &remaining, "\"");
+
+    if (dma_ring_is_overwritten(&ch->ring, ch->chunk_start)) {
+        ptr = data_start;
+        remaining = data_remaining;
+        json_text_append(&ptr, &remaining, ",\"overrun\":true");
+    }
+
+    append_dropped(&ptr, &remaining);
+    json_text_append(&ptr, &remaining, "}}");
+
+    ch->chunk_start += len;
+    return len == pending;
+}
+
+static void format_error(const rx_event_t* event, char* json_buffer, size_t json_buffer_size) {
+    channel_t* ch = &s_channels[event->channel];
+    char* ptr = json_buffer;
+    size_t remaining = json_buffer_size;
+    char field[96];
+
+    // The DMA has already moved the offending byte when the error interrupt runs
+    uint32_t position = event->position - 1U;
+    bool is_break = (event->flags & UART_RX_EVENT_FRAMING_ERROR) &&
+                    !dma_ring_is_overwritten(&ch->ring, position) &&
+                    dma_ring_byte_at(&ch->ring, position) == 0x00;
+
+    snprintf(field, sizeof(field), "{\"uart_sniff\":{\"ch\":%u,\"pos\":%lu,\"t\":%lu,\"errors\":[",
+             event->channel, (unsigned long)position, (unsigned long)event->timestamp);
+    json_text_append(&ptr, &remaining, field);
+
+    const char* separator = "";
+    static const struct { uint8_t flag; const char* name; } names[] = {
+        { UART_RX_EVENT_PARITY_ERROR,  "parity" },
+        { UART_RX_EVENT_FRAMING_ERROR, "framing" },
+        { UART_RX_EVENT_NOISE,         "noise" },
+        { UART_RX_EVENT_OVERRUN,       "overrun" },
+    };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+        if (event->flags & names[i].flag) {
+            const char* name = (names[i].flag == UART_RX_EVENT_FRAMING_ERROR && is_break) ? "break" : names[i].name;
+            snprintf(field, sizeof(field), "%s\"%s\"", separator, name);
+            json_text_append(&ptr, &remaining, field);
+            separator = ",";
+        }
+    }
+    json_text_append(&ptr, &remaining, "]");
+    append_dropped(&ptr, &remaining);
+    json_text_append(&ptr, &remaining, "}}");
+}
+
+static int start_channel(uint8_t index, const uart_config_t* config, uint8_t* buffer) {
+    const channel_hw_t* hw = &s_channel_hw[index];
+    channel_t* ch = &s_channels[index];
+
+    const gpio_config_t pin_cfg = {
+        .mode = GPIO_MODE_ALTERNATE_FUNCTION,
+        .pull = GPIO_PULL_UP,   // Idle-high line; keeps a floating input from framing noise
+        .output_type = GPIO_OUTPUT_TYPE_PUSH_PULL,
+        .speed = GPIO_SPEED_HIGH,
+        .alternate_function = hw->gpio_af,
+    };
+    const dma_config_t dma_cfg = {
+        .channel = hw->channel,
+        .direction = DMA_DIRECTION_PERIPHERAL_TO_MEMORY,
+        .priority = DMA_PRIORITY_VERY_HIGH,
+        .peripheral_data_size = DMA_DATA_SIZE_8_BIT,
+        .memory_data_size = DMA_DATA_SIZE_8_BIT,
+        .peripheral_increment = false,
+        .memory_increment = true,
+        .circular_mode = true,
+        .fifo_mode = false,
+        .fifo_threshold = DMA_FIFO_THRESHOLD_1_4,
+        .memory_burst = DMA_BURST_SINGLE,
+        .peripheral_burst = DMA_BURST_SINGLE,
+    };
+
+    ch->chunk_start = 0;
+    ch->rx_pin = gpio_init(hw->gpio_port, (1 << hw->gpio_pin), &pin_cfg);
+    ch->uart = uart_init(hw->uart_num, config);
+    dma_handle_t dma = dma_init(hw->dma_num, hw->stream_num, &dma_cfg);
+    ch->ring.dma = dma;
+    if (ch->rx_pin == NULL || ch->uart == NULL || dma == NULL) {
+        return -2;
+    }
+
+    dma_set_callback(dma, ring_callback, (void*)(uintptr_t)index);
+    nvic_set_priority(hw->dma_irqn, UART_SNIFFER_IRQ_PRIORITY);
+    nvic_set_priority(hw->uart_irqn, UART_SNIFFER_IRQ_PRIORITY);
+    nvic_enable_irq(hw->dma_irqn);
+    nvic_enable_irq(hw->uart_irqn);
+
+    // Arm the ring before the receiver starts raising requests
+    dma_enable_interrupt(dma, DMA_INTERRUPT_HALF_TRANSFER);
+    dma_ring_start(&ch->ring, dma, uart_get_data_register(ch->uart), buffer, s_ring_bytes);
+    uart_set_rx_dma(ch->uart, true);
+    uart_set_rx_event_interrupts(ch->uart, true);
+    return 0;
+}
+
+static void stop_channel(uint8_t index) {
+    const channel_hw_t* hw = &s_channel_hw[index];
+    channel_t* ch = &s_channels[index];
+
+    nvic_disable_irq(hw->uart_irqn);
+    nvic_disable_irq(hw->dma_irqn);
+    if (ch->uart) {
+        uart_set_rx_event_interrupts(ch->uart, false);
+        uart_set_rx_dma(ch->uart, false);
+    }
+    dma_deinit(&ch->ring.dma);
+    uart_deinit(&ch->uart);
+    gpio_deinit(&ch->rx_pin);
+}
+
+// --- Public API Function Implementations ---
+
+int uart_sniffer_start(const uart_config_t* config) {
+    if (s_running || config == NULL || config->baud_rate == 0 ||
+        capture_arena_get_segment_count() < UART_SNIFFER_CHANNELS) {
+        return -1;
+    }
+
+    uint32_t segment_bytes = capture_arena_get_segment_samples() * sizeof(capture_sample_t);
+    uint32_t ring_bytes = dma_ring_fit_length(segment_bytes, UART_SNIFFER_MAX_RING_BYTES);
+    if (ring_bytes < UART_SNIFFER_MIN_RING_BYTES) {
+        return -1;
+    }
+    s_ring_bytes = ring_bytes;
+
+    // The USART word length includes the parity bit
+    uart_config_t line_cfg = *config;
+    if (line_cfg.parity != UART_PARITY_NONE) {
+        line_cfg.word_length += 1;
+    }
+    s_baud_rate = line_cfg.baud_rate;
+    s_frame_bits = 1U + line_cfg.word_length + ((line_cfg.stop_bits == UART_STOP_BITS_2) ? 2U : 1U);
+
+    s_event_head = 0;
+    s_event_tail = 0;
+    s_events_dropped = 0;
+    capture_timebase_init();
+
+    int status = 0;
+    for (uint8_t i = 0; i < UART_SNIFFER_CHANNELS && status == 0; ++i) {
+        status = start_channel(i, &line_cfg, (uint8_t*)capture_arena_get_segment(i));
+    }
+
+    s_running = true;
+    if (status != 0) {
+        uart_sniffer_stop();
+    }
+    return status;
+}
+
+void uart_sniffer_stop(void) {
+    if (!s_running) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < UART_SNIFFER_CHANNELS; ++i) {
+        stop_channel(i);
+    }
+
+    s_ring_bytes = 0;
+    s_running = false;
+}
+
+bool uart_sniffer_poll(char* json_buffer, size_t json_buffer_size) {
+    if (!s_running) {
+        return false;
+    }
+
+    while (s_event_tail != s_event_head) {
+        const rx_event_t* event = &s_events[s_event_tail];
+        bool consumed = true;
+        bool written = false;
+
+        if (event->kind == RX_EVENT_ERROR) {
+            format_error(event, json_buffer, json_buffer_size);
+            written = true;
+        } else if (event->position != s_channels[event->channel].chunk_start) {
+            // Long chunks stay queued until every part has been reported
+            consumed = format_chunk(event, json_buffer, json_buffer_size);
+            written = true;
+        }
+
+        if (consumed) {
+            s_event_tail = (s_event_tail + 1) % UART_SNIFFER_EVENT_QUEUE_LENGTH;
+        }
+        if (written) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t uart_sniffer_get_ring_bytes(void) {
+    return s_ring_bytes;
+}
+
+// --- ISR Handlers ---
+
+void USART6_IRQHandler(void) {
+    uart_isr(0);
+}
+
+void USART2_IRQHandler(void) {
+    uart_isr(1);
+}
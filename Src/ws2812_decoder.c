@@ -0,0 +1,231 @@
+/**
+ * @file      ws2812_decoder.c
+ * @brief     WS2812 (addressable LED) stream decoder fed from the edge stream.
+ */
+
+#include <stdio.h>
+
+#include "ws2812_decoder.h"
+#include "capture_timebase.h"
+#include "json_text.h"
+
+#define PIXEL_BITS              24U
+#define PIXEL_HEX_DIGITS        6U
+
+// --- Static Data ---
+static ws2812_decoder_config_t s_config = {
+    .channel = 0,
+    .threshold_ns = WS2812_DECODER_DEFAULT_THRESHOLD_NS,
+    .reset_us = WS2812_DECODER_DEFAULT_RESET_US,
+    .diff = false,
+};
+static uint32_t s_threshold_ticks = 0;
+static uint32_t s_reset_ticks = 0;
+
+static uint8_t s_level = 0;
+static uint32_t s_rise_time = 0;
+static uint32_t s_fall_time = 0;
+
+static bool s_in_frame = false;         // False until a latch gives the frame alignment
+static uint32_t s_frame_time = 0;
+static uint32_t s_frame_count = 0;
+static uint32_t s_pixel_value = 0;
+static uint8_t s_pixel_bits = 0;
+static uint32_t s_pixel_count = 0;      // Pixels in the frame, including any not kept
+static uint32_t s_changed = 0;
+
+// Pixels of the frame being received, over those of the previous one
+static uint32_t s_pixels[WS2812_DECODER_MAX_PIXELS];
+static uint32_t s_previous_count = 0;   // Valid pixels of the previous frame
+
+static uint32_t s_run_first = 0;
+static uint32_t s_run_length = 0;
+
+// --- Private Helper Functions ---
+
+/**
+ * @brief Appends the pending run as GGRRBB hex digits and empties it.
+ */
+static void append_run(char** buf, size_t* remaining) {
+    static const char hex_digits[] = "0123456789ABCDEF";
+    char digits[PIXEL_HEX_DIGITS + 1];
+    digits[PIXEL_HEX_DIGITS] = '\0';
+
+    for (uint32_t i = 0; i < s_run_length; ++i) {
+        uint32_t pixel = s_pixels[s_run_first + i];
+        for (uint8_t d = 0; d < PIXEL_HEX_DIGITS; ++d) {
+            digits[d] = hex_digits[(pixel >> (20U - 4U * d)) & 0x0FU];
+        }
+        json_text_append(buf, remaining, digits);
+    }
+    s_run_length = 0;
+}
+
+static bool report_run(char* json_buffer, size_t json_buffer_size) {
+    char* ptr = json_buffer;
+    size_t remaining = json_buffer_size;
+    char field[64];
+
+    snprintf(field, sizeof(field), "{\"ws2812\":{\"frame\":%lu,\"first\":%lu,\"pixels\":\"",
+             (unsigned long)s_frame_count, (unsigned long)s_run_first);
+    json_text_append(&ptr, &remaining, field);
+    append_run(&ptr, &remaining);
+    json_text_append(&ptr, &remaining, "\"}}");
+    return true;
+}
+
+static bool report_frame(char* json_buffer, size_t json_buffer_size) {
+    char* ptr = json_buffer;
+    size_t remaining = json_buffer_size;
+    char field[128];
+
+    snprintf(field, sizeof(field),
+             "{\"ws2812_frame\":{\"t\":%lu,\"frame\":%lu,\"pixels\":%lu,\"changed\":%lu,\"first\":%lu,\"data\":\"",
+             (unsigned long)s_frame_time, (unsigned long)s_frame_count, (unsigned long)s_pixel_count,
+             (unsigned long)s_changed, (unsigned long)s_run_first);
+    json_text_append(&ptr, &remaining, field);
+    append_run(&ptr, &remaining);
+    json_text_append(&ptr, &remaining, "\"}}");
+    return true;
+}
+
+/**
+ * @brief Reports the frame a latch has closed and keeps its pixels for diffing.
+ */
+static bool close_frame(char* json_buffer, size_t json_buffer_size) {
+    s_previous_count = s_pixel_count < WS2812_DECODER_MAX_PIXELS ? s_pixel_count : WS2812_DECODER_MAX_PIXELS;
+    bool written = report_frame(json_buffer, json_buffer_size);
+    s_frame_count++;
+    return written;
+}
+
+static void start_frame(uint32_t time) {
+    s_in_frame = true;
+    s_frame_time = time;
+    s_pixel_value = 0;
+    s_pixel_bits = 0;
+    s_pixel_count = 0;
+    s_changed = 0;
+    s_run_first = 0;
+    s_run_length = 0;
+}
+
+/**
+ * @brief Stores a complete pixel and extends or closes the pending run.
+ * @return true if a run record was written.
+ */
+static bool take_pixel(uint32_t pixel, char* json_buffer, size_t json_buffer_size) {
+    uint32_t index = s_pixel_count++;
+    if (index >= WS2812_DECODER_MAX_PIXELS) {
+        return false;
+    }
+
+    bool changed = !s_config.diff || index >= s_previous_count || s_pixels[index] != pixel;
+    s_pixels[index] = pixel;
+
+    if (!changed) {
+        return s_run_length > 0 && report_run(json_buffer, json_buffer_size);
+    }
+
+    s_changed++;
+    if (s_run_length == 0) {
+        s_run_first = index;
+    }
+    if (++s_run_length == WS2812_DECODER_RUN_PIXELS) {
+        return report_run(json_buffer, json_buffer_size);
+    }
+    return false;
+}
+
+// --- Decoder Interface ---
+
+static void ws2812_reset(void) {
+    s_level = 0;
+    s_in_frame = false;
+    s_frame_count = 0;
+    s_previous_count = 0;
+}
+
+static bool ws2812_feed(const edge_t* edge, char* json_buffer, size_t json_buffer_size) {
+    if (edge->channel != s_config.channel) {
+        return false;
+    }
+
+    uint8_t level = edge->level ? 1U : 0U;
+    if (edge->flags & EDGE_FLAG_SYNC) {
+        // Bits were lost: drop the frame and realign on the next latch
+        s_in_frame = false;
+        s_level = level;
+        s_rise_time = edge->time;
+        s_fall_time = edge->time;
+        return false;
+    }
+    if (level == s_level) {
+        return false;
+    }
+    s_level = level;
+
+    if (level) {
+        // A long enough low time latched the frame before this bit
+        bool written = false;
+        if (edge->time - s_fall_time >= s_reset_ticks) {
+            if (s_in_frame && s_pixel_count > 0) {
+                written = close_frame(json_buffer, json_buffer_size);
+            }
+            start_frame(edge->time);
+        }
+        s_rise_time = edge->time;
+        return written;
+    }
+
+    s_fall_time = edge->time;
+    if (!s_in_frame) {
+        return false;
+    }
+
+    uint8_t bit = (edge->time - s_rise_time >= s_threshold_ticks) ? 1U : 0U;
+    s_pixel_value = (s_pixel_value << 1) | bit;
+    if (++s_pixel_bits < PIXEL_BITS) {
+        return false;
+    }
+    uint32_t pixel = s_pixel_value & 0xFFFFFFUL;
+    s_pixel_value = 0;
+    s_pixel_bits = 0;
+    return take_pixel(pixel, json_buffer, json_buffer_size);
+}
+
+static bool ws2812_flush(uint32_t now, bool final, char* json_buffer, size_t json_buffer_size) {
+    if (!s_in_frame || s_pixel_count == 0) {
+        return false;
+    }
+
+    // The line has been low for the latch time: the frame is shown, no need to wait for the next one
+    if (!final && (s_level || now - s_fall_time < s_reset_ticks)) {
+        return false;
+    }
+    s_in_frame = false;
+    return close_frame(json_buffer, json_buffer_size);
+}
+
+const edge_decoder_t ws2812_decoder = {
+    .name = "ws2812",
+    .reset = ws2812_reset,
+    .feed = ws2812_feed,
+    .flush = ws2812_flush,
+};
+
+// --- Public API Function Implementations ---
+
+int ws2812_decoder_configure(const ws2812_decoder_config_t* config) {
+    // Invalid arguments
+    if (config == NULL || config->threshold_ns == 0 || config->reset_us == 0 ||
+        config->threshold_ns >= config->reset_us * 1000U) {
+        return -1;
+    }
+
+    s_config = *config;
+    s_threshold_ticks = (uint32_t)((uint64_t)CAPTURE_TIMEBASE_HZ * config->threshold_ns / 1000000000ULL);
+    s_reset_ticks = (uint32_t)((uint64_t)CAPTURE_TIMEBASE_HZ * config->reset_us / 1000000ULL);
+    ws2812_reset();
+    return 0;
+}